@@ -115,6 +115,42 @@ gbtAnalysisProfileList<T>::AddOutput(const wxString &p_output)
   catch (gbtNotNashException &) { }
 }
 
+template <class T> void
+gbtAnalysisProfileList<T>::AddProfile(const MixedStrategyProfile<T> &p_profile)
+{
+  MixedStrategyProfile<T> profile(m_doc->GetGame()->NewMixedStrategyProfile((T) 0.0));
+  for (int i = 1; i <= profile.MixedProfileLength(); i++) {
+    profile[i] = p_profile[i];
+  }
+
+  if (m_isBehav) {
+    MixedBehaviorProfile<T> behav(profile);
+    m_behavProfiles.Append(behav);
+    m_mixedProfiles.Append(profile);
+    m_current = m_behavProfiles.Length();
+  }
+  else {
+    m_mixedProfiles.Append(profile);
+    if (m_doc->IsTree()) {
+      m_behavProfiles.Append(MixedBehaviorProfile<T>(profile));
+    }
+    m_current = m_mixedProfiles.Length();
+  }
+}
+
+template <class T> void
+gbtAnalysisProfileList<T>::AddProfile(const MixedBehaviorProfile<T> &p_profile)
+{
+  MixedBehaviorProfile<T> profile(m_doc->GetGame());
+  for (int i = 1; i <= profile.Length(); i++) {
+    profile[i] = p_profile[i];
+  }
+
+  m_behavProfiles.Append(profile);
+  m_mixedProfiles.Append(profile.ToMixedProfile());
+  m_current = m_behavProfiles.Length();
+}
+
 template <class T>
 void gbtAnalysisProfileList<T>::BuildNfg(void)
 {
@@ -35,17 +35,30 @@ class gbtGameDocument;
 
 class TiXmlNode;
 
+//
+// Methods which the GUI can run itself on a worker thread (see
+// solverthread.h); anything else is run as the command-line tool
+// given by the output's command.
+//
+typedef enum {
+  GBT_SOLVER_EXTERNAL = 0,
+  GBT_SOLVER_ENUMPURE = 1,
+  GBT_SOLVER_LP = 2,
+  GBT_SOLVER_LCP = 3
+} gbtSolverMethod;
 
 class gbtAnalysisOutput {
 protected:
   gbtGameDocument *m_doc;
   wxString m_label, m_description, m_command;
+  gbtSolverMethod m_method;
 
 public:
   /// @name Lifecycle
   //@{
   /// Construct a new output group
-  gbtAnalysisOutput(gbtGameDocument *p_doc) : m_doc(p_doc) { }
+  gbtAnalysisOutput(gbtGameDocument *p_doc)
+    : m_doc(p_doc), m_method(GBT_SOLVER_EXTERNAL) { }
   /// Clean up an output group
   virtual ~gbtAnalysisOutput() { }
   //@}
@@ -70,6 +83,12 @@ public:
   /// Set the command used to generate the list
   void SetCommand(const wxString &p_command) { m_command = p_command; }
 
+  /// Get the method used to generate the list, if it is run in-process
+  gbtSolverMethod GetMethod(void) const { return m_method; }
+
+  /// Set the method used to generate the list, if it is run in-process
+  void SetMethod(gbtSolverMethod p_method) { m_method = p_method; }
+
   /// The number of profiles in the list
   virtual int NumProfiles(void) const = 0;
 
@@ -184,6 +203,10 @@ public:
   //!
   //@{
   void AddOutput(const wxString &);
+  /// Add a copy of a profile computed on another copy of the game
+  void AddProfile(const Gambit::MixedStrategyProfile<T> &);
+  /// Add a copy of a profile computed on another copy of the game
+  void AddProfile(const Gambit::MixedBehaviorProfile<T> &);
   /// Map all behavior profiles to corresponding mixed profiles
   void BuildNfg(void);
 
@@ -208,6 +208,7 @@ gbtAnalysisOutput *gbtNashChoiceDialog::GetCommand(void) const
       if (m_doc->NumPlayers() == 2 && m_doc->IsConstSum()) {
 	cmd = new gbtAnalysisProfileList<Rational>(m_doc, useEfg);
 	cmd->SetCommand(prefix + wxT("lp") + options);
+	cmd->SetMethod(GBT_SOLVER_LP);
 	cmd->SetDescription(wxT("One equilibrium by solving a linear program ")
 			    + game);
       }
@@ -221,6 +222,7 @@ gbtAnalysisOutput *gbtNashChoiceDialog::GetCommand(void) const
       if (m_doc->NumPlayers() == 2) {
 	cmd = new gbtAnalysisProfileList<Rational>(m_doc, useEfg);
 	cmd->SetCommand(prefix + wxT("lcp") + options);
+	cmd->SetMethod(GBT_SOLVER_LCP);
 	cmd->SetDescription(wxT("Some equilibria by solving a linear ")
 			       wxT("complementarity program ") + game);
       }
@@ -249,6 +251,7 @@ gbtAnalysisOutput *gbtNashChoiceDialog::GetCommand(void) const
   else if (method == s_enumpure) {
     cmd = new gbtAnalysisProfileList<Rational>(m_doc, useEfg);
     cmd->SetCommand(prefix + wxT("enumpure") + options);
+    cmd->SetMethod(GBT_SOLVER_ENUMPURE);
     cmd->SetDescription(count + wxT(" in pure strategies ") + game);
   }
   else if (method == s_enummixed) {
@@ -279,11 +282,13 @@ gbtAnalysisOutput *gbtNashChoiceDialog::GetCommand(void) const
   else if (method == s_lp) {
     cmd = new gbtAnalysisProfileList<Rational>(m_doc, useEfg);
     cmd->SetCommand(prefix + wxT("lp") + options);
+    cmd->SetMethod(GBT_SOLVER_LP);
     cmd->SetDescription(count + wxT(" by solving a linear program ") + game);
   }
   else if (method == s_lcp) {
     cmd = new gbtAnalysisProfileList<Rational>(m_doc, useEfg);
     cmd->SetCommand(prefix + wxT("lcp") + options);
+    cmd->SetMethod(GBT_SOLVER_LCP);
     cmd->SetDescription(count + wxT(" by solving a linear complementarity ")
 				   wxT("program ") + game);
   }
@@ -28,6 +28,7 @@
 
 #include "dlnashmon.h"
 #include "gamedoc.h"
+#include "solverthread.h"
 
 #include "efgprofile.h"
 #include "nfgprofile.h"
@@ -39,6 +40,8 @@ BEGIN_EVENT_TABLE(gbtNashMonitorDialog, wxDialog)
   EVT_END_PROCESS(GBT_ID_PROCESS, gbtNashMonitorDialog::OnEndProcess)
   EVT_IDLE(gbtNashMonitorDialog::OnIdle)
   EVT_TIMER(GBT_ID_TIMER, gbtNashMonitorDialog::OnTimer)
+  EVT_COMMAND(wxID_ANY, GBT_EVT_SOLVER_PROGRESS,
+	      gbtNashMonitorDialog::OnProgress)
 END_EVENT_TABLE()
 
 #include "bitmaps/stop.xpm"
@@ -49,7 +52,7 @@ gbtNashMonitorDialog::gbtNashMonitorDialog(wxWindow *p_parent,
   : wxDialog(p_parent, -1, wxT("Computing Nash equilibria"),
 	     wxDefaultPosition),
     m_doc(p_doc), 
-    m_process(0), m_timer(this, GBT_ID_TIMER),
+    m_process(0), m_runner(0), m_timer(this, GBT_ID_TIMER),
     m_output(p_command)
 {
   wxBoxSizer *sizer = new wxBoxSizer(wxVERTICAL);
@@ -75,6 +78,10 @@ gbtNashMonitorDialog::gbtNashMonitorDialog(wxWindow *p_parent,
 
   sizer->Add(startSizer, 0, wxALL | wxALIGN_CENTER, 5);
 
+  // Only computations run on a worker thread report their progress
+  m_progressText = new wxStaticText(this, wxID_STATIC, wxT(""));
+  sizer->Add(m_progressText, 0, wxLEFT | wxRIGHT | wxALIGN_CENTER, 5);
+
   if (p_command->IsBehavior()) {
     m_profileList = new gbtBehavProfileList(this, m_doc);
   }
@@ -97,6 +104,12 @@ gbtNashMonitorDialog::gbtNashMonitorDialog(wxWindow *p_parent,
   Start(p_command);
 }
 
+gbtNashMonitorDialog::~gbtNashMonitorDialog()
+{
+  // This waits for a worker which has not finished yet to stop
+  delete m_runner;
+}
+
 void gbtNashMonitorDialog::Start(gbtAnalysisOutput *p_command)
 {
   if (!p_command->IsBehavior()) {
@@ -106,6 +119,20 @@ void gbtNashMonitorDialog::Start(gbtAnalysisOutput *p_command)
 
   m_doc->AddProfileList(p_command);
 
+  // Methods the GUI can run itself are run on a worker thread; profiles
+  // are picked up from it on the timer.  If the thread cannot be
+  // started, fall back on running the tool.
+  m_runner = gbtSolverRunner::Create(m_doc, p_command, this);
+  if (m_runner) {
+    if (m_runner->Start()) {
+      m_stopButton->Enable(true);
+      m_timer.Start(100, false);
+      return;
+    }
+    delete m_runner;
+    m_runner = 0;
+  }
+
   m_process = new wxProcess(this, GBT_ID_PROCESS);
   m_process->Redirect();
 
@@ -167,7 +194,33 @@ void gbtNashMonitorDialog::OnIdle(wxIdleEvent &p_event)
 
 void gbtNashMonitorDialog::OnTimer(wxTimerEvent &p_event)
 {
-  wxWakeUpIdle();
+  if (!m_runner) {
+    wxWakeUpIdle();
+    return;
+  }
+
+  // Check for the end before collecting, so that nothing the worker
+  // queues just before finishing is missed
+  bool finished = m_runner->IsFinished();
+  m_doc->DoCollectOutput(*m_runner);
+  m_countText->SetLabel(wxString::Format(wxT("Number of equilibria found so far: %d"), m_output->NumProfiles()));
+
+  if (finished) {
+    m_stopButton->Enable(false);
+    m_timer.Stop();
+    if (m_runner->GetError() != wxT("")) {
+      wxMessageBox(m_runner->GetError(), wxT("Computing Nash equilibria"),
+		   wxOK | wxICON_ERROR, this);
+    }
+    Finish(m_runner->GetError() == wxT(""));
+  }
+}
+
+void gbtNashMonitorDialog::OnProgress(wxCommandEvent &p_event)
+{
+  m_progressText->SetLabel(wxString::Format(wxT("Steps taken so far: %ld"),
+					    p_event.GetExtraLong()));
+  Layout();
 }
 
 void gbtNashMonitorDialog::OnEndProcess(wxProcessEvent &p_event)
@@ -187,7 +240,12 @@ void gbtNashMonitorDialog::OnEndProcess(wxProcessEvent &p_event)
     }
   }
 
-  if (p_event.GetExitCode() == 0) {
+  Finish(p_event.GetExitCode() == 0);
+}
+
+void gbtNashMonitorDialog::Finish(bool p_success)
+{
+  if (p_success) {
     m_statusText->SetLabel(wxT("The computation has completed."));
     m_statusText->SetForegroundColour(wxColour(0, 192, 0));
   }
@@ -201,11 +259,17 @@ void gbtNashMonitorDialog::OnEndProcess(wxProcessEvent &p_event)
 
 void gbtNashMonitorDialog::OnStop(wxCommandEvent &p_event)
 {
+  m_stopButton->Enable(false);
+
+  if (m_runner) {
+    // The end of the computation is picked up on the timer
+    m_runner->Cancel();
+    return;
+  }
+
   // Per the wxWidgets wiki, under Windows, programs that run
   // without a console window don't respond to the more polite
   // SIGTERM, so instead we must be rude and SIGKILL it.
-  m_stopButton->Enable(false);
-
 #ifdef __WXMSW__
   wxProcess::Kill(m_pid, wxSIGKILL);
 #else
@@ -32,22 +32,26 @@ private:
   gbtGameDocument *m_doc;
   int m_pid;
   wxProcess *m_process;
+  gbtSolverRunner *m_runner;
   wxWindow *m_profileList;
-  wxStaticText *m_statusText, *m_countText;
+  wxStaticText *m_statusText, *m_countText, *m_progressText;
   wxButton *m_stopButton, *m_okButton;
   wxTimer m_timer;
   gbtAnalysisOutput *m_output;
   
   void Start(gbtAnalysisOutput *);
+  void Finish(bool p_success);
 
   void OnStop(wxCommandEvent &);
   void OnTimer(wxTimerEvent &);
+  void OnProgress(wxCommandEvent &);
   void OnIdle(wxIdleEvent &);
   void OnEndProcess(wxProcessEvent &);
 
 public:
   gbtNashMonitorDialog(wxWindow *p_parent, gbtGameDocument *p_doc,
 		       gbtAnalysisOutput *p_command);
+  virtual ~gbtNashMonitorDialog();
 
   DECLARE_EVENT_TABLE()
 };
@@ -21,6 +21,8 @@
 //
 
 #include <fstream>
+#include <vector>
+#include <algorithm>
 
 #include <wx/wxprec.h>
 #ifndef WX_PRECOMP
@@ -56,6 +58,8 @@ private:
   gbtGameDocument *m_doc;
   List<double> m_lambdas;
   List<MixedStrategyProfile<double> > m_profiles;
+  /// The probabilities of the points, by strategy, for plotting
+  std::vector<std::vector<double> > m_curves;
 
 public:
   LogitMixedBranch(gbtGameDocument *p_doc) : m_doc(p_doc) { }
@@ -69,6 +73,10 @@ public:
   { return m_profiles[p_index]; }
   const List<MixedStrategyProfile<double> > &GetProfiles(void) const 
   { return m_profiles; }
+  /// The probability of strategy p_st (in the numbering of mixed
+  /// profiles) at each point, counting from zero
+  const std::vector<double> &GetCurve(int p_st) const
+  { return m_curves[p_st-1]; }
 };
   
 void LogitMixedBranch::AddProfile(const wxString &p_text)
@@ -84,6 +92,11 @@ void LogitMixedBranch::AddProfile(const wxString &p_text)
   }
 
   m_profiles.Append(profile);
+
+  m_curves.resize(profile.MixedProfileLength());
+  for (int i = 1; i <= profile.MixedProfileLength(); i++) {
+    m_curves[i-1].push_back(profile[i]);
+  }
 }
 
 //========================================================================
@@ -294,6 +307,8 @@ gbtLogitPlotCtrl::gbtLogitPlotCtrl(wxWindow *p_parent,
   SetAxisColour(*wxBLUE);
   SetAxisFont(labelFont);
   SetDrawSymbols(false);
+  // Curves are replaced as points arrive; the panel decides when to fit
+  SetFitPlotOnNewCurve(false);
 
   // SetAxisFont resets the width of the y axis labels, assuming
   // a fairly long label.
@@ -338,6 +353,107 @@ void gbtLogitPlotCtrl::CalcXAxisTickPositions(void)
 }
 
 
+//========================================================================
+//                     class LogitCurveDecimator
+//========================================================================
+
+//
+// Reduces a curve to the points which matter at screen resolution.
+// Each run of consecutive points in the same pixel column is replaced
+// by its first and last points, and those with the least and greatest
+// value of each coordinate, in their original order.  This draws the
+// same pixels as the whole run, and keeps the bounding rectangle of
+// the curve.  Points left and right of the view are treated as lying
+// in one column on either side of it.
+//
+// Points are appended one at a time, so a curve which grows as a
+// computation runs does not need to be reduced again from the start.
+//
+class LogitCurveDecimator {
+private:
+  struct Point {
+    long m_index;
+    double m_x, m_y;
+  };
+
+  double m_left, m_binWidth;
+  int m_numBins;
+  long m_count;
+  /// The points kept from completed runs
+  std::vector<double> m_x, m_y;
+  /// The column of the current run, and its points of interest
+  int m_bin;
+  Point m_first, m_last, m_minX, m_maxX, m_minY, m_maxY;
+
+  int GetBin(double p_x) const;
+  void FlushRun(std::vector<double> &p_x, std::vector<double> &p_y) const;
+  static bool IsEarlier(const Point &p_a, const Point &p_b)
+  { return p_a.m_index < p_b.m_index; }
+
+public:
+  LogitCurveDecimator(double p_left, double p_width, int p_numBins);
+
+  void Append(double p_x, double p_y);
+  /// Returns a new curve of the points kept so far
+  wxPlotData *NewCurve(void) const;
+};
+
+LogitCurveDecimator::LogitCurveDecimator(double p_left, double p_width,
+					 int p_numBins)
+  : m_left(p_left), m_binWidth((p_width > 0.0) ? p_width / p_numBins : 1.0),
+    m_numBins(p_numBins), m_count(0), m_bin(0)
+{ }
+
+int LogitCurveDecimator::GetBin(double p_x) const
+{
+  if (p_x < m_left)  return -1;
+  double bin = (p_x - m_left) / m_binWidth;
+  return (bin >= m_numBins) ? m_numBins : (int) bin;
+}
+
+void LogitCurveDecimator::Append(double p_x, double p_y)
+{
+  Point point = { m_count, p_x, p_y };
+  int bin = GetBin(p_x);
+  if (m_count++ == 0 || bin != m_bin) {
+    if (m_count > 1)  FlushRun(m_x, m_y);
+    m_bin = bin;
+    m_first = m_last = m_minX = m_maxX = m_minY = m_maxY = point;
+    return;
+  }
+
+  m_last = point;
+  if (p_x < m_minX.m_x)  m_minX = point;
+  if (p_x > m_maxX.m_x)  m_maxX = point;
+  if (p_y < m_minY.m_y)  m_minY = point;
+  if (p_y > m_maxY.m_y)  m_maxY = point;
+}
+
+void LogitCurveDecimator::FlushRun(std::vector<double> &p_x,
+				   std::vector<double> &p_y) const
+{
+  Point run[6] = { m_first, m_minX, m_maxX, m_minY, m_maxY, m_last };
+  std::sort(run, run + 6, IsEarlier);
+  for (int i = 0; i < 6; i++) {
+    if (i == 0 || run[i].m_index != run[i-1].m_index) {
+      p_x.push_back(run[i].m_x);
+      p_y.push_back(run[i].m_y);
+    }
+  }
+}
+
+wxPlotData *LogitCurveDecimator::NewCurve(void) const
+{
+  std::vector<double> x(m_x), y(m_y);
+  if (m_count > 0)  FlushRun(x, y);
+
+  wxPlotData *curve = new wxPlotData((int) x.size());
+  for (size_t i = 0; i < x.size(); i++) {
+    curve->SetValue(i, x[i], y[i]);
+  }
+  return curve;
+}
+
 //========================================================================
 //                     class gbtLogitPlotStrategyList
 //========================================================================
@@ -463,18 +579,39 @@ private:
   gbtLogitPlotStrategyList *m_plotStrategies;
   gbtLogitPlotCtrl *m_plotCtrl;
 
+  /// @name Reduced curves of the strategies shown
+  //@{
+  std::vector<int> m_strategies;
+  std::vector<LogitCurveDecimator> m_curves;
+  /// The horizontal extent and resolution the curves were reduced for;
+  /// no columns means the curves have not been computed
+  double m_curveLeft, m_curveWidth;
+  int m_curveColumns;
+  /// The number of points in the curves last shown
+  int m_pointsShown;
+  //@}
+
+  /// Reduces the curves for the horizontal extent of p_view
+  void ComputeCurves(const wxRect2DDouble &p_view);
+  /// Replaces the curves in the plot by the reduced curves
+  void ShowCurves(void);
+  int GetPlotColumns(void) const;
+
   // Event handlers
   void OnChangeStrategies(wxSheetEvent &) { Plot(); }
+  void OnViewChanged(wxPlotEvent &);
 
 public:
   LogitPlotPanel(wxWindow *p_parent, gbtGameDocument *p_doc);
 
-  void AddProfile(const wxString &p_text)
-  { m_branch.AddProfile(p_text); }
+  void AddProfile(const wxString &p_text);
 
   void SetScaleFactor(double p_scale);
   void FitZoom(void);
+  /// Plots the whole branch, and fits the view to it
   void Plot(void);
+  /// Adds the points received since the plot was last drawn
+  void PlotNewPoints(void);
 
   LogitMixedBranch &GetBranch(void) { return m_branch; }
   wxPlotCtrl *GetPlotCtrl(void) const { return m_plotCtrl; }
@@ -482,7 +619,8 @@ public:
 
 LogitPlotPanel::LogitPlotPanel(wxWindow *p_parent,
 				     gbtGameDocument *p_doc)
-  : wxPanel(p_parent, wxID_ANY), m_doc(p_doc), m_branch(p_doc)
+  : wxPanel(p_parent, wxID_ANY), m_doc(p_doc), m_branch(p_doc),
+    m_curveLeft(0.0), m_curveWidth(0.0), m_curveColumns(0), m_pointsShown(0)
 {
   m_plotCtrl = new gbtLogitPlotCtrl(this, p_doc);
   m_plotCtrl->SetSizeHints(wxSize(600, 400));
@@ -498,40 +636,127 @@ LogitPlotPanel::LogitPlotPanel(wxWindow *p_parent,
 
   Connect(m_plotStrategies->GetId(), wxEVT_SHEET_CELL_LEFT_UP,
 	  (wxObjectEventFunction) (wxEventFunction) wxStaticCastEvent(wxSheetEventFunction, wxSheetEventFunction(&LogitPlotPanel::OnChangeStrategies)));
+  Connect(m_plotCtrl->GetId(), wxEVT_PLOT_VIEW_CHANGED,
+	  (wxObjectEventFunction) (wxEventFunction) wxStaticCastEvent(wxPlotEventFunction, wxPlotEventFunction(&LogitPlotPanel::OnViewChanged)));
 
   SetSizer(sizer);
   Layout();
 }
 				    
-void LogitPlotPanel::Plot(void)
+void LogitPlotPanel::AddProfile(const wxString &p_text)
 {
-  if (m_branch.NumPoints() == 0)  return;
+  m_branch.AddProfile(p_text);
+  if (m_curveColumns == 0)  return;
 
-  m_plotCtrl->DeleteCurve(-1);
+  int n = m_branch.NumPoints();
+  double x = m_plotCtrl->LambdaToX(m_branch.GetLambda(n));
+  for (size_t i = 0; i < m_curves.size(); i++) {
+    m_curves[i].Append(x, m_branch.GetCurve(m_strategies[i])[n-1]);
+  }
+}
+
+//
+// A long branch has many more points than there are pixels across
+// the plot.  Each curve is reduced to the points needed to draw it
+// at the resolution of the view, and reduced again from the whole
+// branch when the view is zoomed or scrolled.
+//
+int LogitPlotPanel::GetPlotColumns(void) const
+{
+  int width = m_plotCtrl->GetPlotAreaRect().width;
+  return (width > 0) ? width : m_plotCtrl->GetMinWidth();
+}
+
+void LogitPlotPanel::ComputeCurves(const wxRect2DDouble &p_view)
+{
+  m_curveLeft = p_view.m_x;
+  m_curveWidth = p_view.m_width;
+  m_curveColumns = std::max(GetPlotColumns(), 1);
+
+  std::vector<double> x(m_branch.NumPoints());
+  for (int i = 0; i < m_branch.NumPoints(); i++) {
+    x[i] = m_plotCtrl->LambdaToX(m_branch.GetLambda(i+1));
+  }
 
+  m_strategies.clear();
+  m_curves.clear();
   for (int st = 1; st <= m_doc->GetGame()->MixedProfileLength(); st++) {
     if (!m_plotStrategies->IsStrategyShown(st)) continue;
 
-    wxPlotData *curve = new wxPlotData(m_branch.NumPoints());
+    LogitCurveDecimator curve(m_curveLeft, m_curveWidth, m_curveColumns);
+    const std::vector<double> &y = m_branch.GetCurve(st);
+    for (size_t i = 0; i < x.size(); i++) {
+      curve.Append(x[i], y[i]);
+    }
+    m_strategies.push_back(st);
+    m_curves.push_back(curve);
+  }
+}
 
-    GameStrategy strategy = m_doc->GetGame()->GetStrategy(st);
+void LogitPlotPanel::ShowCurves(void)
+{
+  m_plotCtrl->BeginBatch();
+  m_plotCtrl->DeleteCurve(-1);
+
+  for (size_t i = 0; i < m_curves.size(); i++) {
+    wxPlotData *curve = m_curves[i].NewCurve();
+
+    GameStrategy strategy = m_doc->GetGame()->GetStrategy(m_strategies[i]);
     GamePlayer player = strategy->GetPlayer();
 
     curve->SetFilename(wxString(player->GetLabel().c_str(), *wxConvCurrent) +
 		       wxT(":") +
 		       wxString(strategy->GetLabel().c_str(), *wxConvCurrent));
-    
-    for (int i = 0; i < m_branch.NumPoints(); i++) {
-      curve->SetValue(i, m_plotCtrl->LambdaToX(m_branch.GetLambda(i+1)), 
-		      m_branch.GetProfile(i+1)[st]);
-    }
-
     curve->SetPen(wxPLOTPEN_NORMAL, 
 		  wxPen(m_doc->GetStyle().GetPlayerColor(player->GetNumber()),
 			1, wxSOLID));
 
     m_plotCtrl->AddCurve(curve, false);
   }
+
+  m_plotCtrl->EndBatch();
+  m_pointsShown = m_branch.NumPoints();
+}
+
+void LogitPlotPanel::Plot(void)
+{
+  if (m_branch.NumPoints() == 0)  return;
+
+  // Reduce the curves for the view which fits the whole branch
+  double left = m_plotCtrl->LambdaToX(m_branch.GetLambda(1)), right = left;
+  for (int i = 2; i <= m_branch.NumPoints(); i++) {
+    double x = m_plotCtrl->LambdaToX(m_branch.GetLambda(i));
+    left = std::min(left, x);
+    right = std::max(right, x);
+  }
+  ComputeCurves(wxRect2DDouble(left, 0.0, right - left, 1.0));
+  ShowCurves();
+  if (m_plotCtrl->GetCurveCount() > 0) {
+    m_plotCtrl->MakeCurveVisible(-1);
+  }
+}
+
+void LogitPlotPanel::PlotNewPoints(void)
+{
+  if (m_branch.NumPoints() == m_pointsShown)  return;
+
+  if (m_curveColumns == 0) {
+    // Lambda is mapped into [0,1), so the initial view holds the branch
+    ComputeCurves(m_plotCtrl->GetViewRect());
+  }
+  ShowCurves();
+}
+
+void LogitPlotPanel::OnViewChanged(wxPlotEvent &)
+{
+  if (m_curveColumns == 0)  return;
+
+  const wxRect2DDouble &view = m_plotCtrl->GetViewRect();
+  if (view.m_x != m_curveLeft || view.m_width != m_curveWidth ||
+      GetPlotColumns() != m_curveColumns) {
+    ComputeCurves(view);
+    ShowCurves();
+  }
 }
 
 void LogitPlotPanel::SetScaleFactor(double p_scale)
@@ -542,7 +767,7 @@ void LogitPlotPanel::SetScaleFactor(double p_scale)
 
 void LogitPlotPanel::FitZoom(void)
 {
-  m_plotCtrl->MakeCurveVisible(-1);
+  Plot();
 }
 
 //========================================================================
@@ -794,6 +1019,7 @@ void LogitMixedDialog::OnIdle(wxIdleEvent &p_event)
 
 void LogitMixedDialog::OnTimer(wxTimerEvent &p_event)
 {
+  m_plot->PlotNewPoints();
   wxWakeUpIdle();
 }
 
@@ -0,0 +1,287 @@
+//
+// This file is part of Gambit
+// Copyright (c) 1994-2014, The Gambit Project (http://www.gambit-project.org)
+//
+// FILE: src/gui/dominance.cc
+// Cached dominance status of the strategies in the current support
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+//
+
+#include <vector>
+
+#include <wx/wxprec.h>
+#ifndef WX_PRECOMP
+#include <wx/wx.h>
+#endif  // WX_PRECOMP
+#include <wx/thread.h>
+
+#include "libgambit/libgambit.h"
+#include "dominance.h"
+
+typedef std::vector<std::vector<gbtDominanceStatus> > gbtDominanceTable;
+
+// Supports needing more strategy comparisons than this are done on a
+// worker thread.  A comparison is one contingency of the other players.
+static const double c_threadComparisons = 50000.0;
+
+const int GBT_ID_DOMINANCE_TIMER = 1000;
+
+//=========================================================================
+//                         class gbtDominanceJob
+//=========================================================================
+
+//
+// The state shared between a worker and the map which started it.
+// Each holds a reference, so whichever goes away last deletes it.
+//
+class gbtDominanceJob {
+private:
+  wxMutex m_mutex;
+  int m_refCount;
+  bool m_cancelled, m_finished;
+  gbtDominanceTable m_status;
+
+public:
+  gbtDominanceJob(void)
+    : m_refCount(1), m_cancelled(false), m_finished(false) { }
+
+  void AddRef(void)
+  { wxMutexLocker lock(m_mutex);  m_refCount++; }
+  void Release(void);
+
+  void Cancel(void)
+  { wxMutexLocker lock(m_mutex);  m_cancelled = true; }
+  bool IsCancelled(void)
+  { wxMutexLocker lock(m_mutex);  return m_cancelled; }
+
+  void Finish(gbtDominanceTable &p_status)
+  { wxMutexLocker lock(m_mutex);  m_status.swap(p_status);  m_finished = true; }
+  /// If the map is complete, moves it into p_status and returns true
+  bool Take(gbtDominanceTable &p_status);
+};
+
+void gbtDominanceJob::Release(void)
+{
+  bool last;
+  {
+    wxMutexLocker lock(m_mutex);
+    last = (--m_refCount == 0);
+  }
+  if (last) {
+    delete this;
+  }
+}
+
+bool gbtDominanceJob::Take(gbtDominanceTable &p_status)
+{
+  wxMutexLocker lock(m_mutex);
+  if (!m_finished) {
+    return false;
+  }
+  p_status.swap(m_status);
+  return true;
+}
+
+//
+// Fills in the status of each strategy in the support.  A strictly
+// dominated strategy is also weakly dominated, so the (usually
+// successful) weak test comes first.  Returns false if stopped because
+// p_job was cancelled.
+//
+static bool ComputeDominance(const StrategySupportProfile &p_support,
+			     gbtDominanceTable &p_status,
+			     gbtDominanceJob *p_job = 0)
+{
+  Game game = p_support.GetGame();
+  p_status.assign(game->NumPlayers(), std::vector<gbtDominanceStatus>());
+  for (int pl = 1; pl <= game->NumPlayers(); pl++) {
+    p_status[pl-1].assign(game->GetPlayer(pl)->NumStrategies(),
+			  GBT_DOMINANCE_NONE);
+    for (int st = 1; st <= p_support.NumStrategies(pl); st++) {
+      if (p_job && p_job->IsCancelled()) {
+	return false;
+      }
+      GameStrategy strategy = p_support.GetStrategy(pl, st);
+      if (p_support.IsDominated(strategy, false)) {
+	p_status[pl-1][strategy->GetNumber()-1] =
+	  (p_support.IsDominated(strategy, true)) ?
+	  GBT_DOMINANCE_STRICT : GBT_DOMINANCE_WEAK;
+      }
+    }
+  }
+  return true;
+}
+
+#if wxUSE_THREADS
+
+//=========================================================================
+//                        class gbtDominanceThread
+//=========================================================================
+
+//
+// A detached thread, which deletes itself when the computation ends.
+// The support refers to a frozen copy of the document's game.
+//
+class gbtDominanceThread : public wxThread {
+private:
+  gbtDominanceJob *m_job;
+  StrategySupportProfile m_support;
+
+protected:
+  ExitCode Entry(void);
+
+public:
+  gbtDominanceThread(gbtDominanceJob *p_job,
+		     const StrategySupportProfile &p_support)
+    : wxThread(wxTHREAD_DETACHED), m_job(p_job), m_support(p_support)
+  { m_job->AddRef(); }
+  virtual ~gbtDominanceThread() { m_job->Release(); }
+};
+
+wxThread::ExitCode gbtDominanceThread::Entry(void)
+{
+  gbtDominanceTable status;
+  try {
+    if (ComputeDominance(m_support, status, m_job)) {
+      m_job->Finish(status);
+    }
+  }
+  catch (std::exception &) {
+    // Leave the strategies shown as undominated
+    status.clear();
+    m_job->Finish(status);
+  }
+  return 0;
+}
+
+//
+// The support p_support restricted to a copy of its game which can
+// be read while the document's game stays editable
+//
+static StrategySupportProfile FrozenSupport(const StrategySupportProfile &p_support)
+{
+  Game game = p_support.GetGame()->Copy();
+  game->Freeze();
+  StrategySupportProfile support(game);
+  for (int pl = 1; pl <= game->NumPlayers(); pl++) {
+    GamePlayer player = p_support.GetGame()->GetPlayer(pl);
+    for (int st = 1; st <= player->NumStrategies(); st++) {
+      if (!p_support.Contains(player->GetStrategy(st))) {
+	support.RemoveStrategy(game->GetPlayer(pl)->GetStrategy(st));
+      }
+    }
+  }
+  return support;
+}
+
+#endif  // wxUSE_THREADS
+
+//=========================================================================
+//                         class gbtDominanceMap
+//=========================================================================
+
+BEGIN_EVENT_TABLE(gbtDominanceMap, wxEvtHandler)
+  EVT_TIMER(GBT_ID_DOMINANCE_TIMER, gbtDominanceMap::OnTimer)
+END_EVENT_TABLE()
+
+gbtDominanceMap::gbtDominanceMap(gbtGameDocument *p_doc)
+  : m_doc(p_doc), m_revision(0), m_valid(false), m_job(0),
+    m_timer(this, GBT_ID_DOMINANCE_TIMER)
+{ }
+
+gbtDominanceMap::~gbtDominanceMap()
+{
+  StopJob();
+}
+
+void gbtDominanceMap::StopJob(void)
+{
+  m_timer.Stop();
+  if (m_job) {
+    m_job->Cancel();
+    m_job->Release();
+    m_job = 0;
+  }
+}
+
+gbtDominanceStatus gbtDominanceMap::GetStatus(const GameStrategy &p_strategy)
+{
+  if (m_revision != m_doc->m_stratSupports.GetRevision()) {
+    Start();
+  }
+  if (!m_valid) {
+    return GBT_DOMINANCE_NONE;
+  }
+
+  int pl = p_strategy->GetPlayer()->GetNumber();
+  int st = p_strategy->GetNumber();
+  if (pl > (int) m_status.size() || st > (int) m_status[pl-1].size()) {
+    return GBT_DOMINANCE_NONE;
+  }
+  return m_status[pl-1][st-1];
+}
+
+void gbtDominanceMap::Start(void)
+{
+  StopJob();
+  m_revision = m_doc->m_stratSupports.GetRevision();
+  m_valid = false;
+
+  const StrategySupportProfile &support = m_doc->GetNfgSupport();
+  // Each strategy is compared against the others of its player, in
+  // every contingency of the other players' strategies
+  double comparisons = 0.0;
+  for (int pl = 1; pl <= support.GetGame()->NumPlayers(); pl++) {
+    double contingencies = 1.0;
+    for (int opp = 1; opp <= support.GetGame()->NumPlayers(); opp++) {
+      if (opp != pl) {
+	contingencies *= support.NumStrategies(opp);
+      }
+    }
+    comparisons += (contingencies * support.NumStrategies(pl) *
+		    support.NumStrategies(pl));
+  }
+
+#if wxUSE_THREADS
+  if (comparisons > c_threadComparisons) {
+    m_job = new gbtDominanceJob;
+    gbtDominanceThread *thread =
+      new gbtDominanceThread(m_job, FrozenSupport(support));
+    if (thread->Create() == wxTHREAD_NO_ERROR &&
+	thread->Run() == wxTHREAD_NO_ERROR) {
+      m_timer.Start(100);
+      return;
+    }
+    delete thread;
+    m_job->Release();
+    m_job = 0;
+  }
+#endif  // wxUSE_THREADS
+
+  ComputeDominance(support, m_status);
+  m_valid = true;
+}
+
+void gbtDominanceMap::OnTimer(wxTimerEvent &)
+{
+  if (!m_job || !m_job->Take(m_status)) {
+    return;
+  }
+  StopJob();
+  m_valid = true;
+  // Nothing about the game has changed; the views just need redrawing
+  m_doc->NotifyViews(GBT_DOC_MODIFIED_NONE, 0);
+}
@@ -0,0 +1,68 @@
+//
+// This file is part of Gambit
+// Copyright (c) 1994-2014, The Gambit Project (http://www.gambit-project.org)
+//
+// FILE: src/gui/dominance.h
+// Cached dominance status of the strategies in the current support
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+//
+
+#ifndef DOMINANCE_H
+#define DOMINANCE_H
+
+#include <vector>
+#include "gamedoc.h"
+
+class gbtDominanceJob;
+
+//!
+//! The dominance status of each strategy in the document's current
+//! strategy support, so that drawing the table does not test for
+//! dominance cell by cell.  The map is computed the first time it is
+//! asked for after the support changes.
+//!
+//! For large games, the map is computed on a worker thread, using a
+//! frozen copy of the game.  Strategies are reported as undominated
+//! until it is ready; the views are then updated.
+//!
+class gbtDominanceMap : public wxEvtHandler {
+private:
+  gbtGameDocument *m_doc;
+  /// Revision of the support stack the map is (being) computed for
+  unsigned long m_revision;
+  /// Whether m_status holds the map for m_revision
+  bool m_valid;
+  /// Status of each strategy, by player, then strategy number
+  std::vector<std::vector<gbtDominanceStatus> > m_status;
+  /// The computation on the worker thread, if one is running
+  gbtDominanceJob *m_job;
+  wxTimer m_timer;
+
+  void Start(void);
+  void StopJob(void);
+  void OnTimer(wxTimerEvent &);
+
+public:
+  gbtDominanceMap(gbtGameDocument *p_doc);
+  virtual ~gbtDominanceMap();
+
+  /// The status of the strategy in the current support
+  gbtDominanceStatus GetStatus(const GameStrategy &p_strategy);
+
+  DECLARE_EVENT_TABLE()
+};
+
+#endif  // DOMINANCE_H
@@ -583,7 +583,6 @@ void gbtEfgDisplay::OnUpdate(void)
     }
   }
 
-  // Force a rebuild on every change for now.
   RefreshTree();
 
   Gambit::GameNode selectNode = m_doc->GetSelectNode();
@@ -612,8 +611,7 @@ void gbtEfgDisplay::OnUpdate(void)
 
 void gbtEfgDisplay::RefreshTree(void)
 {
-  m_layout.BuildNodeList(m_doc->GetEfgSupport());
-  m_layout.Layout(m_doc->GetEfgSupport());
+  m_layout.Update();
   Refresh();
 }
 
@@ -662,7 +660,14 @@ void gbtEfgDisplay::OnDraw(wxDC &p_dc)
 #endif
   p_dc.Clear();
   int maxX = m_layout.MaxX();
-  m_layout.Render(p_dc, false);
+  // Only the part of the tree in the window needs drawing
+  int width, height, x, y;
+  GetClientSize(&width, &height);
+  CalcUnscrolledPosition(0, 0, &x, &y);
+  m_layout.Render(p_dc, false,
+		  wxRect((int) (x / (.01 * m_zoom)), (int) (y / (.01 * m_zoom)),
+			 (int) (width / (.01 * m_zoom)) + 1,
+			 (int) (height / (.01 * m_zoom)) + 1));
 #if !wxCHECK_VERSION(2,7,0)
   p_dc.EndDrawing();
 #endif
@@ -21,6 +21,7 @@
 //
 
 #include <cmath>
+#include <climits>
 #include <algorithm>    // for std::min, std::max
 
 #include <wx/wxprec.h>
@@ -41,7 +42,9 @@ gbtNodeEntry::gbtNodeEntry(Gambit::GameNode p_node)
     m_size(20), m_token(GBT_NODE_TOKEN_CIRCLE),
     m_branchStyle(GBT_BRANCH_STYLE_LINE), m_branchLabel(GBT_BRANCH_LABEL_HORIZONTAL),
     m_branchLength(0),
-    m_sublevel(0), m_actionProb(0)
+    m_sublevel(0), m_actionProb(0), m_labelsValid(false),
+    m_position(0), m_lastDescendant(0), m_layoutValid(false),
+    m_ycoordStart(0), m_ycoordEnd(0), m_subtreeMinY(0), m_subtreeMaxY(0)
 { }
 
 int gbtNodeEntry::GetChildNumber(void) const
@@ -354,14 +357,64 @@ bool gbtNodeEntry::NodeHitTest(int p_x, int p_y) const
 gbtTreeLayout::gbtTreeLayout(gbtEfgDisplay *p_parent, gbtGameDocument *p_doc)
   : gbtGameView(p_doc), 
     /* m_parent(p_parent),*/ m_infosetSpacing(40),
-    c_leftMargin(20), c_topMargin(40)
+    c_leftMargin(20), c_topMargin(40), c_bandHeight(100),
+    m_supportLevel(0), m_numProfileLists(0), m_profileList(0), m_profile(0)
 { }
 
+gbtTreeLayout::~gbtTreeLayout()
+{
+  for (int i = 1; i <= m_nodeList.Length(); delete m_nodeList[i++]);
+}
+
+//
+// Lists each entry in the bands it may draw in.  An entry draws its
+// node, the branch from its parent, its labels and outcome, and the
+// line joining it to the next member of its information set; labels
+// and outcomes are allowed for by a generous margin above and below.
+//
+void gbtTreeLayout::BuildIndex(void)
+{
+  const gbtStyle &settings = m_doc->GetStyle();
+  int margin = (settings.NodeSize() / 2 + 3 * settings.GetFont().GetPointSize() +
+		m_infosetSpacing + 25);
+
+  m_bands = std::vector<std::vector<int> >((m_maxY + margin) / c_bandHeight + 1);
+  for (int pos = 1; pos <= m_nodeList.Length(); pos++) {
+    gbtNodeEntry *entry = m_nodeList[pos];
+    int top = entry->Y(), bottom = entry->Y();
+    if (entry->GetParent() && entry->GetParent() != entry) {
+      top = std::min(top, entry->GetParent()->Y());
+      bottom = std::max(bottom, entry->GetParent()->Y());
+    }
+    if (entry->GetNextMember()) {
+      top = std::min(top, entry->GetNextMember()->Y());
+      bottom = std::max(bottom, entry->GetNextMember()->Y());
+    }
+
+    int first = std::max(top - margin, 0) / c_bandHeight;
+    int last = std::min((bottom + margin) / c_bandHeight, 
+			(int) m_bands.size() - 1);
+    for (int band = first; band <= last; band++) {
+      m_bands[band].push_back(pos);
+    }
+  }
+}
+
+const std::vector<int> &gbtTreeLayout::GetBand(int p_y) const
+{
+  static const std::vector<int> empty;
+  if (p_y < 0 || p_y / c_bandHeight >= (int) m_bands.size()) {
+    return empty;
+  }
+  return m_bands[p_y / c_bandHeight];
+}
+
 Gambit::GameNode gbtTreeLayout::NodeHitTest(int p_x, int p_y) const
 {
-  for (int i = 1; i <= m_nodeList.Length(); i++) {
-    if (m_nodeList[i]->NodeHitTest(p_x, p_y)) {
-      return m_nodeList[i]->GetNode();
+  const std::vector<int> &band = GetBand(p_y);
+  for (size_t i = 0; i < band.size(); i++) {
+    if (m_nodeList[band[i]]->NodeHitTest(p_x, p_y)) {
+      return m_nodeList[band[i]]->GetNode();
     }
   }
   return 0;
@@ -369,9 +422,10 @@ Gambit::GameNode gbtTreeLayout::NodeHitTest(int p_x, int p_y) const
 
 Gambit::GameNode gbtTreeLayout::OutcomeHitTest(int p_x, int p_y) const
 {
-  for (int i = 1; i <= m_nodeList.Length(); i++) {
-    if (m_nodeList[i]->OutcomeHitTest(p_x, p_y)) {
-      return m_nodeList[i]->GetNode();
+  const std::vector<int> &band = GetBand(p_y);
+  for (size_t i = 0; i < band.size(); i++) {
+    if (m_nodeList[band[i]]->OutcomeHitTest(p_x, p_y)) {
+      return m_nodeList[band[i]]->GetNode();
     }
   }
   return 0;
@@ -379,9 +433,10 @@ Gambit::GameNode gbtTreeLayout::OutcomeHitTest(int p_x, int p_y) const
 
 Gambit::GameNode gbtTreeLayout::BranchAboveHitTest(int p_x, int p_y) const
 {
-  for (int i = 1; i <= m_nodeList.Length(); i++) {
-    if (m_nodeList[i]->BranchAboveHitTest(p_x, p_y)) {
-      return m_nodeList[i]->GetNode()->GetParent();
+  const std::vector<int> &band = GetBand(p_y);
+  for (size_t i = 0; i < band.size(); i++) {
+    if (m_nodeList[band[i]]->BranchAboveHitTest(p_x, p_y)) {
+      return m_nodeList[band[i]]->GetNode()->GetParent();
     }
   }
   return 0;
@@ -389,9 +444,10 @@ Gambit::GameNode gbtTreeLayout::BranchAboveHitTest(int p_x, int p_y) const
 
 Gambit::GameNode gbtTreeLayout::BranchBelowHitTest(int p_x, int p_y) const
 {
-  for (int i = 1; i <= m_nodeList.Length(); i++) {
-    if (m_nodeList[i]->BranchAboveHitTest(p_x, p_y)) {
-      return m_nodeList[i]->GetNode()->GetParent();
+  const std::vector<int> &band = GetBand(p_y);
+  for (size_t i = 0; i < band.size(); i++) {
+    if (m_nodeList[band[i]]->BranchAboveHitTest(p_x, p_y)) {
+      return m_nodeList[band[i]]->GetNode()->GetParent();
     }
   }
   return 0;
@@ -399,8 +455,9 @@ Gambit::GameNode gbtTreeLayout::BranchBelowHitTest(int p_x, int p_y) const
 
 Gambit::GameNode gbtTreeLayout::InfosetHitTest(int p_x, int p_y) const
 {
-  for (int i = 1; i <= m_nodeList.Length(); i++) {
-    gbtNodeEntry *entry = m_nodeList[i];
+  const std::vector<int> &band = GetBand(p_y);
+  for (size_t i = 0; i < band.size(); i++) {
+    gbtNodeEntry *entry = m_nodeList[band[i]];
     if (entry->GetNextMember() && entry->GetNode()->GetInfoset()) {
       if (p_x > entry->X() + entry->GetSublevel() * m_infosetSpacing - 2 &&
 	  p_x < entry->X() + entry->GetSublevel() * m_infosetSpacing + 2) {
@@ -551,19 +608,16 @@ gbtNodeEntry *gbtTreeLayout::GetValidChild(Gambit::GameNode e)
 
 gbtNodeEntry *gbtTreeLayout::GetEntry(Gambit::GameNode p_node) const
 {
-  for (int i = 1; i <= m_nodeList.Length(); i++) {
-    if (m_nodeList[i]->GetNode() == p_node) {
-      return m_nodeList[i];
-    }
-  }
-  return 0;
+  std::map<Gambit::GameNodeRep *, gbtNodeEntry *>::const_iterator entry =
+    m_entries.find(p_node);
+  return (entry != m_entries.end()) ? entry->second : 0;
 }
 
 Gambit::GameNode gbtTreeLayout::PriorSameLevel(Gambit::GameNode p_node) const
 {
   gbtNodeEntry *entry = GetEntry(p_node);
   if (entry) {
-    for (int i = m_nodeList.Find(entry) - 1; i >= 1; i--) {
+    for (int i = entry->m_position - 1; i >= 1; i--) {
       if (m_nodeList[i]->GetLevel() == entry->GetLevel())
 	return m_nodeList[i]->GetNode();
     }
@@ -575,7 +629,7 @@ Gambit::GameNode gbtTreeLayout::NextSameLevel(Gambit::GameNode p_node) const
 {
   gbtNodeEntry *entry = GetEntry(p_node);
   if (entry) {
-    for (int i = m_nodeList.Find(entry) + 1; i <= m_nodeList.Length(); i++) {
+    for (int i = entry->m_position + 1; i <= m_nodeList.Length(); i++) {
       if (m_nodeList[i]->GetLevel() == entry->GetLevel()) { 
 	return m_nodeList[i]->GetNode();
       }
@@ -584,20 +638,37 @@ Gambit::GameNode gbtTreeLayout::NextSameLevel(Gambit::GameNode p_node) const
   return 0;
 }
 
+//
+// Lays out the subtree rooted at p_node, returning the vertical position
+// of the node.  A subtree which is unchanged since it was last laid out
+// is only moved down or up to the new position of its first terminal
+// node, since the spacing of its terminal nodes is the same as before.
+//
 int gbtTreeLayout::LayoutSubtree(Gambit::GameNode p_node, const Gambit::BehaviorSupportProfile &p_support,
 				 int &p_maxy, int &p_miny, int &p_ycoord)
 {
+  gbtNodeEntry *entry = GetEntry(p_node);
+  if (entry->m_layoutValid) {
+    if (p_ycoord != entry->m_ycoordStart) {
+      ShiftSubtree(entry, p_ycoord - entry->m_ycoordStart);
+    }
+    p_ycoord = entry->m_ycoordEnd;
+    p_maxy = std::max(entry->m_subtreeMaxY, p_maxy);
+    p_miny = std::min(entry->m_subtreeMinY, p_miny);
+    return entry->Y();
+  }
+
   int y1 = -1, yn = 0;
+  int maxy = INT_MIN, miny = INT_MAX;
   const gbtStyle &settings = m_doc->GetStyle();
-    
-  gbtNodeEntry *entry = GetEntry(p_node);
-  entry->SetNextMember(0);
+
+  entry->m_ycoordStart = p_ycoord;
   if (m_doc->GetStyle().RootReachable() &&
       p_node->GetInfoset() && !p_node->GetInfoset()->GetPlayer()->IsChance()) {
     Gambit::GameInfoset infoset = p_node->GetInfoset();
     for (int i = 1; i <= p_support.NumActions(infoset); i++) {
       yn = LayoutSubtree(p_node->GetChild(p_support.GetAction(infoset, i)->GetNumber()),
-			 p_support, p_maxy, p_miny, p_ycoord);
+			 p_support, maxy, miny, p_ycoord);
       if (y1 == -1) {
 	y1 = yn;
       }
@@ -608,14 +679,14 @@ int gbtTreeLayout::LayoutSubtree(Gambit::GameNode p_node, const Gambit::Behavior
     if (p_node->NumChildren() > 0) {
       for (int i = 1; i <= p_node->NumChildren(); i++) {
 	yn = LayoutSubtree(p_node->GetChild(i), p_support,
-			   p_maxy, p_miny, p_ycoord);
+			   maxy, miny, p_ycoord);
 	if (y1 == -1) {
 	  y1 = yn;
 	}
 	
 	if (!p_node->GetPlayer()->IsChance() &&
 	    !p_support.Contains(p_node->GetInfoset()->GetAction(i))) {
-	  m_nodeList[p_node->GetChild(i)->GetNumber()]->SetInSupport(false);
+	  GetEntry(p_node->GetChild(i))->SetInSupport(false);
 	}
       }
       entry->SetY((y1 + yn) / 2);
@@ -625,16 +696,6 @@ int gbtTreeLayout::LayoutSubtree(Gambit::GameNode p_node, const Gambit::Behavior
       p_ycoord += settings.TerminalSpacing();
     }
   }
-    
-  if (settings.BranchStyle() == GBT_BRANCH_STYLE_LINE) {
-    entry->SetX(c_leftMargin + entry->GetLevel() * (settings.NodeSize() +
-						    settings.BranchLength()));
-  }
-  else {
-    entry->SetX(c_leftMargin + entry->GetLevel() * (settings.NodeSize() +
-						    settings.BranchLength() +
-						    settings.TineLength()));
-  }
 
   if (p_node->GetPlayer() && p_node->GetPlayer()->IsChance()) {
     entry->SetColor(settings.ChanceColor());
@@ -656,33 +717,63 @@ int gbtTreeLayout::LayoutSubtree(Gambit::GameNode p_node, const Gambit::Behavior
   }
   entry->SetBranchLength(settings.BranchLength());
 
-  p_maxy = std::max(entry->Y(), p_maxy);
-  p_miny = std::min(entry->Y(), p_miny);
+  entry->m_ycoordEnd = p_ycoord;
+  entry->m_subtreeMaxY = std::max(entry->Y(), maxy);
+  entry->m_subtreeMinY = std::min(entry->Y(), miny);
+  entry->m_layoutValid = true;
+
+  p_maxy = std::max(entry->m_subtreeMaxY, p_maxy);
+  p_miny = std::min(entry->m_subtreeMinY, p_miny);
     
   return entry->Y();
 }
 
+void gbtTreeLayout::ShiftSubtree(gbtNodeEntry *p_entry, int p_delta)
+{
+  for (int pos = p_entry->m_position; pos <= p_entry->m_lastDescendant; pos++) {
+    gbtNodeEntry *entry = m_nodeList[pos];
+    entry->SetY(entry->Y() + p_delta);
+    entry->m_ycoordStart += p_delta;
+    entry->m_ycoordEnd += p_delta;
+    entry->m_subtreeMinY += p_delta;
+    entry->m_subtreeMaxY += p_delta;
+  }
+}
+
 //
-// Checks if there are any nodes in the same infoset as e that are either
-// on the same level (if SHOWISET_SAME) or on any level (if SHOWISET_ALL)
+// Finds, for each entry, the next entry in the list in the same infoset
+// which is either on the same level (if SHOWISET_SAME) or on any level
+// (if SHOWISET_ALL).  Terminal nodes all have the null infoset, and so
+// are joined up in the same way.
 //
-gbtNodeEntry *gbtTreeLayout::NextInfoset(gbtNodeEntry *e)
+void gbtTreeLayout::FindNextMembers(void)
 {
-  const gbtStyle &draw_settings = m_doc->GetStyle();
-  
-  for (int pos = m_nodeList.Find(e) + 1; pos <= m_nodeList.Length(); pos++) {
-    gbtNodeEntry *e1 = m_nodeList[pos];
-    // infosets are the same and the nodes are on the same level
-    if (e->GetNode()->GetInfoset() == e1->GetNode()->GetInfoset()) {
-      if (draw_settings.InfosetConnect() == GBT_INFOSET_CONNECT_ALL) {
-	return e1;
-      }
-      else if (e->GetLevel() == e1->GetLevel()) {
-	return e1;
-      }
+  bool anyLevel = (m_doc->GetStyle().InfosetConnect() == GBT_INFOSET_CONNECT_ALL);
+  std::map<std::pair<Gambit::GameInfosetRep *, int>, gbtNodeEntry *> following;
+
+  m_nextMembers = std::vector<gbtNodeEntry *>(m_nodeList.Length() + 1, 
+					      (gbtNodeEntry *) 0);
+  for (int pos = m_nodeList.Length(); pos >= 1; pos--) {
+    gbtNodeEntry *entry = m_nodeList[pos];
+    std::pair<Gambit::GameInfosetRep *, int> key(entry->GetNode()->GetInfoset(),
+						  (anyLevel) ? -1 : entry->GetLevel());
+    std::map<std::pair<Gambit::GameInfosetRep *, int>, gbtNodeEntry *>::iterator next = following.find(key);
+    if (next != following.end()) {
+      m_nextMembers[pos] = next->second;
+      next->second = entry;
+    }
+    else {
+      following[key] = entry;
     }
   }
-  return 0;
+
+  m_sublevels.clear();
+  m_levelSublevels = std::vector<int>(m_maxLevel + 1, 0);
+}
+
+gbtNodeEntry *gbtTreeLayout::NextInfoset(gbtNodeEntry *e) const
+{
+  return m_nextMembers[e->m_position];
 }
 
 //
@@ -693,43 +784,31 @@ gbtNodeEntry *gbtTreeLayout::NextInfoset(gbtNodeEntry *e)
 //
 void gbtTreeLayout::CheckInfosetEntry(gbtNodeEntry *e)
 {
-  int pos;
-  gbtNodeEntry *infoset_entry, *e1;
+  gbtNodeEntry *infoset_entry = NextInfoset(e);
   // Check if the infoset this entry belongs to (on this level) has already
   // been processed.  If so, make this entry->num the same as the one already
   // processed and return
-  infoset_entry = NextInfoset(e);
-  for (pos = 1; pos <= m_nodeList.Length(); pos++) {
-    e1 = m_nodeList[pos];
-    // if the infosets are the same and they are on the same level and e1 has been processed
-    if (e->GetNode()->GetInfoset() == e1->GetNode()->GetInfoset() && 
-	e->GetLevel() == e1->GetLevel() && e1->GetSublevel() > 0) {
-      e->SetSublevel(e1->GetSublevel());
-      if (infoset_entry) {
-	e->SetNextMember(infoset_entry);
-      }
-      return;
+  std::pair<Gambit::GameInfosetRep *, int> key(e->GetNode()->GetInfoset(),
+						e->GetLevel());
+  std::map<std::pair<Gambit::GameInfosetRep *, int>, int>::const_iterator processed = m_sublevels.find(key);
+  if (processed != m_sublevels.end()) {
+    e->SetSublevel(processed->second);
+    if (infoset_entry) {
+      e->SetNextMember(infoset_entry);
     }
+    return;
   }
     
   // If we got here, this entry does not belong to any processed infoset yet.
   // Check if it belongs to ANY infoset, if not just return
   if (!infoset_entry) return;
     
-  // If we got here, then this entry is new and is connected to other entries
-  // find the entry on the same level with the maximum num.
-  // This entry will have num = num+1.
-  int num = 0;
-  for (pos = 1; pos <= m_nodeList.Length(); pos++) {
-    e1 = m_nodeList[pos];
-    // Find the max num for this level
-    if (e->GetLevel() == e1->GetLevel())  {
-      num = std::max(e1->GetSublevel(), num);
-    }
-  }
-  num++;
+  // If we got here, then this entry is new and is connected to other entries;
+  // it goes on the next free line on its level.
+  int num = ++m_levelSublevels[e->GetLevel()];
   e->SetSublevel(num);
   e->SetNextMember(infoset_entry);
+  m_sublevels[key] = num;
 }
 
 void gbtTreeLayout::FillInfosetTable(Gambit::GameNode n, const Gambit::BehaviorSupportProfile &cur_sup)
@@ -796,21 +875,41 @@ void gbtTreeLayout::UpdateTableParents(void)
 
 void gbtTreeLayout::Layout(const Gambit::BehaviorSupportProfile &p_support)
 {
-  // Kinda kludgey; probably should query draw settings whenever needed.
-  m_infosetSpacing = 
-    (m_doc->GetStyle().InfosetJoin() == GBT_INFOSET_JOIN_LINES) ? 10 : 40;
-
   if (m_nodeList.Length() != m_doc->GetGame()->NumNodes()) {
     // A rebuild is in order; force it
     BuildNodeList(p_support);
   }
+  for (int pos = 1; pos <= m_nodeList.Length(); pos++) {
+    m_nodeList[pos]->m_layoutValid = false;
+  }
+  LayoutNodes(p_support);
+}
+
+void gbtTreeLayout::LayoutNodes(const Gambit::BehaviorSupportProfile &p_support)
+{
+  const gbtStyle &draw_settings = m_doc->GetStyle();
+
+  // Kinda kludgey; probably should query draw settings whenever needed.
+  m_infosetSpacing = 
+    (draw_settings.InfosetJoin() == GBT_INFOSET_JOIN_LINES) ? 10 : 40;
 
   int miny = 0, maxy = 0, ycoord = c_topMargin;
   LayoutSubtree(m_doc->GetGame()->GetRoot(), p_support, maxy, miny, ycoord);
 
-  const gbtStyle &draw_settings = m_doc->GetStyle();
+  int levelWidth = draw_settings.NodeSize() + draw_settings.BranchLength();
+  if (draw_settings.BranchStyle() != GBT_BRANCH_STYLE_LINE) {
+    levelWidth += draw_settings.TineLength();
+  }
+  for (int pos = 1; pos <= m_nodeList.Length(); pos++) {
+    gbtNodeEntry *entry = m_nodeList[pos];
+    entry->SetX(c_leftMargin + entry->GetLevel() * levelWidth);
+    entry->SetNextMember(0);
+    entry->SetSublevel(0);
+  }
+
   if (draw_settings.InfosetConnect() != GBT_INFOSET_CONNECT_NONE) {
     // FIXME! This causes lines to disappear... sometimes.
+    FindNextMembers();
     FillInfosetTable(m_doc->GetGame()->GetRoot(), p_support);
     UpdateTableInfosets();
   }
@@ -819,87 +918,207 @@ void gbtTreeLayout::Layout(const Gambit::BehaviorSupportProfile &p_support)
   GenerateLabels();
 
   m_maxY = maxy + 25;
+  BuildIndex();
 }
 
+//
+// Appends the entries for the subtree rooted at p_node to p_list, in
+// preorder.  The entry for a node is taken from p_reuse if it is there;
+// otherwise a new one is created.
+//
 void gbtTreeLayout::BuildNodeList(Gambit::GameNode p_node, const Gambit::BehaviorSupportProfile &p_support,
-				  int p_level)
+				  int p_level,
+				  std::map<Gambit::GameNodeRep *, gbtNodeEntry *> &p_reuse,
+				  std::vector<gbtNodeEntry *> &p_list)
 {
-  gbtNodeEntry *entry = new gbtNodeEntry(p_node);
-  entry->SetStyle(&m_doc->GetStyle());
-  m_nodeList.Append(entry);
+  gbtNodeEntry *entry;
+  std::map<Gambit::GameNodeRep *, gbtNodeEntry *>::iterator old = p_reuse.find(p_node);
+  if (old != p_reuse.end()) {
+    entry = old->second;
+    p_reuse.erase(old);
+  }
+  else {
+    entry = new gbtNodeEntry(p_node);
+    entry->SetStyle(&m_doc->GetStyle());
+  }
+  p_list.push_back(entry);
+  m_entries[p_node] = entry;
+  entry->m_position = p_list.size();
   entry->SetLevel(p_level);
   if (m_doc->GetStyle().RootReachable()) {
     Gambit::GameInfoset infoset = p_node->GetInfoset();
     if (infoset) {
       if (infoset->GetPlayer()->IsChance()) {
 	for (int i = 1; i <= p_node->NumChildren(); i++) {
-	  BuildNodeList(p_node->GetChild(i), p_support, p_level + 1);
+	  BuildNodeList(p_node->GetChild(i), p_support, p_level + 1,
+			p_reuse, p_list);
 	}
       }
       else {
 	for (int i = 1; i <= p_support.NumActions(infoset); i++) {
 	  BuildNodeList(p_node->GetChild(p_support.GetAction(infoset, i)->GetNumber()),
-			p_support, p_level + 1);
+			p_support, p_level + 1, p_reuse, p_list);
 	}
       }
     }
   }
   else {
     for (int i = 1; i <= p_node->NumChildren(); i++) {
-      BuildNodeList(p_node->GetChild(i), p_support, p_level + 1);
+      BuildNodeList(p_node->GetChild(i), p_support, p_level + 1,
+		    p_reuse, p_list);
     }
   }
+  entry->m_lastDescendant = p_list.size();
   m_maxLevel = std::max(p_level, m_maxLevel);
 }
 
 void gbtTreeLayout::BuildNodeList(const Gambit::BehaviorSupportProfile &p_support)
 {
-  while (m_nodeList.Length() > 0) {
-    delete m_nodeList.Remove(1);
+  for (int i = 1; i <= m_nodeList.Length(); delete m_nodeList[i++]);
+  m_entries.clear();
+  m_bands.clear();
+
+  std::map<Gambit::GameNodeRep *, gbtNodeEntry *> reuse;
+  std::vector<gbtNodeEntry *> list;
+  m_maxLevel = 0;
+  BuildNodeList(m_doc->GetGame()->GetRoot(), p_support, 0, reuse, list);
+
+  m_nodeList = Gambit::Array<gbtNodeEntry *>(list.size());
+  for (size_t i = 0; i < list.size(); i++) {
+    m_nodeList[i+1] = list[i];
   }
+}
 
+//
+// Builds the list of entries again after a change to the tree, keeping
+// the entries (and so the cached layout) of nodes still in the tree.
+//
+void gbtTreeLayout::RebuildNodeList(const Gambit::BehaviorSupportProfile &p_support)
+{
+  std::map<Gambit::GameNodeRep *, gbtNodeEntry *> reuse;
+  reuse.swap(m_entries);
+  m_bands.clear();
+
+  std::vector<gbtNodeEntry *> list;
   m_maxLevel = 0;
-  BuildNodeList(m_doc->GetGame()->GetRoot(), p_support, 0);
+  BuildNodeList(m_doc->GetGame()->GetRoot(), p_support, 0, reuse, list);
+
+  // Entries left over are for nodes no longer in the tree
+  for (std::map<Gambit::GameNodeRep *, gbtNodeEntry *>::iterator entry = reuse.begin();
+       entry != reuse.end(); ++entry) {
+    delete entry->second;
+  }
+
+  m_nodeList = Gambit::Array<gbtNodeEntry *>(list.size());
+  for (size_t i = 0; i < list.size(); i++) {
+    m_nodeList[i+1] = list[i];
+  }
 }
 
+//
+// Style changes, changes to the support shown, and changes to the game
+// for which the document does not say which subtree was affected, lead
+// to everything being done again.  When only a subtree of the game has
+// changed, the entries along the path from it to the root are laid out
+// again, and the subtrees hanging off that path are moved as needed.
+// Label strings are regenerated only for nodes whose labels could have
+// changed; as before, that is done lazily as they are drawn.
+//
+void gbtTreeLayout::Update(void)
+{
+  const gbtStyle &style = m_doc->GetStyle();
+  const Gambit::BehaviorSupportProfile &support = m_doc->GetEfgSupport();
+  gbtGameModificationType modifications = m_doc->GetLastModifications();
+  Gambit::GameNode subtree = m_doc->GetModifiedSubtree();
+
+  std::string styleXML = (style.GetLayoutXML() + style.GetColorXML() +
+			  style.GetFontXML() + style.GetLabelXML());
+
+  if (m_game != m_doc->GetGame() || styleXML != m_styleXML ||
+      m_supportLevel != m_doc->GetBehavElimLevel() ||
+      (modifications == GBT_DOC_MODIFIED_GAME && !subtree)) {
+    m_game = m_doc->GetGame();
+    m_styleXML = styleXML;
+    m_supportLevel = m_doc->GetBehavElimLevel();
+    BuildNodeList(support);
+    LayoutNodes(support);
+  }
+  else if (modifications == GBT_DOC_MODIFIED_GAME) {
+    RebuildNodeList(support);
+    for (Gambit::GameNode node = subtree; node; node = node->GetParent()) {
+      gbtNodeEntry *entry = GetEntry(node);
+      if (entry) {
+	entry->m_layoutValid = false;
+      }
+    }
+    // Infoset and action numbers shown in labels may have changed anywhere
+    LayoutNodes(support);
+  }
+  else if (m_numProfileLists != m_doc->NumProfileLists() ||
+	   m_profileList != m_doc->GetCurrentProfileList() ||
+	   m_profile != m_doc->GetCurrentProfile() ||
+	   ((modifications == GBT_DOC_MODIFIED_LABELS ||
+	     modifications == GBT_DOC_MODIFIED_PAYOFFS) && !subtree)) {
+    GenerateLabels();
+  }
+  else if (modifications == GBT_DOC_MODIFIED_LABELS) {
+    gbtNodeEntry *entry = GetEntry(subtree);
+    if (entry) {
+      entry->SetLabelsValid(false);
+    }
+  }
 
+  m_numProfileLists = m_doc->NumProfileLists();
+  m_profileList = m_doc->GetCurrentProfileList();
+  m_profile = m_doc->GetCurrentProfile();
+}
+
+//
+// Labels are only worked out for entries as they are drawn, so that
+// in a large tree only those scrolled into view are done.
+//
 void gbtTreeLayout::GenerateLabels(void)
 {
-  const gbtStyle &settings = m_doc->GetStyle();
   for (int i = 1; i <= m_nodeList.Length(); i++) {
-    gbtNodeEntry *entry = m_nodeList[i];
-    entry->SetNodeAboveLabel(CreateNodeLabel(entry,
+    m_nodeList[i]->SetLabelsValid(false);
+  }
+}
+
+void gbtTreeLayout::GenerateLabels(gbtNodeEntry *p_entry) const
+{
+  const gbtStyle &settings = m_doc->GetStyle();
+  p_entry->SetNodeAboveLabel(CreateNodeLabel(p_entry,
 					     settings.NodeAboveLabel()));
-    entry->SetNodeAboveFont(settings.GetFont());
-    entry->SetNodeBelowLabel(CreateNodeLabel(entry,
+  p_entry->SetNodeAboveFont(settings.GetFont());
+  p_entry->SetNodeBelowLabel(CreateNodeLabel(p_entry,
 					     settings.NodeBelowLabel()));
-    entry->SetNodeBelowFont(settings.GetFont());
-    if (entry->GetChildNumber() > 0) {
-      entry->SetBranchAboveLabel(CreateBranchLabel(entry,
+  p_entry->SetNodeBelowFont(settings.GetFont());
+  if (p_entry->GetChildNumber() > 0) {
+    p_entry->SetBranchAboveLabel(CreateBranchLabel(p_entry,
 						   settings.BranchAboveLabel()));
-      entry->SetBranchAboveFont(settings.GetFont());
-      entry->SetBranchBelowLabel(CreateBranchLabel(entry,
+    p_entry->SetBranchAboveFont(settings.GetFont());
+    p_entry->SetBranchBelowLabel(CreateBranchLabel(p_entry,
 						   settings.BranchBelowLabel()));
-      entry->SetBranchBelowFont(settings.GetFont());
+    p_entry->SetBranchBelowFont(settings.GetFont());
 
-      Gambit::GameNode parent = entry->GetNode()->GetParent();
-      if (parent->GetPlayer()->IsChance()) {
-	entry->SetActionProb(parent->GetInfoset()->GetActionProb(entry->GetChildNumber(), (double) 0));
-      }
-      else {
-	int profile = m_doc->GetCurrentProfile();
-	if (profile > 0) {
-	  try {
-	    entry->SetActionProb((double) Gambit::lexical_cast<Gambit::Rational>(m_doc->GetProfiles().GetActionProb(parent, entry->GetChildNumber())));
-	  }
-	  catch (ValueException &) {
-	    // This occurs when the probability is undefined
-	    entry->SetActionProb(0.0);
-	  }
+    Gambit::GameNode parent = p_entry->GetNode()->GetParent();
+    if (parent->GetPlayer()->IsChance()) {
+      p_entry->SetActionProb(parent->GetInfoset()->GetActionProb(p_entry->GetChildNumber(), (double) 0));
+    }
+    else {
+      int profile = m_doc->GetCurrentProfile();
+      if (profile > 0) {
+	try {
+	  p_entry->SetActionProb((double) Gambit::lexical_cast<Gambit::Rational>(m_doc->GetProfiles().GetActionProb(parent, p_entry->GetChildNumber())));
+	}
+	catch (ValueException &) {
+	  // This occurs when the probability is undefined
+	  p_entry->SetActionProb(0.0);
 	}
       }
     }
   }
+  p_entry->SetLabelsValid(true);
 }
 
 //
@@ -909,21 +1128,50 @@ void gbtTreeLayout::GenerateLabels(void)
 // The algorithm now traverses the tree as a linear linked list, eliminating
 // expensive searches.
 //
-// There was some clipping code in here, but it didn't correctly
-// deal with drawing information sets while scrolling.  So, the code
-// has temporarily been removed.  It remains to be seen whether
-// performance will require a more sophisticated solution to the
-// problem.  (TLT 5/2001)
+// If p_visible is not empty, only the entries listed in the bands it
+// covers are drawn.  Each entry is drawn together with its information
+// set line, so lines between members far apart are still drawn when
+// only one end is in view.
 //
-void gbtTreeLayout::RenderSubtree(wxDC &p_dc, bool p_noHints) const
+// A nonterminal entry is drawn when its first action leads to an
+// entry; this comes directly after it in the list.
+//
+void gbtTreeLayout::RenderSubtree(wxDC &p_dc, bool p_noHints,
+				  const wxRect &p_visible) const
 {
   const gbtStyle &settings = m_doc->GetStyle();
 
-  for (int pos = 1; pos <= m_nodeList.Length(); pos++) {
+  std::vector<int> positions;
+  if (p_visible.IsEmpty() || m_bands.empty()) {
+    for (int pos = 1; pos <= m_nodeList.Length(); pos++) {
+      positions.push_back(pos);
+    }
+  }
+  else {
+    int first = std::max(p_visible.GetTop(), 0) / c_bandHeight;
+    int last = std::min(p_visible.GetBottom() / c_bandHeight,
+			(int) m_bands.size() - 1);
+    for (int band = first; band <= last; band++) {
+      positions.insert(positions.end(), 
+		       m_bands[band].begin(), m_bands[band].end());
+    }
+    std::sort(positions.begin(), positions.end());
+    positions.erase(std::unique(positions.begin(), positions.end()),
+		    positions.end());
+  }
+
+  for (size_t i = 0; i < positions.size(); i++) {
+    int pos = positions[i];
     gbtNodeEntry *entry = m_nodeList[pos];  
-    gbtNodeEntry *parentEntry = entry->GetParent();
-        
-    if (entry->GetChildNumber() == 1) {
+
+    if (entry->GetNode()->NumChildren() == 0) {
+      if (!entry->LabelsValid())  GenerateLabels(entry);
+      entry->Draw(p_dc, m_doc->GetSelectNode(), p_noHints);
+    }
+    else if (pos < m_nodeList.Length() && 
+	     m_nodeList[pos+1]->GetChildNumber() == 1) {
+      gbtNodeEntry *parentEntry = entry;
+      if (!parentEntry->LabelsValid())  GenerateLabels(parentEntry);
       parentEntry->Draw(p_dc, m_doc->GetSelectNode(), p_noHints);
 
       if (m_doc->GetStyle().InfosetConnect() != GBT_INFOSET_CONNECT_NONE &&
@@ -989,12 +1237,9 @@ void gbtTreeLayout::RenderSubtree(wxDC &p_dc, bool p_noHints) const
       }
     }
 
-    if (entry->GetNode()->NumChildren() == 0) {
-      entry->Draw(p_dc, m_doc->GetSelectNode(), p_noHints);
-    }
-
     // As we draw, we determine the outcome label extents.  Adjust the
-    // overall size of the plot accordingly.
+    // overall size of the plot accordingly.  (Outcomes which have not
+    // yet been in view are not counted.)
     if (entry->GetOutcomeExtent().GetRight() > m_maxX) {
       m_maxX = entry->GetOutcomeExtent().GetRight();
     }
@@ -1003,6 +1248,12 @@ void gbtTreeLayout::RenderSubtree(wxDC &p_dc, bool p_noHints) const
 
 void gbtTreeLayout::Render(wxDC &p_dc, bool p_noHints) const
 { 
-  RenderSubtree(p_dc, p_noHints);
+  RenderSubtree(p_dc, p_noHints, wxRect());
+}
+
+void gbtTreeLayout::Render(wxDC &p_dc, bool p_noHints,
+			   const wxRect &p_visible) const
+{ 
+  RenderSubtree(p_dc, p_noHints, p_visible);
 }
 
@@ -23,11 +23,14 @@
 #ifndef EFGLAYOUT_H
 #define EFGLAYOUT_H
 
+#include <vector>
+#include <map>
 #include "libgambit/libgambit.h"
 #include "style.h"
 #include "gamedoc.h"
 
 class gbtNodeEntry {
+  friend class gbtTreeLayout;
 private:
   Gambit::GameNode m_node;        // the corresponding node in the game
   gbtNodeEntry *m_parent; // parent node
@@ -48,6 +51,7 @@ private:
   int m_level;        // depth of the node in tree
   int m_sublevel;     // # of the infoset line on this level
   double m_actionProb;  // probability incoming action is taken
+  bool m_labelsValid; // false if labels need regenerating before drawing
 
   wxString m_nodeAboveLabel, m_nodeBelowLabel;
   wxString m_branchAboveLabel, m_branchBelowLabel;
@@ -57,6 +61,13 @@ private:
 
   const gbtStyle *m_style;
 
+  // Kept by gbtTreeLayout so a relayout can skip unchanged subtrees
+  int m_position;       // index in the layout's list of entries
+  int m_lastDescendant; // index of the last entry in the subtree
+  bool m_layoutValid;   // false if the subtree must be laid out again
+  int m_ycoordStart, m_ycoordEnd;    // terminal spacing used by subtree
+  int m_subtreeMinY, m_subtreeMaxY;  // extent of nodes in subtree
+
 public:
   gbtNodeEntry(Gambit::GameNode p_parent);
 
@@ -135,6 +146,9 @@ public:
   const double &GetActionProb(void) const { return m_actionProb; }
   void SetActionProb(const double &p_prob) { m_actionProb = p_prob; }
 
+  bool LabelsValid(void) const { return m_labelsValid; }
+  void SetLabelsValid(bool p_valid) { m_labelsValid = p_valid; }
+
   void SetStyle(const gbtStyle *p_style) { m_style = p_style; }
 
   bool NodeHitTest(int p_x, int p_y) const;
@@ -168,34 +182,66 @@ class gbtTreeLayout : public gbtGameView {
 private:
   /* gbtEfgDisplay *m_parent; */
   Gambit::Array<gbtNodeEntry *> m_nodeList;
+  std::map<Gambit::GameNodeRep *, gbtNodeEntry *> m_entries;
   mutable int m_maxX, m_maxY, m_maxLevel;
   int m_infosetSpacing;
 
-  const int c_leftMargin, c_topMargin;
+  const int c_leftMargin, c_topMargin, c_bandHeight;
+
+  // The layout is divided into horizontal bands of height c_bandHeight.
+  // Each band lists, in increasing order, the positions in m_nodeList
+  // of the entries which may draw something within it; drawing and
+  // hit testing only look at the bands concerned.
+  std::vector<std::vector<int> > m_bands;
+
+  // The state of the document when the layout was last brought up to
+  // date, used by Update() to decide how much needs redoing
+  Gambit::Game m_game;
+  std::string m_styleXML;
+  int m_supportLevel;
+  int m_numProfileLists, m_profileList, m_profile;
+
+  // Working storage for connecting information set members: the next
+  // member of each entry's information set, indexed by position; the
+  // sublevel given to each (information set, level); and the number
+  // of sublevels used on each level
+  std::vector<gbtNodeEntry *> m_nextMembers;
+  std::map<std::pair<Gambit::GameInfosetRep *, int>, int> m_sublevels;
+  std::vector<int> m_levelSublevels;
 
   gbtNodeEntry *GetEntry(Gambit::GameNode) const;
 
-  gbtNodeEntry *NextInfoset(gbtNodeEntry *);
+  void FindNextMembers(void);
+  gbtNodeEntry *NextInfoset(gbtNodeEntry *) const;
   void CheckInfosetEntry(gbtNodeEntry *);
 
-  void BuildNodeList(Gambit::GameNode, const Gambit::BehaviorSupportProfile &, int);
+  void BuildNodeList(Gambit::GameNode, const Gambit::BehaviorSupportProfile &, int,
+		     std::map<Gambit::GameNodeRep *, gbtNodeEntry *> &,
+		     std::vector<gbtNodeEntry *> &);
+  void RebuildNodeList(const Gambit::BehaviorSupportProfile &);
+  void LayoutNodes(const Gambit::BehaviorSupportProfile &);
 
   int LayoutSubtree(Gambit::GameNode, const Gambit::BehaviorSupportProfile &, int &, int &, int &);
+  void ShiftSubtree(gbtNodeEntry *, int p_delta);
   void FillInfosetTable(Gambit::GameNode, const Gambit::BehaviorSupportProfile &);
   void UpdateTableInfosets(void);
   void UpdateTableParents(void);
 
+  void BuildIndex(void);
+  const std::vector<int> &GetBand(int p_y) const;
+
   wxString CreateNodeLabel(const gbtNodeEntry *, int) const;
   wxString CreateBranchLabel(const gbtNodeEntry *, int) const;
+  void GenerateLabels(gbtNodeEntry *) const;
 
-  void RenderSubtree(wxDC &dc, bool p_noHints) const;
+  void RenderSubtree(wxDC &dc, bool p_noHints, const wxRect &p_visible) const;
 
   // Overriding gbtGameView members
   void OnUpdate(void) { }
 
 public:
   gbtTreeLayout(gbtEfgDisplay *p_parent, gbtGameDocument *p_doc);
-  virtual ~gbtTreeLayout() { }
+  virtual ~gbtTreeLayout();
 
   Gambit::GameNode PriorSameLevel(Gambit::GameNode) const;
   Gambit::GameNode NextSameLevel(Gambit::GameNode) const;
@@ -203,6 +249,9 @@ public:
   void BuildNodeList(const Gambit::BehaviorSupportProfile &);
   void Layout(const Gambit::BehaviorSupportProfile &);
   void GenerateLabels(void);
+  /// Brings the layout up to date with the document, redoing only
+  /// what the last modification of the document affected
+  void Update(void);
 
   // The following member functions are for temporary compatibility only
   gbtNodeEntry *GetNodeEntry(Gambit::GameNode p_node) const
@@ -219,7 +268,11 @@ public:
   Gambit::GameNode BranchBelowHitTest(int, int) const;
   Gambit::GameNode InfosetHitTest(int, int) const;
 
+  /// Draws the whole tree
   void Render(wxDC &, bool p_noHints) const;
+  /// Draws the parts of the tree which may be seen in the rectangle
+  /// (in logical coordinates)
+  void Render(wxDC &, bool p_noHints, const wxRect &p_visible) const;
 };
 
 #endif  // EFGLAYOUT_H
@@ -22,18 +22,21 @@
 
 #include <sstream>
 #include <fstream>
+#include <vector>
+#include <algorithm>
 
 #include <wx/wxprec.h>
 #ifndef WX_PRECOMP
 #include <wx/wx.h>
 #endif  // WX_PRECOMP
-#include <wx/filename.h>       // used to create temp files for undo/redo
 
 #include "libgambit/libgambit.h"
 #include "libgambit/tinyxml.h"    // for XML parser for LoadDocument()
 
 #include "gambit.h"     // for wxGetApp()
 #include "gamedoc.h"
+#include "solverthread.h"
+#include "dominance.h"
 
 //=========================================================================
 //                       class gbtBehavDominanceStack
@@ -116,7 +119,7 @@ bool gbtBehavDominanceStack::PreviousLevel(void)
 
 gbtStrategyDominanceStack::gbtStrategyDominanceStack(gbtGameDocument *p_doc,
 						     bool p_strict)
-  : m_doc(p_doc), m_strict(p_strict), m_noFurther(false)
+  : m_doc(p_doc), m_strict(p_strict), m_noFurther(false), m_revision(0)
 {
   Reset();
 }
@@ -139,12 +142,14 @@ void gbtStrategyDominanceStack::Reset(void)
   m_supports.Append(new Gambit::StrategySupportProfile(m_doc->GetGame()));
   m_current = 1;
   m_noFurther = false;
+  m_revision++;
 }
 
 bool gbtStrategyDominanceStack::NextLevel(void)
 {
   if (m_current < m_supports.Length()) {
     m_current++;
+    m_revision++;
     return true;
   }
 
@@ -163,6 +168,7 @@ bool gbtStrategyDominanceStack::NextLevel(void)
   if (newSupport != *m_supports[m_current]) {
     m_supports.Append(new Gambit::StrategySupportProfile(newSupport));
     m_current++;
+    m_revision++;
     return true;
   }
   else {
@@ -175,6 +181,7 @@ bool gbtStrategyDominanceStack::PreviousLevel(void)
 {
   if (m_current > 1) {
     m_current--;
+    m_revision++;
     return true;
   }
   else {
@@ -182,6 +189,268 @@ bool gbtStrategyDominanceStack::PreviousLevel(void)
   }
 }
 
+//=========================================================================
+//                    Recorded edits for undo and redo
+//=========================================================================
+
+//
+// Edits refer to objects in the game by numbers which are the same after
+// the document is saved and read back: players and actions by number,
+// nodes by the sequence of actions leading to them from the root, and
+// information sets by their first member.
+//
+
+static std::vector<int> NodePath(GameNode p_node)
+{
+  std::vector<int> path;
+  for (; p_node->GetParent(); p_node = p_node->GetParent()) {
+    path.push_back(p_node->GetPriorAction()->GetNumber());
+  }
+  std::reverse(path.begin(), path.end());
+  return path;
+}
+
+static GameNode FindNode(const Game &p_game, const std::vector<int> &p_path)
+{
+  GameNode node = p_game->GetRoot();
+  for (size_t i = 0; i < p_path.size(); i++) {
+    node = node->GetChild(p_path[i]);
+  }
+  return node;
+}
+
+static GamePlayer FindPlayer(const Game &p_game, int p_player)
+{
+  return (p_player == 0) ? p_game->GetChance() : p_game->GetPlayer(p_player);
+}
+
+// Returns the first node in the subtree, in preorder, which has the outcome
+static GameNode FindOutcome(const GameNode &p_node, const GameOutcome &p_outcome)
+{
+  if (p_node->GetOutcome() == p_outcome) {
+    return p_node;
+  }
+  for (int i = 1; i <= p_node->NumChildren(); i++) {
+    GameNode node = FindOutcome(p_node->GetChild(i), p_outcome);
+    if (node) {
+      return node;
+    }
+  }
+  return 0;
+}
+
+class gbtGameEdit {
+public:
+  virtual ~gbtGameEdit() { }
+
+  /// The kind of modification the edit makes
+  virtual gbtGameModificationType GetModifications(void) const = 0;
+  /// The node the edit is confined to, if any
+  virtual GameNode GetNode(const Game &) const { return 0; }
+
+  virtual void Undo(Game, gbtStyle &) const = 0;
+  virtual void Redo(Game, gbtStyle &) const = 0;
+
+  /// Approximate memory used, in bytes
+  virtual size_t Size(void) const = 0;
+};
+
+//
+// An edit which replaces one text value in the game by another
+//
+class gbtValueEdit : public gbtGameEdit {
+protected:
+  std::string m_old, m_new;
+
+  virtual void Apply(Game, const std::string &) const = 0;
+
+public:
+  gbtValueEdit(const std::string &p_old, const std::string &p_new)
+    : m_old(p_old), m_new(p_new) { }
+
+  void Undo(Game p_game, gbtStyle &) const { Apply(p_game, m_old); }
+  void Redo(Game p_game, gbtStyle &) const { Apply(p_game, m_new); }
+  size_t Size(void) const 
+    { return sizeof(*this) + m_old.size() + m_new.size(); }
+};
+
+class gbtLabelEdit : public gbtValueEdit {
+public:
+  typedef enum {
+    LABEL_PLAYER, LABEL_STRATEGY, LABEL_INFOSET, LABEL_ACTION, LABEL_NODE
+  } gbtLabelTarget;
+
+private:
+  gbtLabelTarget m_target;
+  int m_player, m_number;
+  std::vector<int> m_path;
+
+  void Apply(Game, const std::string &) const;
+
+public:
+  gbtLabelEdit(GamePlayer p_player, const std::string &p_label)
+    : gbtValueEdit(p_player->GetLabel(), p_label), m_target(LABEL_PLAYER),
+      m_player((p_player->IsChance()) ? 0 : p_player->GetNumber()),
+      m_number(0) { }
+  gbtLabelEdit(GameStrategy p_strategy, const std::string &p_label)
+    : gbtValueEdit(p_strategy->GetLabel(), p_label), m_target(LABEL_STRATEGY),
+      m_player(p_strategy->GetPlayer()->GetNumber()),
+      m_number(p_strategy->GetNumber()) { }
+  // The information set must have at least one member
+  gbtLabelEdit(GameInfoset p_infoset, const std::string &p_label)
+    : gbtValueEdit(p_infoset->GetLabel(), p_label), m_target(LABEL_INFOSET),
+      m_player(0), m_number(0), m_path(NodePath(p_infoset->GetMember(1))) { }
+  gbtLabelEdit(GameAction p_action, const std::string &p_label)
+    : gbtValueEdit(p_action->GetLabel(), p_label), m_target(LABEL_ACTION),
+      m_player(0), m_number(p_action->GetNumber()),
+      m_path(NodePath(p_action->GetInfoset()->GetMember(1))) { }
+  gbtLabelEdit(GameNode p_node, const std::string &p_label)
+    : gbtValueEdit(p_node->GetLabel(), p_label), m_target(LABEL_NODE),
+      m_player(0), m_number(0), m_path(NodePath(p_node)) { }
+
+  gbtGameModificationType GetModifications(void) const
+    { return GBT_DOC_MODIFIED_LABELS; }
+  GameNode GetNode(const Game &p_game) const
+    { return (m_target == LABEL_NODE) ? FindNode(p_game, m_path) : 0; }
+  size_t Size(void) const
+    { return gbtValueEdit::Size() + m_path.size() * sizeof(int); }
+};
+
+void gbtLabelEdit::Apply(Game p_game, const std::string &p_label) const
+{
+  switch (m_target) {
+  case LABEL_PLAYER:
+    FindPlayer(p_game, m_player)->SetLabel(p_label);
+    break;
+  case LABEL_STRATEGY:
+    p_game->GetPlayer(m_player)->GetStrategy(m_number)->SetLabel(p_label);
+    break;
+  case LABEL_INFOSET:
+    FindNode(p_game, m_path)->GetInfoset()->SetLabel(p_label);
+    break;
+  case LABEL_ACTION:
+    FindNode(p_game, m_path)->GetInfoset()->GetAction(m_number)->SetLabel(p_label);
+    break;
+  case LABEL_NODE:
+    FindNode(p_game, m_path)->SetLabel(p_label);
+    break;
+  }
+}
+
+class gbtTitleEdit : public gbtGameEdit {
+private:
+  std::string m_oldTitle, m_oldComment, m_newTitle, m_newComment;
+
+public:
+  gbtTitleEdit(Game p_game,
+	       const std::string &p_title, const std::string &p_comment)
+    : m_oldTitle(p_game->GetTitle()), m_oldComment(p_game->GetComment()),
+      m_newTitle(p_title), m_newComment(p_comment) { }
+
+  gbtGameModificationType GetModifications(void) const
+    { return GBT_DOC_MODIFIED_LABELS; }
+  void Undo(Game p_game, gbtStyle &) const
+    { p_game->SetTitle(m_oldTitle);  p_game->SetComment(m_oldComment); }
+  void Redo(Game p_game, gbtStyle &) const
+    { p_game->SetTitle(m_newTitle);  p_game->SetComment(m_newComment); }
+  size_t Size(void) const
+    { return (sizeof(*this) + m_oldTitle.size() + m_oldComment.size() +
+	      m_newTitle.size() + m_newComment.size()); }
+};
+
+//
+// A change to a payoff.  In a tree the outcome is found through the
+// first node which has it, since outcomes not attached to any node are
+// not saved, and so outcome numbers may change when a saved state is
+// read back.
+//
+class gbtPayoffEdit : public gbtValueEdit {
+private:
+  int m_outcome, m_player;
+  std::vector<int> m_path;
+
+  void Apply(Game, const std::string &) const;
+
+public:
+  gbtPayoffEdit(GameOutcome p_outcome, int p_player, GameNode p_node,
+		const std::string &p_value)
+    : gbtValueEdit(p_outcome->GetPayoff<std::string>(p_player), p_value),
+      m_outcome(p_outcome->GetNumber()), m_player(p_player)
+  { if (p_node)  m_path = NodePath(p_node); }
+
+  gbtGameModificationType GetModifications(void) const
+    { return GBT_DOC_MODIFIED_PAYOFFS; }
+  size_t Size(void) const
+    { return gbtValueEdit::Size() + m_path.size() * sizeof(int); }
+};
+
+void gbtPayoffEdit::Apply(Game p_game, const std::string &p_value) const
+{
+  GameOutcome outcome = ((p_game->IsTree()) ? 
+			 FindNode(p_game, m_path)->GetOutcome() :
+			 p_game->GetOutcome(m_outcome));
+  outcome->SetPayoff(m_player, p_value);
+}
+
+class gbtActionProbEdit : public gbtValueEdit {
+private:
+  int m_action;
+  std::vector<int> m_path;
+
+  void Apply(Game p_game, const std::string &p_value) const
+    { FindNode(p_game, m_path)->GetInfoset()->SetActionProb(m_action, p_value); }
+
+public:
+  gbtActionProbEdit(GameInfoset p_infoset, int p_action,
+		    const std::string &p_value)
+    : gbtValueEdit(p_infoset->GetActionProb(p_action, ""), p_value),
+      m_action(p_action), m_path(NodePath(p_infoset->GetMember(1))) { }
+
+  gbtGameModificationType GetModifications(void) const
+    { return GBT_DOC_MODIFIED_PAYOFFS; }
+  size_t Size(void) const
+    { return gbtValueEdit::Size() + m_path.size() * sizeof(int); }
+};
+
+class gbtStyleEdit : public gbtGameEdit {
+private:
+  gbtStyle m_old, m_new;
+
+public:
+  gbtStyleEdit(const gbtStyle &p_old, const gbtStyle &p_new)
+    : m_old(p_old), m_new(p_new) { }
+
+  gbtGameModificationType GetModifications(void) const
+    { return GBT_DOC_MODIFIED_VIEWS; }
+  void Undo(Game, gbtStyle &p_style) const { p_style = m_old; }
+  void Redo(Game, gbtStyle &p_style) const { p_style = m_new; }
+  size_t Size(void) const { return sizeof(*this); }
+};
+
+//
+// A step in the undo history.  Changes to labels, payoffs and the style
+// are kept as an edit, which is undone or redone in place.  Other changes
+// keep the saved document as it was after the change; so does every
+// c_snapshotInterval'th edit in a row, so that going back to an earlier
+// state never replays more than that many edits.
+//
+class gbtUndoStep {
+public:
+  gbtGameEdit *m_edit;
+  std::string m_snapshot;
+
+  gbtUndoStep(gbtGameEdit *p_edit) : m_edit(p_edit) { }
+  ~gbtUndoStep() { delete m_edit; }
+
+  size_t Size(void) const
+    { return (sizeof(*this) + m_snapshot.size() + 
+	      ((m_edit) ? m_edit->Size() : 0)); }
+};
+
+static const int c_snapshotInterval = 50;
+// Older steps are dropped once the history uses more memory than this
+static const size_t c_historyBudget = 64 * 1024 * 1024;
+
 //=========================================================================
 //                          class gbtGameDocument
 //=========================================================================
@@ -190,18 +459,20 @@ gbtGameDocument::gbtGameDocument(Gambit::Game p_game)
   : m_game(p_game),
     m_selectNode(0), m_modified(false),
     m_behavSupports(this, true), m_stratSupports(this, true),
-    m_currentProfileList(0)
+    m_dominance(new gbtDominanceMap(this)),
+    m_currentProfileList(0),
+    m_historyPos(0), m_historySize(0),
+    m_lastModifications(GBT_DOC_MODIFIED_GAME), m_modifiedSubtree(0)
 {
   wxGetApp().AddDocument(this);
-
-  std::ostringstream s;
-  SaveDocument(s);
-  m_undoList.Append(s.str());
+  RecordUndo(0);
 }
 
 gbtGameDocument::~gbtGameDocument()
 {
   wxGetApp().RemoveDocument(this);
+  delete m_dominance;
+  for (int i = 1; i <= m_history.Length(); delete m_history[i++]);
 }
 
 bool gbtGameDocument::LoadDocument(const wxString &p_filename,
@@ -213,11 +484,24 @@ bool gbtGameDocument::LoadDocument(const wxString &p_filename,
     return false;
   }
 
-  TiXmlNode *docroot = doc.FirstChild("gambit:document");
+  if (!LoadDocument(doc)) {
+    return false;
+  }
+
+  if (p_saveUndo) {
+    RecordUndo(0);
+  }
+
+  return true;
+}
+
+bool gbtGameDocument::LoadDocument(TiXmlDocument &p_doc)
+{
+  TiXmlNode *docroot = p_doc.FirstChild("gambit:document");
 
   if (!docroot) {
     // This is an "old-style" file that didn't have a proper root.
-    docroot = &doc;
+    docroot = &p_doc;
   }
 
   TiXmlNode *game = docroot->FirstChild("game");
@@ -307,12 +591,6 @@ bool gbtGameDocument::LoadDocument(const wxString &p_filename,
     m_style.SetNumDecimals(numDecimals);
   }
 
-  if (p_saveUndo) {
-    std::ostringstream s;
-    SaveDocument(s);
-    m_undoList.Append(s.str());
-  }
-
   return true;
 }
 
@@ -355,17 +633,28 @@ void gbtGameDocument::SaveDocument(std::ostream &p_file) const
   p_file << "</gambit:document>\n";
 }
 
-void gbtGameDocument::UpdateViews(gbtGameModificationType p_modifications)
+void gbtGameDocument::UpdateViews(gbtGameModificationType p_modifications,
+				  Gambit::GameNode p_subtree,
+				  gbtGameEdit *p_edit)
 {
   if (p_modifications != GBT_DOC_MODIFIED_NONE) {
     m_modified = true;
-    m_redoList = Gambit::List<std::string>();
-
-    std::ostringstream s;
-    SaveDocument(s);
-    m_undoList.Append(s.str());
+    // Changes to how the document is viewed other than its style
+    // (selection, current profile, supports shown) are not undone
+    if (p_edit || p_modifications != GBT_DOC_MODIFIED_VIEWS) {
+      RecordUndo(p_edit);
+    }
   }
 
+  NotifyViews(p_modifications, p_subtree);
+}
+
+void gbtGameDocument::NotifyViews(gbtGameModificationType p_modifications,
+				  Gambit::GameNode p_subtree)
+{
+  m_lastModifications = p_modifications;
+  m_modifiedSubtree = p_subtree;
+
   if (p_modifications == GBT_DOC_MODIFIED_GAME ||
       p_modifications == GBT_DOC_MODIFIED_PAYOFFS) {
     m_behavSupports.Reset();
@@ -399,46 +688,78 @@ void gbtGameDocument::BuildNfg(void)
 
 void gbtGameDocument::SetStyle(const gbtStyle &p_style)
 {
+  gbtGameEdit *edit = new gbtStyleEdit(m_style, p_style);
   m_style = p_style;
-  UpdateViews(GBT_DOC_MODIFIED_VIEWS);
+  UpdateViews(GBT_DOC_MODIFIED_VIEWS, 0, edit);
 }
 
 //
 // A word about the undo and redo features:
-// We store a list of the textual representation of games.  We don't
-// store other aspects of the state (e.g., profiles) as yet.
-// The "undo" list includes the representation of the current state
-// of the game (hence, CanUndo() only returns true when the list has
-// more than one element.
+// Each modification adds a step to the history (see gbtUndoStep).
+// The first step always has a snapshot of the document, and is where
+// undoing stops.  A step which is not an edit is undone by going back
+// to the most recent snapshot before it and replaying the edits since.
+// We don't store other aspects of the state (e.g., profiles) except in
+// snapshots.
 //
-void gbtGameDocument::Undo(void)
+void gbtGameDocument::RecordUndo(gbtGameEdit *p_edit)
 {
-  // The current game is at the end of the undo list; move it to the redo list
-  m_redoList.Append(m_undoList[m_undoList.Length()]);
-  m_undoList.Remove(m_undoList.Length());
+  // A new change discards whatever could have been redone
+  while (m_history.Length() > m_historyPos) {
+    gbtUndoStep *step = m_history.Remove(m_history.Length());
+    m_historySize -= step->Size();
+    delete step;
+  }
 
-  m_game = 0;
+  int edits = 0;
+  for (int i = m_historyPos; i >= 1 && m_history[i]->m_snapshot.empty(); i--) {
+    edits++;
+  }
 
-  while (m_profiles.Length() > 0) {
-    delete m_profiles.Remove(1);
+  gbtUndoStep *step = new gbtUndoStep(p_edit);
+  if (!p_edit || edits + 1 >= c_snapshotInterval) {
+    std::ostringstream s;
+    SaveDocument(s);
+    step->m_snapshot = s.str();
   }
-  m_currentProfileList = 0;
+  m_history.Append(step);
+  m_historyPos = m_history.Length();
+  m_historySize += step->Size();
 
-  wxString tempfile = wxFileName::CreateTempFileName(wxT("gambit"));
-  std::ofstream f((const char *) tempfile.mb_str());
-  f << m_undoList[m_undoList.Length()] << std::endl;
-  f.close();
+  TrimHistory();
+}
 
-  LoadDocument(tempfile, false);
-  wxRemoveFile(tempfile);
+//
+// Drops the oldest steps while the history is over its memory budget.
+// The oldest step kept must have a snapshot, so steps are dropped up to
+// the next one which does.
+//
+void gbtGameDocument::TrimHistory(void)
+{
+  while (m_historySize > c_historyBudget) {
+    int next = 2;
+    while (next <= m_historyPos && m_history[next]->m_snapshot.empty()) {
+      next++;
+    }
+    if (next > m_historyPos) {
+      return;
+    }
 
-  for (int i = 1; i <= m_views.Length(); m_views[i++]->OnUpdate());
+    for (int i = 1; i < next; i++) {
+      gbtUndoStep *step = m_history.Remove(1);
+      m_historySize -= step->Size();
+      delete step;
+    }
+    m_historyPos -= next - 1;
+  }
 }
 
-void gbtGameDocument::Redo(void)
+void gbtGameDocument::RestoreState(int p_pos)
 {
-  m_undoList.Append(m_redoList[m_redoList.Length()]);
-  m_redoList.Remove(m_redoList.Length());
+  int base = p_pos;
+  while (m_history[base]->m_snapshot.empty()) {
+    base--;
+  }
 
   m_game = 0;
 
@@ -447,14 +768,48 @@ void gbtGameDocument::Redo(void)
   }
   m_currentProfileList = 0;
 
-  wxString tempfile = wxFileName::CreateTempFileName(wxT("gambit"));
-  std::ofstream f((const char *) tempfile.mb_str());
-  f << m_undoList[m_undoList.Length()] << std::endl;
-  f.close();
+  TiXmlDocument doc;
+  doc.Parse(m_history[base]->m_snapshot.c_str());
+  LoadDocument(doc);
+
+  for (int i = base + 1; i <= p_pos; i++) {
+    m_history[i]->m_edit->Redo(m_game, m_style);
+  }
+}
+
+void gbtGameDocument::Undo(void)
+{
+  gbtUndoStep *step = m_history[m_historyPos--];
+
+  if (step->m_edit) {
+    step->m_edit->Undo(m_game, m_style);
+    NotifyViews(step->m_edit->GetModifications(), 
+		step->m_edit->GetNode(m_game));
+    return;
+  }
+
+  RestoreState(m_historyPos);
+
+  m_lastModifications = GBT_DOC_MODIFIED_GAME;
+  m_modifiedSubtree = 0;
+  for (int i = 1; i <= m_views.Length(); m_views[i++]->OnUpdate());
+}
 
-  LoadDocument(tempfile, false);
-  wxRemoveFile(tempfile);
+void gbtGameDocument::Redo(void)
+{
+  gbtUndoStep *step = m_history[++m_historyPos];
 
+  if (step->m_edit) {
+    step->m_edit->Redo(m_game, m_style);
+    NotifyViews(step->m_edit->GetModifications(), 
+		step->m_edit->GetNode(m_game));
+    return;
+  }
+
+  RestoreState(m_historyPos);
+
+  m_lastModifications = GBT_DOC_MODIFIED_GAME;
+  m_modifiedSubtree = 0;
   for (int i = 1; i <= m_views.Length(); m_views[i++]->OnUpdate());
 }
 
@@ -590,6 +945,12 @@ int gbtGameDocument::GetStrategyElimLevel(void) const
   return m_stratSupports.GetLevel();
 }
 
+gbtDominanceStatus
+gbtGameDocument::GetStrategyDominance(const GameStrategy &p_strategy)
+{
+  return m_dominance->GetStatus(p_strategy);
+}
+
 
 void gbtGameDocument::SetSelectNode(Gambit::GameNode p_node)
 {
@@ -629,9 +990,12 @@ void gbtGameDocument::DoExportNfg(const wxString &p_filename)
 void gbtGameDocument::DoSetTitle(const wxString &p_title, 
 				 const wxString &p_comment)
 {
-  m_game->SetTitle(static_cast<const char *>(p_title.mb_str()));
-  m_game->SetComment(static_cast<const char *>(p_comment.mb_str()));
-  UpdateViews(GBT_DOC_MODIFIED_LABELS);
+  std::string title(static_cast<const char *>(p_title.mb_str()));
+  std::string comment(static_cast<const char *>(p_comment.mb_str()));
+  gbtGameEdit *edit = new gbtTitleEdit(m_game, title, comment);
+  m_game->SetTitle(title);
+  m_game->SetComment(comment);
+  UpdateViews(GBT_DOC_MODIFIED_LABELS, 0, edit);
 }
 
 void gbtGameDocument::DoNewPlayer(void)
@@ -648,8 +1012,10 @@ void gbtGameDocument::DoNewPlayer(void)
 void gbtGameDocument::DoSetPlayerLabel(GamePlayer p_player,
 				       const wxString &p_label)
 {
-  p_player->SetLabel(static_cast<const char *>(p_label.mb_str()));
-  UpdateViews(GBT_DOC_MODIFIED_LABELS);
+  std::string label(static_cast<const char *>(p_label.mb_str()));
+  gbtGameEdit *edit = new gbtLabelEdit(p_player, label);
+  p_player->SetLabel(label);
+  UpdateViews(GBT_DOC_MODIFIED_LABELS, 0, edit);
 }
 
 void gbtGameDocument::DoNewStrategy(GamePlayer p_player)
@@ -668,42 +1034,56 @@ void gbtGameDocument::DoDeleteStrategy(GameStrategy p_strategy)
 void gbtGameDocument::DoSetStrategyLabel(GameStrategy p_strategy,
 					 const wxString &p_label)
 {
-  p_strategy->SetLabel(static_cast<const char *>(p_label.mb_str()));
-  UpdateViews(GBT_DOC_MODIFIED_LABELS);
+  std::string label(static_cast<const char *>(p_label.mb_str()));
+  // Strategies of a tree are computed from it, and are not kept when
+  // a snapshot is read back; so a snapshot is taken instead
+  gbtGameEdit *edit = ((m_game->IsTree()) ? 0 :
+		       new gbtLabelEdit(p_strategy, label));
+  p_strategy->SetLabel(label);
+  UpdateViews(GBT_DOC_MODIFIED_LABELS, 0, edit);
 }
 
 void gbtGameDocument::DoSetInfosetLabel(GameInfoset p_infoset,
 					const wxString &p_label)
 {
-  p_infoset->SetLabel(static_cast<const char *>(p_label.mb_str()));
-  UpdateViews(GBT_DOC_MODIFIED_LABELS);
+  std::string label(static_cast<const char *>(p_label.mb_str()));
+  gbtGameEdit *edit = ((p_infoset->NumMembers() > 0) ?
+		       new gbtLabelEdit(p_infoset, label) : 0);
+  p_infoset->SetLabel(label);
+  UpdateViews(GBT_DOC_MODIFIED_LABELS, 0, edit);
 }
 
 void gbtGameDocument::DoSetActionLabel(GameAction p_action,
 				       const wxString &p_label)
 {
-  p_action->SetLabel(static_cast<const char *>(p_label.mb_str()));
-  UpdateViews(GBT_DOC_MODIFIED_LABELS);
+  std::string label(static_cast<const char *>(p_label.mb_str()));
+  gbtGameEdit *edit = ((p_action->GetInfoset()->NumMembers() > 0) ?
+		       new gbtLabelEdit(p_action, label) : 0);
+  p_action->SetLabel(label);
+  UpdateViews(GBT_DOC_MODIFIED_LABELS, 0, edit);
 }
 
 void gbtGameDocument::DoSetActionProb(GameInfoset p_infoset,
 				      unsigned int p_action,
 				      const wxString &p_prob)
 {
-  p_infoset->SetActionProb(p_action, static_cast<const char *>(p_prob.mb_str()));
-  UpdateViews(GBT_DOC_MODIFIED_PAYOFFS);
+  std::string prob(static_cast<const char *>(p_prob.mb_str()));
+  gbtGameEdit *edit = ((p_infoset->NumMembers() > 0) ?
+		       new gbtActionProbEdit(p_infoset, p_action, prob) : 0);
+  p_infoset->SetActionProb(p_action, prob);
+  UpdateViews(GBT_DOC_MODIFIED_PAYOFFS, 0, edit);
 }
 
 void gbtGameDocument::DoSetInfoset(GameNode p_node, GameInfoset p_infoset)
 {
   p_node->SetInfoset(p_infoset);
-  UpdateViews(GBT_DOC_MODIFIED_GAME);
+  UpdateViews(GBT_DOC_MODIFIED_GAME, p_node);
 }
 
 void gbtGameDocument::DoLeaveInfoset(GameNode p_node)
 {
   p_node->LeaveInfoset();
-  UpdateViews(GBT_DOC_MODIFIED_GAME);
+  UpdateViews(GBT_DOC_MODIFIED_GAME, p_node);
 }
 
 void gbtGameDocument::DoRevealAction(GameInfoset p_infoset, GamePlayer p_player)
@@ -722,15 +1102,17 @@ void gbtGameDocument::DoInsertAction(GameNode p_node)
 
 void gbtGameDocument::DoSetNodeLabel(GameNode p_node, const wxString &p_label)
 {
-  p_node->SetLabel(static_cast<const char *>(p_label.mb_str()));
-  UpdateViews(GBT_DOC_MODIFIED_LABELS);
+  std::string label(static_cast<const char *>(p_label.mb_str()));
+  gbtGameEdit *edit = new gbtLabelEdit(p_node, label);
+  p_node->SetLabel(label);
+  UpdateViews(GBT_DOC_MODIFIED_LABELS, p_node, edit);
 }
 
 
 void gbtGameDocument::DoAppendMove(GameNode p_node, GameInfoset p_infoset)
 {
   p_node->AppendMove(p_infoset);
-  UpdateViews(GBT_DOC_MODIFIED_GAME);
+  UpdateViews(GBT_DOC_MODIFIED_GAME, p_node);
 }
 
 void gbtGameDocument::DoInsertMove(GameNode p_node, GamePlayer p_player,
@@ -740,19 +1122,19 @@ void gbtGameDocument::DoInsertMove(GameNode p_node, GamePlayer p_player,
   for (int act = 1; act <= infoset->NumActions(); act++) {
     infoset->GetAction(act)->SetLabel(lexical_cast<std::string>(act));
   }
-  UpdateViews(GBT_DOC_MODIFIED_GAME);
+  UpdateViews(GBT_DOC_MODIFIED_GAME, p_node);
 }
 
 void gbtGameDocument::DoInsertMove(GameNode p_node, GameInfoset p_infoset)
 {
   p_node->InsertMove(p_infoset);
-  UpdateViews(GBT_DOC_MODIFIED_GAME);
+  UpdateViews(GBT_DOC_MODIFIED_GAME, p_node);
 }
 
 void gbtGameDocument::DoCopyTree(GameNode p_destNode, GameNode p_srcNode)
 {
   p_destNode->CopyTree(p_srcNode);
-  UpdateViews(GBT_DOC_MODIFIED_GAME);
+  UpdateViews(GBT_DOC_MODIFIED_GAME, p_destNode);
 }
 
 void gbtGameDocument::DoMoveTree(GameNode p_destNode, GameNode p_srcNode)
@@ -765,13 +1147,13 @@ void gbtGameDocument::DoDeleteParent(GameNode p_node)
 {
   if (!p_node || !p_node->GetParent()) return;
   p_node->DeleteParent();
-  UpdateViews(GBT_DOC_MODIFIED_GAME);
+  UpdateViews(GBT_DOC_MODIFIED_GAME, p_node);
 }
 
 void gbtGameDocument::DoDeleteTree(GameNode p_node)
 {
   p_node->DeleteTree();
-  UpdateViews(GBT_DOC_MODIFIED_GAME);
+  UpdateViews(GBT_DOC_MODIFIED_GAME, p_node);
 }
 
 void gbtGameDocument::DoSetPlayer(GameInfoset p_infoset, GamePlayer p_player)
@@ -795,7 +1177,7 @@ void gbtGameDocument::DoSetPlayer(GameNode p_node, GamePlayer p_player)
 void gbtGameDocument::DoNewOutcome(GameNode p_node)
 {
   p_node->SetOutcome(m_game->NewOutcome());
-  UpdateViews(GBT_DOC_MODIFIED_PAYOFFS);
+  UpdateViews(GBT_DOC_MODIFIED_PAYOFFS, p_node);
 }
 
 void gbtGameDocument::DoNewOutcome(const PureStrategyProfile &p_profile)
@@ -807,14 +1189,14 @@ void gbtGameDocument::DoNewOutcome(const PureStrategyProfile &p_profile)
 void gbtGameDocument::DoSetOutcome(GameNode p_node, GameOutcome p_outcome)
 {
   p_node->SetOutcome(p_outcome);
-  UpdateViews(GBT_DOC_MODIFIED_PAYOFFS);
+  UpdateViews(GBT_DOC_MODIFIED_PAYOFFS, p_node);
 }
 
 void gbtGameDocument::DoRemoveOutcome(GameNode p_node)
 {
   if (!p_node || !p_node->GetOutcome()) return;
   p_node->SetOutcome(0);
-  UpdateViews(GBT_DOC_MODIFIED_PAYOFFS);
+  UpdateViews(GBT_DOC_MODIFIED_PAYOFFS, p_node);
 }
 
 void gbtGameDocument::DoCopyOutcome(GameNode p_node, GameOutcome p_outcome)
@@ -825,15 +1207,27 @@ void gbtGameDocument::DoCopyOutcome(GameNode p_node, GameOutcome p_outcome)
     outcome->SetPayoff(pl, p_outcome->GetPayoff<std::string>(pl));
   }
   p_node->SetOutcome(outcome);
-  UpdateViews(GBT_DOC_MODIFIED_PAYOFFS);
+  UpdateViews(GBT_DOC_MODIFIED_PAYOFFS, p_node);
 }
 
 void gbtGameDocument::DoSetPayoff(GameOutcome p_outcome, int p_player,
 				  const wxString &p_value)
 {
-  p_outcome->SetPayoff(p_player, 
-		       static_cast<const char *>(p_value.mb_str()));
-  UpdateViews(GBT_DOC_MODIFIED_PAYOFFS);
+  std::string value(static_cast<const char *>(p_value.mb_str()));
+  gbtGameEdit *edit = 0;
+  if (!m_game->IsTree()) {
+    edit = new gbtPayoffEdit(p_outcome, p_player, 0, value);
+  }
+  else {
+    // An outcome at no node cannot be found again once the document
+    // is saved and read back; a snapshot is taken for those
+    GameNode node = FindOutcome(m_game->GetRoot(), p_outcome);
+    if (node) {
+      edit = new gbtPayoffEdit(p_outcome, p_player, node, value);
+    }
+  }
+  p_outcome->SetPayoff(p_player, value);
+  UpdateViews(GBT_DOC_MODIFIED_PAYOFFS, 0, edit);
 }
 
 void gbtGameDocument::DoAddOutput(gbtAnalysisOutput &p_list,
@@ -842,3 +1236,10 @@ void gbtGameDocument::DoAddOutput(gbtAnalysisOutput &p_list,
   p_list.AddOutput(p_output);
   UpdateViews(GBT_DOC_MODIFIED_NONE);
 }
+
+void gbtGameDocument::DoCollectOutput(gbtSolverRunner &p_runner)
+{
+  if (p_runner.Collect() > 0) {
+    UpdateViews(GBT_DOC_MODIFIED_NONE);
+  }
+}
@@ -33,6 +33,11 @@ using namespace Gambit;
 
 class gbtGameView;
 class gbtGameDocument;
+class gbtGameEdit;
+class gbtUndoStep;
+class gbtSolverRunner;
+class gbtDominanceMap;
+class TiXmlDocument;
 
 //!
 //! This class manages the "stack" of supports obtained by eliminating
@@ -117,6 +122,7 @@ private:
   Gambit::Array<Gambit::StrategySupportProfile *> m_supports;
   int m_current;
   bool m_noFurther;
+  unsigned long m_revision;
 
 public:
   gbtStrategyDominanceStack(gbtGameDocument *p_doc, bool p_strict);
@@ -143,6 +149,11 @@ public:
   //!
   int GetLevel(void) const { return m_current; }
 
+  //!
+  //! Returns a number which changes whenever the current support does
+  //!
+  unsigned long GetRevision(void) const { return m_revision; }
+
   //!
   //! Sets whether elimination is strict or weak.  If this changes the
   //! internal setting, a Reset() is done
@@ -174,7 +185,7 @@ public:
   //!
   //! Go to the top level (the full support)
   //!
-  void TopLevel(void) { m_current = 1; }
+  void TopLevel(void) { m_current = 1;  m_revision++; }
 
   //!
   //! Returns 'false' if it is known that no further eliminations can be done
@@ -184,6 +195,16 @@ public:
 	      
 };
 
+//
+// The dominance status of a strategy in the current strategy support,
+// as shown in the strategic game table.
+//
+typedef enum {
+  GBT_DOMINANCE_NONE = 0,
+  GBT_DOMINANCE_WEAK = 1,
+  GBT_DOMINANCE_STRICT = 2
+} gbtDominanceStatus;
+
 
 //
 // These are passed to gbtGameDocument::UpdateViews() to indicate which
@@ -215,6 +236,7 @@ typedef enum {
 
 class gbtGameDocument {
 friend class gbtGameView;
+friend class gbtDominanceMap;
 private:
   Gambit::Array<gbtGameView *> m_views;
 
@@ -234,14 +256,38 @@ private:
 
   gbtBehavDominanceStack m_behavSupports;
   gbtStrategyDominanceStack m_stratSupports;
+  gbtDominanceMap *m_dominance;
 
   Gambit::List<gbtAnalysisOutput *> m_profiles;
   int m_currentProfileList;
 
-  Gambit::List<std::string> m_undoList, m_redoList;
-
-
-  void UpdateViews(gbtGameModificationType p_modifications);
+  // The undo history.  Step m_historyPos is the current state; the
+  // steps after it are those which can be redone.  m_historySize is the
+  // approximate memory used by all steps, in bytes.
+  Gambit::List<gbtUndoStep *> m_history;
+  int m_historyPos;
+  size_t m_historySize;
+
+  // What was reported to the views by the most recent update
+  gbtGameModificationType m_lastModifications;
+  Gambit::GameNode m_modifiedSubtree;
+
+  /// Notify the views of a change.  If the change is confined to the
+  /// subtree rooted at p_subtree (or to the node itself, for outcomes
+  /// and labels), passing it lets views redo only that part.
+  /// If p_edit is given, it records the change so that it can be
+  /// undone in place; the document takes ownership of it.
+  void UpdateViews(gbtGameModificationType p_modifications,
+		   Gambit::GameNode p_subtree = 0,
+		   gbtGameEdit *p_edit = 0);
+  void NotifyViews(gbtGameModificationType p_modifications,
+		   Gambit::GameNode p_subtree);
+
+  void RecordUndo(gbtGameEdit *p_edit);
+  void TrimHistory(void);
+  void RestoreState(int p_pos);
+
+  bool LoadDocument(TiXmlDocument &);
 
 public:
   gbtGameDocument(Gambit::Game p_game);
@@ -266,6 +312,13 @@ public:
   bool IsModified(void) const { return m_modified; }
   void SetModified(bool p_modified) { m_modified = p_modified; }
 
+  /// The type of the modification the views were last told about
+  gbtGameModificationType GetLastModifications(void) const
+    { return m_lastModifications; }
+  /// The node the last modification was confined to, if any
+  Gambit::GameNode GetModifiedSubtree(void) const
+    { return m_modifiedSubtree; }
+
   const gbtStyle &GetStyle(void) const { return m_style; }
   void SetStyle(const gbtStyle &p_style);
 
@@ -278,10 +331,10 @@ public:
   //! @name Handling of undo/redo features
   //!
   //@{
-  bool CanUndo(void) const { return (m_undoList.Length() > 1); }
+  bool CanUndo(void) const { return (m_historyPos > 1); }
   void Undo(void);
 
-  bool CanRedo(void) const { return (m_redoList.Length() > 0); }
+  bool CanRedo(void) const { return (m_historyPos < m_history.Length()); }
   void Redo(void);
   //@}
 
@@ -336,6 +389,10 @@ public:
   void TopStrategyElimLevel(void);
   bool CanStrategyElim(void) const;
   int GetStrategyElimLevel(void) const;
+  /// Whether the strategy is dominated in the current support.  This is
+  /// looked up in a map computed once for each support; see
+  /// gbtDominanceMap.
+  gbtDominanceStatus GetStrategyDominance(const GameStrategy &p_strategy);
   //@}
 
   Gambit::GameNode GetSelectNode(void) const { return m_selectNode; }
@@ -381,6 +438,7 @@ public:
 		   const wxString &p_value);
 
   void DoAddOutput(gbtAnalysisOutput &p_list, const wxString &p_output);
+  void DoCollectOutput(gbtSolverRunner &p_runner);
 };
 
 class gbtGameView {
@@ -1320,9 +1320,11 @@ void gbtGameFrame::OnViewStrategic(wxCommandEvent &p_event)
       return;
     }
     
-    int ncont = m_doc->GetGame()->NumStrategyContingencies();
+    Gambit::ContingencyIndex ncont = m_doc->GetGame()->NumStrategyContingencies();
     if (!m_nfgPanel && ncont >= 50000) {
-      if (wxMessageBox(wxString::Format(wxT("This game has %d contingencies in strategic form.\n"), ncont) +
+      if (wxMessageBox(wxT("This game has ") +
+		       wxString(Gambit::lexical_cast<std::string>(ncont).c_str(), *wxConvCurrent) +
+		       wxT(" contingencies in strategic form.\n") +
 		       wxT("Performance in browsing strategic form will be poor,\n") +
 		       wxT("and may render the program nonresponsive.\n") +
 		       wxT("Do you wish to continue?"),
@@ -1451,9 +1453,11 @@ void gbtGameFrame::OnToolsEquilibrium(wxCommandEvent &)
 
   if (dialog.ShowModal() == wxID_OK) {
     if (dialog.UseStrategic()) {
-      int ncont = m_doc->GetGame()->NumStrategyContingencies();
+      Gambit::ContingencyIndex ncont = m_doc->GetGame()->NumStrategyContingencies();
       if (ncont >= 50000) {
-	if (wxMessageBox(wxString::Format(wxT("This game has %d contingencies in strategic form.\n"), ncont) +
+	if (wxMessageBox(wxT("This game has ") +
+			 wxString(Gambit::lexical_cast<std::string>(ncont).c_str(), *wxConvCurrent) +
+			 wxT(" contingencies in strategic form.\n") +
 			 wxT("Performance in solving strategic form will be poor,\n") +
 			 wxT("and may render the program nonresponsive.\n") +
 			 wxT("Do you wish to continue?"),
@@ -20,6 +20,8 @@
 // Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
 //
 
+#include <vector>
+
 #include <wx/wxprec.h>
 #ifndef WX_PRECOMP
 #include <wx/wx.h>
@@ -37,10 +39,56 @@
 #include "renratio.h"    // special renderer for rational numbers
 
 #include "gamedoc.h"
+#include "libgambit/gametable.h"  // for direct access to payoff tables
 #include "nfgpanel.h"
 #include "nfgtable.h"
 #include "dlexcept.h"
 
+//=========================================================================
+//                          class gbtSheetTable
+//=========================================================================
+
+//!
+//! The sheets used in the strategic game display compute the contents
+//! of their cells as they are drawn.  This keeps track of the number
+//! of rows and columns, without storing anything for each cell.
+//!
+class gbtSheetValues : public wxSheetValueProviderBase {
+public:
+  gbtSheetValues(int p_numRows, int p_numCols)
+    : wxSheetValueProviderBase(p_numRows, p_numCols) { }
+  virtual ~gbtSheetValues() { }
+
+  wxString GetValue(const wxSheetCoords &) const { return wxEmptyString; }
+  void SetValue(const wxSheetCoords &, const wxString &) { }
+  bool UpdateRows(size_t, int p_numRows)
+  { m_numRows += p_numRows;  return true; }
+  bool UpdateCols(size_t, int p_numCols)
+  { m_numCols += p_numCols;  return true; }
+};
+
+//!
+//! A table with no storage for each cell.  Spanned cells are not kept
+//! as a list of blocks either, which costs time for each block on every
+//! change; sheets with spanned cells compute them in GetCellBlock().
+//!
+class gbtSheetTable : public wxSheetTable {
+public:
+  gbtSheetTable(wxSheet *p_sheet, int p_numRows, int p_numCols);
+  virtual ~gbtSheetTable() { }
+
+  wxSheetSelection *GetSpannedBlocks(void) const { return 0; }
+};
+
+gbtSheetTable::gbtSheetTable(wxSheet *p_sheet, int p_numRows, int p_numCols)
+  : wxSheetTable(p_sheet)
+{
+  SetGridCellValueProvider(new gbtSheetValues(p_numRows, p_numCols), true);
+  SetRowLabelValueProvider(new gbtSheetValues(p_numRows, 1), true);
+  SetColLabelValueProvider(new gbtSheetValues(1, p_numCols), true);
+  SetAttrProvider(new wxSheetCellAttrProvider, true);
+}
+
 //=========================================================================
 //                       class gbtTableWidgetBase
 //=========================================================================
@@ -83,6 +131,10 @@ protected:
   /// Overriding wxSheet member to show editor on one click
   void OnCellLeftClick(wxSheetEvent &);
 
+  /// Creates the grid, in place of wxSheet::CreateGrid()
+  void CreateSheet(int p_numRows, int p_numCols)
+  { SetTable(new gbtSheetTable(this, p_numRows, p_numCols), true); }
+
 public:
   /// @name Lifecycle
   //@{
@@ -152,6 +204,9 @@ class gbtRowPlayerWidget : public gbtTableWidgetBase {
 private:
   gbtGameDocument *m_doc;
   gbtTableWidget *m_table;
+  /// The number of rows spanned by a label in each column
+  Gambit::Array<int> m_spans;
+  bool m_hasSpans;
 
   /// @name Overriding wxSheet members for data access
   //@{
@@ -170,6 +225,13 @@ private:
   void DrawCell(wxDC &p_dc, const wxSheetCoords &p_coords);
   //@}  
 
+  /// @name Overriding wxSheet members for spanned cells
+  //@{
+  bool HasSpannedCells(void) const { return m_hasSpans; }
+  /// A strategy's label spans the rows of all its contingencies
+  wxSheetBlock GetCellBlock(const wxSheetCoords &) const;
+  //@}
+
   void OnCellRightClick(wxSheetEvent &);
 
 public:
@@ -193,9 +255,10 @@ public:
 
 gbtRowPlayerWidget::gbtRowPlayerWidget(gbtTableWidget *p_parent,
 				       gbtGameDocument *p_doc)
-  : gbtTableWidgetBase(p_parent, -1), m_doc(p_doc), m_table(p_parent)
+  : gbtTableWidgetBase(p_parent, -1), m_doc(p_doc), m_table(p_parent),
+    m_hasSpans(false)
 {
-  CreateGrid(m_table->NumRowContingencies(), m_table->NumRowPlayers());
+  CreateSheet(m_table->NumRowContingencies(), m_table->NumRowPlayers());
   SetRowLabelWidth(1);
   SetColLabelHeight(1);
   SetScrollBarMode(SB_NEVER);
@@ -280,10 +343,11 @@ void gbtRowPlayerWidget::DrawCell(wxDC &p_dc, const wxSheetCoords &p_coords)
   int player = m_table->GetRowPlayer(p_coords.GetCol() + 1);
   int strat = m_table->RowToStrategy(p_coords.GetCol() + 1, p_coords.GetRow());
   Gambit::GameStrategy strategy = support.GetStrategy(player, strat);
+  gbtDominanceStatus status = m_doc->GetStrategyDominance(strategy);
 
-  if (support.IsDominated(strategy, false)) {
+  if (status != GBT_DOMINANCE_NONE) {
     wxRect rect = CellToRect(p_coords);
-    if (support.IsDominated(strategy, true)) {
+    if (status == GBT_DOMINANCE_STRICT) {
       p_dc.SetPen(wxPen(m_doc->GetStyle().GetPlayerColor(player),
 			2, wxSOLID));
     }
@@ -308,22 +372,27 @@ void gbtRowPlayerWidget::OnUpdate(void)
   if (newCols < GetNumberCols())  DeleteCols(0, GetNumberCols() - newCols);
   if (newCols == 0)  InsertCols(0, 1);
 
-  for (int col = 0; col < GetNumberCols(); col++) {
-    for (int row = 0; row < GetNumberRows(); 
-	 SetCellSpan(wxSheetCoords(row++, col), wxSheetCoords(1, 1)));
-
-    int span = m_table->NumRowsSpanned(col+1);
-
-    int row = 0;
-    while (row < GetNumberRows()) {
-      SetCellSpan(wxSheetCoords(row, col), wxSheetCoords(span, 1));
-      row += span;
-    }
+  m_spans = Gambit::Array<int>(GetNumberCols());
+  m_hasSpans = false;
+  for (int col = 1; col <= GetNumberCols(); col++) {
+    m_spans[col] = m_table->NumRowsSpanned(col);
+    if (m_spans[col] > 1)  m_hasSpans = true;
   }
 
   Refresh();
 }
 
+wxSheetBlock 
+gbtRowPlayerWidget::GetCellBlock(const wxSheetCoords &p_coords) const
+{
+  if (!IsGridCell(p_coords) || p_coords.GetCol() >= m_spans.Length()) {
+    return wxSheetBlock(p_coords, 1, 1);
+  }
+  int span = m_spans[p_coords.GetCol() + 1];
+  return wxSheetBlock(p_coords.GetRow() - p_coords.GetRow() % span,
+		      p_coords.GetCol(), span, 1);
+}
+
 bool gbtRowPlayerWidget::DropText(wxCoord p_x, wxCoord p_y,
 				  const wxString &p_text)
 {
@@ -361,6 +430,9 @@ class gbtColPlayerWidget : public gbtTableWidgetBase {
 private:
   gbtGameDocument *m_doc;
   gbtTableWidget *m_table;
+  /// The number of columns spanned by a label in each row
+  Gambit::Array<int> m_spans;
+  bool m_hasSpans;
 
   /// @name Overriding wxSheet members for data access
   //@{
@@ -379,6 +451,13 @@ private:
   void DrawCell(wxDC &p_dc, const wxSheetCoords &p_coords);
   //@}  
 
+  /// @name Overriding wxSheet members for spanned cells
+  //@{
+  bool HasSpannedCells(void) const { return m_hasSpans; }
+  /// A strategy's label spans the columns of all its contingencies
+  wxSheetBlock GetCellBlock(const wxSheetCoords &) const;
+  //@}
+
   void OnCellRightClick(wxSheetEvent &);
 
 public:
@@ -402,9 +481,10 @@ public:
 
 gbtColPlayerWidget::gbtColPlayerWidget(gbtTableWidget *p_parent,
 				       gbtGameDocument *p_doc)
-  : gbtTableWidgetBase(p_parent, -1), m_doc(p_doc), m_table(p_parent)
+  : gbtTableWidgetBase(p_parent, -1), m_doc(p_doc), m_table(p_parent),
+    m_hasSpans(false)
 {
-  CreateGrid(m_table->NumColPlayers(), 0);
+  CreateSheet(m_table->NumColPlayers(), 0);
   SetRowLabelWidth(1);
   SetColLabelHeight(1);
   SetScrollBarMode(SB_NEVER);
@@ -445,22 +525,27 @@ void gbtColPlayerWidget::OnUpdate(void)
   if (newRows < GetNumberRows())  DeleteRows(0, GetNumberRows() - newRows);
   if (newRows == 0)  InsertRows(0, 1);
 
-  for (int row = 0; row < GetNumberRows(); row++) {
-    for (int col = 0; col < GetNumberCols(); 
-	 SetCellSpan(wxSheetCoords(row, col++), wxSheetCoords(1, 1)));
-
-    int span = m_table->NumColsSpanned(row+1) * m_doc->NumPlayers();
-
-    int col = 0;
-    while (col < GetNumberCols()) {
-      SetCellSpan(wxSheetCoords(row, col), wxSheetCoords(1, span));
-      col += span;
-    }      
+  m_spans = Gambit::Array<int>(GetNumberRows());
+  m_hasSpans = false;
+  for (int row = 1; row <= GetNumberRows(); row++) {
+    m_spans[row] = m_table->NumColsSpanned(row) * m_doc->NumPlayers();
+    if (m_spans[row] > 1)  m_hasSpans = true;
   }
 
   Refresh();
 }
 
+wxSheetBlock 
+gbtColPlayerWidget::GetCellBlock(const wxSheetCoords &p_coords) const
+{
+  if (!IsGridCell(p_coords) || p_coords.GetRow() >= m_spans.Length()) {
+    return wxSheetBlock(p_coords, 1, 1);
+  }
+  int span = m_spans[p_coords.GetRow() + 1];
+  return wxSheetBlock(p_coords.GetRow(), 
+		      p_coords.GetCol() - p_coords.GetCol() % span, 1, span);
+}
+
 wxString gbtColPlayerWidget::GetCellValue(const wxSheetCoords &p_coords)
 {
   if (IsLabelCell(p_coords)) return wxT("");
@@ -517,10 +602,11 @@ void gbtColPlayerWidget::DrawCell(wxDC &p_dc, const wxSheetCoords &p_coords)
   int player = m_table->GetColPlayer(p_coords.GetRow() + 1);
   int strat = m_table->ColToStrategy(p_coords.GetRow() + 1, p_coords.GetCol());
   Gambit::GameStrategy strategy = support.GetStrategy(player, strat);
+  gbtDominanceStatus status = m_doc->GetStrategyDominance(strategy);
 
-  if (support.IsDominated(strategy, false)) {
+  if (status != GBT_DOMINANCE_NONE) {
     wxRect rect = CellToRect(p_coords);
-    if (support.IsDominated(strategy, true)) {
+    if (status == GBT_DOMINANCE_STRICT) {
       p_dc.SetPen(wxPen(m_doc->GetStyle().GetPlayerColor(player),
 			2, wxSOLID));
     }
@@ -571,6 +657,24 @@ private:
   gbtGameDocument *m_doc;
   gbtTableWidget *m_table;
 
+  /// @name Cached contents of the visible cells
+  //@{
+  /// The cells whose contents are cached
+  wxSheetBlock m_cacheBlock;
+  /// Formatted payoffs, by row then column in m_cacheBlock;
+  /// empty for cells not yet drawn
+  std::vector<wxString> m_cache;
+  //@}
+
+  /// @name Locating contingencies in a table game
+  //@{
+  /// The game indexed, if it is a table game; null otherwise
+  Gambit::GameTableRep *m_tableGame;
+  /// The part of the index of a contingency due to each row and column
+  /// (of contingencies, counting from 1)
+  Gambit::Array<Gambit::ContingencyIndex> m_rowIndex, m_colIndex;
+  //@}
+
   /// @name Overriding wxSheet members for data access
   //@{
   /// Returns the value in the cell
@@ -598,6 +702,10 @@ private:
 
   /// Maps columns to corresponding player
   int ColToPlayer(int p_col) const;
+  /// Computes the index of each row and column in a table game
+  void IndexContingencies(void);
+  /// Returns the payoff shown in the cell, formatted for display
+  wxString FormatPayoff(const wxSheetCoords &p_coords) const;
 
 public:
   gbtPayoffsWidget(gbtTableWidget *p_parent, gbtGameDocument *p_doc);
@@ -616,9 +724,10 @@ END_EVENT_TABLE()
 
 gbtPayoffsWidget::gbtPayoffsWidget(gbtTableWidget *p_parent,
 				   gbtGameDocument *p_doc)
-  : gbtTableWidgetBase(p_parent, -1), m_doc(p_doc), m_table(p_parent)
+  : gbtTableWidgetBase(p_parent, -1), m_doc(p_doc), m_table(p_parent),
+    m_tableGame(0)
 {
-  CreateGrid(0, 0);
+  CreateSheet(0, 0);
   SetRowLabelWidth(1);
   SetColLabelHeight(1);
 }
@@ -648,16 +757,101 @@ void gbtPayoffsWidget::OnUpdate(void)
   if (newRows > GetNumberRows())  InsertRows(0, newRows - GetNumberRows());
   if (newRows < GetNumberRows())  DeleteRows(0, GetNumberRows() - newRows);
 
+  m_cacheBlock = wxSheetBlock();
+  m_cache.clear();
+  IndexContingencies();
+
   Refresh();
 }
 
+//
+// In a table game, the index of a contingency into the table of
+// outcomes is one plus the sum of the offsets of its strategies.
+// Computing the part of this sum due to each row and each column
+// once makes locating the outcome of a cell a single lookup.
+//
+void gbtPayoffsWidget::IndexContingencies(void)
+{
+  m_tableGame = 
+    dynamic_cast<Gambit::GameTableRep *>((Gambit::GameRep *) m_doc->GetGame());
+  if (!m_tableGame) {
+    m_rowIndex = Gambit::Array<Gambit::ContingencyIndex>();
+    m_colIndex = Gambit::Array<Gambit::ContingencyIndex>();
+    return;
+  }
+
+  const Gambit::StrategySupportProfile &support = m_doc->GetNfgSupport();
+
+  m_rowIndex = Gambit::Array<Gambit::ContingencyIndex>(m_table->NumRowContingencies());
+  for (int row = 0; row < m_rowIndex.Length(); row++) {
+    Gambit::ContingencyIndex index = 1;
+    for (int i = 1; i <= m_table->NumRowPlayers(); i++) {
+      int strat = m_table->RowToStrategy(i, row);
+      index += m_tableGame->GetStrategyOffset(support.GetStrategy(m_table->GetRowPlayer(i), strat));
+    }
+    m_rowIndex[row+1] = index;
+  }
+
+  m_colIndex = Gambit::Array<Gambit::ContingencyIndex>(m_table->NumColContingencies());
+  for (int col = 0; col < m_colIndex.Length(); col++) {
+    Gambit::ContingencyIndex index = 0;
+    for (int i = 1; i <= m_table->NumColPlayers(); i++) {
+      int strat = m_table->ColToStrategy(i, col * m_doc->NumPlayers());
+      index += m_tableGame->GetStrategyOffset(support.GetStrategy(m_table->GetColPlayer(i), strat));
+    }
+    m_colIndex[col+1] = index;
+  }
+}
+
+wxString gbtPayoffsWidget::FormatPayoff(const wxSheetCoords &p_coords) const
+{
+  int player = ColToPlayer(p_coords.GetCol());
+  Gambit::Rational payoff(0);
+  int row = p_coords.GetRow() + 1;
+  int col = p_coords.GetCol() / m_doc->NumPlayers() + 1;
+
+  if (m_tableGame && row <= m_rowIndex.Length() && col <= m_colIndex.Length()) {
+    Gambit::GameOutcome outcome = 
+      m_tableGame->GetContingencyOutcome(m_rowIndex[row] + m_colIndex[col]);
+    if (outcome) {
+      payoff = outcome->GetPayoff<Gambit::Rational>(player);
+    }
+  }
+  else {
+    Gambit::PureStrategyProfile profile = m_table->CellToProfile(p_coords);
+    payoff = profile->GetPayoff(player);
+  }
+  return wxString(Gambit::lexical_cast<std::string>(payoff).c_str(), *wxConvCurrent);
+}
+
+//
+// The formatted payoffs of the cells in view are kept until the view
+// moves or the document changes, so repainting (for example, when
+// the cursor moves) does not format them again.  Cells outside the
+// view, as when printing, are formatted as they are asked for.
+//
 wxString gbtPayoffsWidget::GetCellValue(const wxSheetCoords &p_coords)
 {
   if (IsLabelCell(p_coords))  return wxT("");
 
-  Gambit::PureStrategyProfile profile = m_table->CellToProfile(p_coords);
-  int player = ColToPlayer(p_coords.GetCol());
-  return wxString(Gambit::lexical_cast<std::string>(profile->GetPayoff(player)).c_str(), *wxConvCurrent);
+  if (!m_cacheBlock.Contains(p_coords)) {
+    wxSheetBlock visible = GetVisibleGridCellsBlock();
+    if (visible.Contains(p_coords)) {
+      m_cacheBlock = visible;
+      m_cache.assign(visible.GetWidth() * visible.GetHeight(), wxString());
+    }
+    else {
+      return FormatPayoff(p_coords);
+    }
+  }
+
+  wxString &value = 
+    m_cache[(p_coords.GetRow() - m_cacheBlock.GetTop()) * m_cacheBlock.GetWidth() + 
+	    p_coords.GetCol() - m_cacheBlock.GetLeft()];
+  if (value.IsEmpty()) {
+    value = FormatPayoff(p_coords);
+  }
+  return value;
 }
 
 void gbtPayoffsWidget::SetCellValue(const wxSheetCoords &p_coords,
@@ -739,11 +933,12 @@ void gbtPayoffsWidget::DrawCell(wxDC &p_dc, const wxSheetCoords &p_coords)
 
   Gambit::PureStrategyProfile profile = m_table->CellToProfile(p_coords);
   int player = ColToPlayer(p_coords.GetCol());
-  const Gambit::StrategySupportProfile &support = m_doc->GetNfgSupport();
+  gbtDominanceStatus status =
+    m_doc->GetStrategyDominance(profile->GetStrategy(player));
 
-  if (support.IsDominated(profile->GetStrategy(player), false)) {
+  if (status != GBT_DOMINANCE_NONE) {
     wxRect rect = CellToRect(p_coords);
-    if (support.IsDominated(profile->GetStrategy(player), true)) {
+    if (status == GBT_DOMINANCE_STRICT) {
       p_dc.SetPen(wxPen(m_doc->GetStyle().GetPlayerColor(player),
 			2, wxSOLID));
     }
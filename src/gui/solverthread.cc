@@ -0,0 +1,437 @@
+//
+// This file is part of Gambit
+// Copyright (c) 1994-2014, The Gambit Project (http://www.gambit-project.org)
+//
+// FILE: src/gui/solverthread.cc
+// Running equilibrium computations on a worker thread
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+//
+
+#include <string>
+#include <vector>
+
+#include <wx/wxprec.h>
+#ifndef WX_PRECOMP
+#include <wx/wx.h>
+#endif  // WX_PRECOMP
+#include <wx/thread.h>
+
+#include "libgambit/libgambit.h"
+#include "libgambit/nash.h"
+#include "tools/enumpure/enumpure.h"
+#include "tools/lp/nfglp.h"
+#include "tools/lp/efglp.h"
+#include "tools/lcp/nfglcp.h"
+#include "tools/lcp/efglcp.h"
+
+#include "solverthread.h"
+
+DEFINE_EVENT_TYPE(GBT_EVT_SOLVER_PROGRESS)
+
+#if wxUSE_THREADS
+
+namespace {
+
+// The least time between progress events, in milliseconds
+const long GBT_PROGRESS_INTERVAL = 250;
+
+//=========================================================================
+//                         class gbtSolverQueue
+//=========================================================================
+
+//
+// The state shared between a worker and the runner which started it.
+// The runner owns it, and waits for the worker before deleting it.
+// The lock is only held to move profiles in or out and to count steps,
+// never while computing or converting profiles.
+//
+template <class T> class gbtSolverQueue {
+private:
+  wxMutex m_mutex;
+  wxEvtHandler *m_handler;
+  bool m_cancelled, m_finished;
+  long m_steps;
+  wxLongLong m_lastPosted;
+  std::string m_error;
+  std::vector<MixedStrategyProfile<T> > m_mixed;
+  std::vector<MixedBehaviorProfile<T> > m_behav;
+
+  /// Post the number of steps taken to the handler; the lock must be held
+  void PostProgress(void);
+
+public:
+  gbtSolverQueue(wxEvtHandler *p_handler)
+    : m_handler(p_handler), m_cancelled(false), m_finished(false),
+      m_steps(0), m_lastPosted(wxGetLocalTimeMillis()) { }
+
+  /// Queue a profile; returns false if the computation has been cancelled
+  template <class P> bool Push(const P &p_profile, std::vector<P> &p_queue);
+  bool Push(const MixedStrategyProfile<T> &p_profile)
+  { return Push(p_profile, m_mixed); }
+  bool Push(const MixedBehaviorProfile<T> &p_profile)
+  { return Push(p_profile, m_behav); }
+
+  /// Remove all queued profiles, in the order they were found
+  void Take(std::vector<MixedStrategyProfile<T> > &,
+	    std::vector<MixedBehaviorProfile<T> > &);
+
+  /// Count a step of the computation, posting progress if it is due;
+  /// returns false if the computation has been cancelled
+  bool Step(void);
+
+  void Cancel(void)
+  { wxMutexLocker lock(m_mutex);  m_cancelled = true; }
+
+  void Finish(const std::string &p_error);
+  bool IsFinished(void)
+  { wxMutexLocker lock(m_mutex);  return m_finished; }
+  std::string GetError(void)
+  { wxMutexLocker lock(m_mutex);  return m_error; }
+};
+
+template <class T> void gbtSolverQueue<T>::PostProgress(void)
+{
+  if (m_handler) {
+    wxCommandEvent event(GBT_EVT_SOLVER_PROGRESS);
+    event.SetExtraLong(m_steps);
+    wxPostEvent(m_handler, event);
+  }
+  m_lastPosted = wxGetLocalTimeMillis();
+}
+
+template <class T> template <class P>
+bool gbtSolverQueue<T>::Push(const P &p_profile, std::vector<P> &p_queue)
+{
+  wxMutexLocker lock(m_mutex);
+  if (m_cancelled) {
+    return false;
+  }
+  p_queue.push_back(p_profile);
+  return true;
+}
+
+template <class T>
+void gbtSolverQueue<T>::Take(std::vector<MixedStrategyProfile<T> > &p_mixed,
+			     std::vector<MixedBehaviorProfile<T> > &p_behav)
+{
+  wxMutexLocker lock(m_mutex);
+  p_mixed.swap(m_mixed);
+  p_behav.swap(m_behav);
+}
+
+template <class T> bool gbtSolverQueue<T>::Step(void)
+{
+  wxMutexLocker lock(m_mutex);
+  if (m_cancelled) {
+    return false;
+  }
+  m_steps++;
+  if (wxGetLocalTimeMillis() - m_lastPosted >= GBT_PROGRESS_INTERVAL) {
+    PostProgress();
+  }
+  return true;
+}
+
+template <class T>
+void gbtSolverQueue<T>::Finish(const std::string &p_error)
+{
+  wxMutexLocker lock(m_mutex);
+  m_finished = true;
+  // Solvers report being stopped by the renderer in various ways;
+  // none of them is an error
+  if (!m_cancelled) {
+    m_error = p_error;
+  }
+  // So the final count is shown
+  PostProgress();
+}
+
+//=========================================================================
+//                 classes gbtQueueRenderer and gbtQueueObserver
+//=========================================================================
+
+//
+// Passes each profile found to the queue.  Once the computation has
+// been cancelled, this throws the exception the solvers already use
+// to stop on reaching a target number of equilibria.
+//
+template <class T> class gbtQueueRenderer : public StrategyProfileRenderer<T> {
+private:
+  gbtSolverQueue<T> *m_queue;
+
+public:
+  gbtQueueRenderer(gbtSolverQueue<T> *p_queue) : m_queue(p_queue) { }
+  virtual ~gbtQueueRenderer() { }
+
+  virtual void Render(const MixedStrategyProfile<T> &p_profile,
+		      const std::string &p_label = "NE") const
+  { if (!m_queue->Push(p_profile))  throw NashEquilibriumLimitReached(); }
+  virtual void Render(const MixedBehaviorProfile<T> &p_profile,
+		      const std::string &p_label = "NE") const
+  { if (!m_queue->Push(p_profile))  throw NashEquilibriumLimitReached(); }
+};
+
+//
+// Counts the steps the solver reports on the worker thread, and stops
+// the computation at the first step after it is cancelled, in the same
+// way as the renderer.
+//
+template <class T> class gbtQueueObserver : public ProgressObserver {
+private:
+  gbtSolverQueue<T> *m_queue;
+
+public:
+  gbtQueueObserver(gbtSolverQueue<T> *p_queue) : m_queue(p_queue) { }
+  virtual ~gbtQueueObserver() { }
+
+  virtual void OnProgress(void)
+  { if (!m_queue->Step())  throw NashEquilibriumLimitReached(); }
+};
+
+//=========================================================================
+//                         class gbtSolverThread
+//=========================================================================
+
+//
+// A joinable thread; the runner which starts it waits for it to end.
+// Exactly one of the two solvers is set.
+//
+template <class T> class gbtSolverThread : public wxThread {
+private:
+  gbtSolverQueue<T> *m_queue;
+  Game m_game;
+  shared_ptr<NashStrategySolver<T> > m_strategySolver;
+  shared_ptr<NashBehavSolver<T> > m_behavSolver;
+
+protected:
+  ExitCode Entry(void);
+
+public:
+  gbtSolverThread(gbtSolverQueue<T> *p_queue, const Game &p_game,
+		  shared_ptr<NashStrategySolver<T> > p_strategySolver,
+		  shared_ptr<NashBehavSolver<T> > p_behavSolver)
+    : wxThread(wxTHREAD_JOINABLE), m_queue(p_queue), m_game(p_game),
+      m_strategySolver(p_strategySolver), m_behavSolver(p_behavSolver)
+  { }
+  virtual ~gbtSolverThread() { }
+};
+
+template <class T> wxThread::ExitCode gbtSolverThread<T>::Entry(void)
+{
+  gbtQueueObserver<T> observer(m_queue);
+  SetProgressObserver(&observer);
+  std::string error;
+  try {
+    if (m_behavSolver.get()) {
+      m_behavSolver->Solve(BehaviorSupportProfile(m_game));
+    }
+    else {
+      m_strategySolver->Solve(m_game);
+    }
+  }
+  catch (NashEquilibriumLimitReached &) {
+    // Stopped on cancellation
+  }
+  catch (std::exception &e) {
+    error = e.what();
+  }
+  SetProgressObserver(0);
+  m_queue->Finish(error);
+  return 0;
+}
+
+//=========================================================================
+//                          class gbtSolverRun
+//=========================================================================
+
+template <class T> class gbtSolverRun : public gbtSolverRunner {
+private:
+  gbtGameDocument *m_doc;
+  gbtAnalysisProfileList<T> *m_output;
+  gbtSolverQueue<T> *m_queue;
+  gbtSolverThread<T> *m_thread;
+  bool m_running;
+
+public:
+  gbtSolverRun(gbtGameDocument *p_doc, gbtAnalysisProfileList<T> *p_output,
+	       const Game &p_game,
+	       shared_ptr<NashStrategySolver<T> > p_strategySolver,
+	       shared_ptr<NashBehavSolver<T> > p_behavSolver,
+	       gbtSolverQueue<T> *p_queue);
+  virtual ~gbtSolverRun();
+
+  bool Start(void);
+  void Cancel(void) { m_queue->Cancel(); }
+
+  int Collect(void);
+  bool IsFinished(void) const { return m_queue->IsFinished(); }
+  wxString GetError(void) const
+  { return wxString(m_queue->GetError().c_str(), *wxConvCurrent); }
+};
+
+template <class T>
+gbtSolverRun<T>::gbtSolverRun(gbtGameDocument *p_doc,
+			      gbtAnalysisProfileList<T> *p_output,
+			      const Game &p_game,
+			      shared_ptr<NashStrategySolver<T> > p_strategySolver,
+			      shared_ptr<NashBehavSolver<T> > p_behavSolver,
+			      gbtSolverQueue<T> *p_queue)
+  : m_doc(p_doc), m_output(p_output), m_queue(p_queue),
+    m_thread(new gbtSolverThread<T>(p_queue, p_game,
+				     p_strategySolver, p_behavSolver)),
+    m_running(false)
+{ }
+
+template <class T> gbtSolverRun<T>::~gbtSolverRun()
+{
+  m_queue->Cancel();
+  if (m_running) {
+    // The worker stops at its next step
+    m_thread->Wait();
+  }
+  delete m_thread;
+  delete m_queue;
+}
+
+template <class T> bool gbtSolverRun<T>::Start(void)
+{
+  if (m_thread->Create() != wxTHREAD_NO_ERROR ||
+      m_thread->Run() != wxTHREAD_NO_ERROR) {
+    m_queue->Finish("Unable to start the computation");
+    return false;
+  }
+  m_running = true;
+  return true;
+}
+
+template <class T> int gbtSolverRun<T>::Collect(void)
+{
+  std::vector<MixedStrategyProfile<T> > mixed;
+  std::vector<MixedBehaviorProfile<T> > behav;
+  m_queue->Take(mixed, behav);
+
+  for (size_t i = 0; i < mixed.size(); i++) {
+    m_output->AddProfile(mixed[i]);
+  }
+  for (size_t i = 0; i < behav.size(); i++) {
+    m_output->AddProfile(behav[i]);
+  }
+  return mixed.size() + behav.size();
+}
+
+//
+// Sets up the solver the command-line tool would use for the method,
+// with the tool's default options.  Methods for which T is not the
+// tool's number type are left to the tool.
+//
+template <class T> gbtSolverRunner *
+CreateRun(gbtGameDocument *p_doc, gbtAnalysisProfileList<T> *p_output,
+	  wxEvtHandler *p_handler)
+{
+  gbtSolverQueue<T> *queue = new gbtSolverQueue<T>(p_handler);
+  shared_ptr<StrategyProfileRenderer<T> > renderer =
+    new gbtQueueRenderer<T>(queue);
+  shared_ptr<NashStrategySolver<T> > strategySolver;
+  shared_ptr<NashBehavSolver<T> > behavSolver;
+  bool useBehav = p_output->IsBehavior() && p_doc->IsTree();
+
+  switch (p_output->GetMethod()) {
+  case GBT_SOLVER_LP:
+    if (useBehav) {
+      behavSolver = new NashLpBehavSolver<T>(renderer);
+    }
+    else {
+      strategySolver = new NashLpStrategySolver<T>(renderer);
+    }
+    break;
+  case GBT_SOLVER_LCP:
+    if (useBehav) {
+      behavSolver = new NashLcpBehaviorSolver<T>(0, 0, renderer);
+    }
+    else {
+      strategySolver = new NashLcpStrategySolver<T>(0, 0, renderer);
+    }
+    break;
+  default:
+    break;
+  }
+
+  if (!strategySolver.get() && !behavSolver.get()) {
+    delete queue;
+    return 0;
+  }
+
+  // The copy is frozen so the solver can read it while the document's
+  // game stays editable
+  Game game = p_doc->GetGame()->Copy();
+  game->Freeze();
+  return new gbtSolverRun<T>(p_doc, p_output, game,
+			     strategySolver, behavSolver, queue);
+}
+
+//
+// enumpure exists only for rationals, and the tool uses the strategic
+// search (with behavior output on trees) unless asked for agent form.
+//
+gbtSolverRunner *
+CreateEnumPureRun(gbtGameDocument *p_doc,
+		  gbtAnalysisProfileList<Rational> *p_output,
+		  wxEvtHandler *p_handler)
+{
+  gbtSolverQueue<Rational> *queue = new gbtSolverQueue<Rational>(p_handler);
+  shared_ptr<StrategyProfileRenderer<Rational> > renderer =
+    new gbtQueueRenderer<Rational>(queue);
+  shared_ptr<NashStrategySolver<Rational> > strategySolver =
+    new NashEnumPureStrategySolver(renderer);
+
+  Game game = p_doc->GetGame()->Copy();
+  game->Freeze();
+  return new gbtSolverRun<Rational>(p_doc, p_output, game, strategySolver,
+				    shared_ptr<NashBehavSolver<Rational> >(),
+				    queue);
+}
+
+}  // end anonymous namespace
+
+#endif  // wxUSE_THREADS
+
+//=========================================================================
+//                         class gbtSolverRunner
+//=========================================================================
+
+gbtSolverRunner *gbtSolverRunner::Create(gbtGameDocument *p_doc,
+					 gbtAnalysisOutput *p_output,
+					 wxEvtHandler *p_handler)
+{
+#if wxUSE_THREADS
+  if (p_output->GetMethod() == GBT_SOLVER_EXTERNAL) {
+    return 0;
+  }
+
+  if (gbtAnalysisProfileList<Rational> *output =
+      dynamic_cast<gbtAnalysisProfileList<Rational> *>(p_output)) {
+    if (p_output->GetMethod() == GBT_SOLVER_ENUMPURE) {
+      return CreateEnumPureRun(p_doc, output, p_handler);
+    }
+    return CreateRun(p_doc, output, p_handler);
+  }
+  if (gbtAnalysisProfileList<double> *output =
+      dynamic_cast<gbtAnalysisProfileList<double> *>(p_output)) {
+    return CreateRun(p_doc, output, p_handler);
+  }
+#endif  // wxUSE_THREADS
+  return 0;
+}
@@ -0,0 +1,79 @@
+//
+// This file is part of Gambit
+// Copyright (c) 1994-2014, The Gambit Project (http://www.gambit-project.org)
+//
+// FILE: src/gui/solverthread.h
+// Running equilibrium computations on a worker thread
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+//
+
+#ifndef SOLVERTHREAD_H
+#define SOLVERTHREAD_H
+
+#include "gamedoc.h"
+
+//!
+//! Runs one of the methods in gbtSolverMethod on a worker thread,
+//! instead of as a command-line tool.  The worker computes on a frozen
+//! copy of the document's game, so the document may be redrawn while
+//! it runs.  Profiles are queued as the method finds them; the GUI
+//! thread calls Collect() to move them into the output list.
+//!
+//! Stopping is cooperative: the methods report each step they take
+//! (a pivot, or a block of contingencies), and a cancelled computation
+//! ends at its next step.  Deleting the runner cancels the computation
+//! and waits for the worker to end.
+//!
+class gbtSolverRunner {
+public:
+  /// @name Lifecycle
+  //@{
+  /// Returns a runner for the method of the output list, or null if
+  /// the method must be run as an external tool.  Progress events
+  /// are posted to p_handler while the computation runs.
+  static gbtSolverRunner *Create(gbtGameDocument *, gbtAnalysisOutput *,
+				 wxEvtHandler *p_handler);
+  virtual ~gbtSolverRunner() { }
+  //@}
+
+  /// @name Controlling the computation
+  //@{
+  /// Start the worker thread; returns false if it could not be started
+  virtual bool Start(void) = 0;
+  /// Ask the computation to stop at its next opportunity
+  virtual void Cancel(void) = 0;
+  //@}
+
+  /// @name Monitoring the computation
+  //@{
+  /// Move profiles found since the last call into the output list,
+  /// returning how many were moved
+  virtual int Collect(void) = 0;
+  /// Has the worker finished, whether normally, by error, or cancelled?
+  virtual bool IsFinished(void) const = 0;
+  /// The error which ended the computation, or empty if none
+  virtual wxString GetError(void) const = 0;
+  //@}
+};
+
+//!
+//! Posted from the worker thread, at most a few times a second, while
+//! the computation makes progress.  GetExtraLong() is the number of
+//! steps taken so far.
+//!
+DECLARE_EVENT_TYPE(GBT_EVT_SOLVER_PROGRESS, -1)
+
+#endif  // SOLVERTHREAD_H
@@ -51,13 +51,12 @@ neighbors(neighb),
 projectionTypes(projTypes),
 payoffs(_payoffs),
 projection(proj),
-projectedStrat(projS),
 fullProjectedStrat(projS),
 projFunctions(projF),
 Porder(Po),
-Pr(P),
 isPure(numANodes,true),
 node2Action(numANodes,vector<int>(numPlayers)),
+numNodePlayers(numANodes,0),
 cache(numPlayers+1),
 player2Class(numPlayers),
 kSymStrategyOffset(1,0)
@@ -126,9 +125,25 @@ kSymStrategyOffset(1,0)
     for(int j=0;j<numPlayers;j++)
 	node2Action[i][j]=-1;
   for(int i=0;i<numPlayers;i++)
-    for(int j=0;j<actions[i];j++)
+    for(int j=0;j<actions[i];j++){
 	node2Action[actionSets[i][j]][i]=j;
+	numNodePlayers[actionSets[i][j]]++;
+    }
 
+  initWorkspace(ownWorkspace);
+  ownWorkspace.Pr=P;
+}
+
+void agg::initWorkspace(workspace &w)
+{
+  w.projectedStrat=fullProjectedStrat;
+  w.Pr.assign(numPlayers, aggdistrib());
+  w.prefixP.assign(numActionNodes, vector<aggdistrib>());
+  w.suffixU.assign(numActionNodes, vector<trie_map<AggNumber> >());
+  w.prefixValid.assign(numActionNodes, 0);
+  w.suffixValid.assign(numActionNodes, numPlayers);
+  w.suffixKey.assign(numPlayers+1, config());
+  w.projScratch.reset();
 }
 
 /*
@@ -575,50 +590,143 @@ agg::initPorder(vector<int>& Po,
 
 //compute the induced distribution 
 void
-agg::computeP(int player, int act, int player2,int act2)
+agg::computeP(workspace &w, int player, int act, int player2,int act2)
 {
   //apply player's strat
-  Pr[0].reset();
-  Pr[0].insert(make_pair(projection[actionSets[player][act]][player][act], 1.0) );
+  w.Pr[0].reset();
+  w.Pr[0].add(projection[actionSets[player][act]][player][act], 1.0);
 
   int numNei = neighbors[actionSets[player][act]].size();
   //apply others' strat
   for (int k=1; k<numPlayers;k++){
-    Pr[k].reset();
+    w.Pr[k].reset();
     if (Porder[player][act][k]==player2){ 
       if (act2==-1){
-	//Pr[k].swap(Pr[k-1]);
-	Pr[k]=Pr[k-1];
+	//Pr[k].swap(w.Pr[k-1]);
+	w.Pr[k]=w.Pr[k-1];
       } else {
 	//apply player2's pure strat
 	aggdistrib temp;
 	temp.insert(make_pair(projection[actionSets[player][act]][player2][act2],1.0));
-	Pr[k].multiply(Pr[k-1],temp ,numNei, projFunctions[actionSets[player][act]]);
+	w.Pr[k].multiply(w.Pr[k-1],temp ,numNei, projFunctions[actionSets[player][act]]);
       }
     } else {
-      Pr[k].multiply (Pr[k-1], 
-	projectedStrat[actionSets[player][act]][Porder[player][act][k]],
+      w.Pr[k].multiply (w.Pr[k-1], 
+	w.projectedStrat[actionSets[player][act]][Porder[player][act][k]],
 	numNei  ,projFunctions[actionSets[player][act]] ); 
     }
   }
     
 }
 
-void agg:: doProjection(int Node, AggNumber* s)
+void agg:: doProjection(workspace &w, int Node, AggNumber* s)
 {
   for (int i=0;i<numPlayers;i++){
-    doProjection(Node,i, &(s[firstAction(i)]));
+    doProjection(w, Node,i, &(s[firstAction(i)]));
   }
 }
 
-inline void agg:: doProjection(int Node, int i, AggNumber* s)
+void agg:: doProjection(workspace &w, int Node, int i, AggNumber* s)
 {
-  projectedStrat[Node][i].reset();
+  w.projScratch.reset();
   for (int j=0;j<actions[i];j++)if(s[j]>(AggNumber)0.0){
-    projectedStrat[Node][i]+= make_pair(projection[Node][i][j],
-              s[j]);
+    w.projScratch.add(projection[Node][i][j], s[j]);
+  }
+  //keep the partial products at Node if i's projected strat is unchanged
+  if (w.projScratch != w.projectedStrat[Node][i]){
+    w.projectedStrat[Node][i].swap(w.projScratch);
+    invalidatePartialP(w, Node,i);
+  }
+}
+
+void agg::updatePrefixP(workspace &w, int Node, int k)
+{
+  if (k<=w.prefixValid[Node]) return;
+  vector<aggdistrib> &prefix = w.prefixP[Node];
+  if (prefix.empty()) prefix.resize(numPlayers+1);
+  int numNei = neighbors[Node].size();
+  for (int j=w.prefixValid[Node]+1; j<=k; j++){
+    if (j==1)
+      prefix[1] = w.projectedStrat[Node][0];
+    else
+      prefix[j].multiply(prefix[j-1], w.projectedStrat[Node][j-1],
+			 numNei, projFunctions[Node]);
+  }
+  w.prefixValid[Node]=k;
+}
+
+AggNumber agg::getSuffixU(workspace &w, int Node, int k, const config &x, const config &c)
+{
+  int numNei = neighbors[Node].size();
+  vector<proj_func*> &f = projFunctions[Node];
+  config &d = w.suffixKey[k];
+  d.resize(numNei);
+
+  if (k==numPlayers){
+    for (int i=0; i<numNei; ++i) d[i] = (*(f[i])) (c[i], x[i]);
+    aggpayoff::iterator p = payoffs[Node].find(d);
+    if (p==payoffs[Node].end()){
+      cout<<"agg::getSuffixU WARNING: unable to find [";
+      copy(d.begin(),d.end(),ostream_iterator<int>(cout," "));
+      cout<<"] in payoffs of action node #"<<Node<<endl;
+      return 0;
+    }
+    return p->second;
+  }
+
+  if (k<w.suffixValid[Node]){
+    for (int j=k; j<w.suffixValid[Node]; ++j) w.suffixU[Node][j].reset();
+    w.suffixValid[Node]=k;
+  }
+  trie_map<AggNumber> &U = w.suffixU[Node][k];
+  aggdistrib::iterator p = U.findExact(c);
+  if (p!=U.end()) return p->second;
+
+  AggNumber result=0;
+  const aggdistrib &strat = w.projectedStrat[Node][k];
+  for (aggdistrib::iterator a=strat.begin(); a!=strat.end(); ++a)if(a->second>(AggNumber)0){
+    for (int i=0; i<numNei; ++i) d[i] = (*(f[i])) (c[i], a->first[i]);
+    result += a->second * getSuffixU(w, Node, k+1, x, d);
   }
+  U.add(c, result);
+  return result;
+}
+
+AggNumber agg::getSuffixU(workspace &w, int Node, int k, const config &x, const aggdistrib &P)
+{
+  if (w.suffixU[Node].empty()) w.suffixU[Node].resize(numPlayers);
+  config &c = w.suffixKey[k-1];
+  AggNumber result=0;
+  for (aggdistrib::iterator p=P.begin(); p!=P.end(); ++p)if(p->second>(AggNumber)0){
+    c.assign(p->first.begin(), p->first.end());
+    result += p->second * getSuffixU(w, Node, k, x, c);
+  }
+  return result;
+}
+
+bool agg::computePartialP(workspace &w, int Node, int player, int player2, aggdistrib &dest)
+{
+  int numNei = neighbors[Node].size();
+  bool started=false;
+
+  //the players before player, from the prefix products
+  if (player>0){
+    updatePrefixP(w, Node,player);
+    dest = w.prefixP[Node][player];
+    started=true;
+  }
+  //the players strictly between player and player2
+  for (int j=player+1; j<player2; j++){
+    if (started)
+      dest.multiply(w.projectedStrat[Node][j], numNei, projFunctions[Node]);
+    else {
+      dest = w.projectedStrat[Node][j];
+      started=true;
+    }
+  }
+  return started;
 }
+
 AggNumber agg::getPurePayoff(int player, int *s){
   assert(player>=0 && player < numPlayers);
   int Node = actionSets[player][s[player]]; 
@@ -643,34 +751,68 @@ AggNumber agg::getPurePayoff(int player, int *s){
   return p->second;
 }
 
-AggNumber agg::getMixedPayoff(int player, StrategyProfile &s){
+AggNumber agg::getMixedPayoff(workspace &w, int player, StrategyProfile &s){
   AggNumber result=0.0;
   assert(player>=0 && player < numPlayers);
   for (int act=0;act <actions[player];++act)if (s[act+firstAction(player)]>(AggNumber)0.0){
-	result+= s[act+firstAction(player)]* getV(player, act, s);
+	result+= s[act+firstAction(player)]* getV(w, player, act, s);
   }
   return result;
 }
 
-void agg::getPayoffVector(AggNumberVector &dest, int player,const StrategyProfile &s){
+void agg::getPayoffVector(workspace &w, AggNumberVector &dest, int player,const StrategyProfile &s){
     assert(player>=0 && player < numPlayers);
     for (int act=0;act<actions[player]; ++act){
-	dest[act]=getV(player,act,s);
+	dest[act]=getV(w, player,act,s);
     }
 }
 
-AggNumber agg::getV(int player, int act,const StrategyProfile &s){
-    //project s to the projectedStrat
-    doProjection(actionSets.at(player).at(act), s);
-    computeP(player, act);
-    return Pr[numPlayers-1].inner_prod(payoffs[actionSets[player][act]]);
+AggNumber agg::getV(workspace &w, int player, int act,const StrategyProfile &s){
+    int Node = actionSets.at(player).at(act);
+    //project s to the projected strats
+    doProjection(w, Node, s);
+    //the partial results only pay off if other players' payoffs at Node
+    //will be computed from them as well
+    if (numNodePlayers[Node]<2 || numPlayers<2){
+      computeP(w, player, act);
+      return w.Pr[numPlayers-1].inner_prod(payoffs[Node]);
+    }
+    //players before player from the prefix, the rest from the suffix
+    aggdistrib &P = w.Pr[numPlayers-1];
+    int k=player+1;
+    if (!computePartialP(w, Node, player, player, P)){
+      P = w.projectedStrat[Node][k++];
+    }
+    return getSuffixU(w, Node, k, projection[Node][player][act], P);
 }
 
-AggNumber agg::getJ(int player1, int act1, int player2,int act2,StrategyProfile &s)
+AggNumber agg::getJ(workspace &w, int player1, int act1, int player2,int act2,StrategyProfile &s)
 {
-    doProjection(actionSets[player1][act1],s);
-    computeP(player1,act1,player2,act2);
-    return Pr[numPlayers-1].inner_prod(payoffs[actionSets[player1][act1]]);
+    if (player2==player1) return getV(w, player1, act1, s);
+    int Node = actionSets[player1][act1];
+    doProjection(w, Node,s);
+    int lo=std::min(player1,player2), hi=std::max(player1,player2);
+    aggdistrib &P = w.Pr[numPlayers-1];
+    bool others = computePartialP(w, Node, lo, hi, P);
+    int k=hi+1;
+    if (act2!=-1){
+      //apply player2's pure strat
+      aggdistrib &temp = w.Pr[numPlayers-2];
+      temp.reset();
+      temp.add(projection[Node][player2][act2], 1.0);
+      if (others)
+	P.multiply(temp, neighbors[Node].size(), projFunctions[Node]);
+      else
+	P.swap(temp);
+    }
+    else if (!others){
+      if (k==numPlayers){
+	computeP(w, player1,act1,player2,act2);
+	return P.inner_prod(payoffs[Node]);
+      }
+      P = w.projectedStrat[Node][k++];
+    }
+    return getSuffixU(w, Node, k, projection[Node][player1][act1], P);
 }
 
 //getSymMixedPayoff: compute expected payoff under a symmetric mixed strat,
@@ -718,17 +860,17 @@ void agg::getSymPayoffVector(AggNumberVector& dest, StrategyProfile &s){
           dest[act]=getSymMixedPayoff(act,s);
   }
 }
-AggNumber agg::getSymMixedPayoff(int node, StrategyProfile &s)
+AggNumber agg::getSymMixedPayoff(workspace &w, int node, StrategyProfile &s)
 {
     int numNei = neighbors[node].size();
 
     if(!isPure[node]){ // then compute EU using trie_map::power()
-      doProjection(node,0,s);
+      doProjection(w, node,0,s);
       assert(numPlayers>1);
       //aggdistrib *dest;
       //projectedStrat[node][0].power(numPlayers-1, dest, Pr, numNei,projFunctions[node]);
-      aggdistrib &dest = Pr[numPlayers-1];
-      projectedStrat[node][0].power(numPlayers-1, dest, Pr[numPlayers-2],numNei,projFunctions[node]);
+      aggdistrib &dest = w.Pr[numPlayers-1];
+      w.projectedStrat[node][0].power(numPlayers-1, dest, w.Pr[numPlayers-2],numNei,projFunctions[node]);
       return dest.inner_prod(projection[node][0][node], numNei, projFunctions[node], payoffs[node]);
     }
 
@@ -798,12 +940,13 @@ void agg::getSymConfigProb(int plClass, StrategyProfile &s, int ownPlClass, int
 
     if(!isPure[node]){
       int player = playerClasses[plClass].at(0);
-      projectedStrat[node][player].reset();
+      ownWorkspace.projectedStrat[node][player].reset();
+      invalidatePartialP(ownWorkspace, node, player);
       if(numPl>0){
         for (int j=0;j<actions[player];j++)if(s[j]>(AggNumber)0.0){
-          projectedStrat[node][player]+= make_pair(projection[node][player][j], s[j]);
+          ownWorkspace.projectedStrat[node][player].add(projection[node][player][j], s[j]);
         }
-        projectedStrat[node][player].power(numPl, dest,Pr[0],numNei, projFunctions[node]);
+        ownWorkspace.projectedStrat[node][player].power(numPl, dest,ownWorkspace.Pr[0],numNei, projFunctions[node]);
       }
       if(plClass==ownPlClass){
         aggdistrib temp;
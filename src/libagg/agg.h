@@ -82,6 +82,44 @@ public:
   friend class aggame;   //wrapper class for gametracer
 
 
+  //scratch space used in computing expected payoffs.  Each agg has a
+  //workspace of its own, used by the methods that do not take one.
+  //Callers evaluating the same agg from several threads at once give
+  //each thread its own workspace, prepared by initWorkspace(); the
+  //methods taking a workspace modify nothing else in the agg.
+  struct workspace {
+    //foreach s \in S, foreach i \in N, the projected mixed strat
+    //which is a prob distribution over the set of 'contributions'
+    std::vector< std::vector<aggdistrib > > projectedStrat;
+
+    //when computing the induced distribution via ComputeP():
+    //foreach k<= n-1,
+    //prob. distrib P_k induced by the partial strat profile of agents o_1..o_k
+
+    //when computing the partial distributions for the payoff jacobian:
+    //  foreach  j \in N,
+    // the partial distribution induced by all agents except j.
+    std::vector<aggdistrib>  Pr;
+
+    //foreach s in S, partial results shared by getV() and getJ() across
+    //calls and across players (getV() only uses them at nodes shared by
+    //several players).  Both depend only on the projected strategies:
+    //prefixP[s][k] is the distribution induced by players 0..k-1, and
+    //suffixU[s][k] maps a configuration induced by the players before k to
+    //the payoff of an action at s, in expectation over players k..n-1.
+    //prefixP[s][k] is up to date for 0<k<=prefixValid[s], and suffixU[s][k]
+    //for k>=suffixValid[s]; entries of suffixU are computed on demand.
+    std::vector<std::vector<aggdistrib> > prefixP;
+    std::vector<std::vector<trie_map<AggNumber> > > suffixU;
+    std::vector<int> prefixValid, suffixValid;
+    //scratch configurations for getSuffixU(), one per player
+    std::vector<config> suffixKey;
+
+    //scratch space for doProjection()
+    aggdistrib projScratch;
+  };
+
+
   //read an AGG from a file
   static agg* makeAGG(char* filename);
 
@@ -157,11 +195,26 @@ std::vector<projtype>& projTypes, int seed, bool int_payoffs=false, int int_fact
   }
 
 
+  //size and clear a workspace for use with this agg
+  void initWorkspace(workspace &w);
+  //the agg's own workspace
+  workspace &getWorkspace() {return ownWorkspace;}
+
   //exp. payoff under mixed strat profile
-  AggNumber getMixedPayoff(int player, StrategyProfile &s);
-  void getPayoffVector(AggNumberVector &dest, int player,const StrategyProfile &s);
-  AggNumber getV (int player, int action,const StrategyProfile &s);
-  AggNumber getJ(int player,int action, int player2,int action2,StrategyProfile &s);
+  AggNumber getMixedPayoff(int player, StrategyProfile &s)
+  { return getMixedPayoff(ownWorkspace, player, s); }
+  void getPayoffVector(AggNumberVector &dest, int player,const StrategyProfile &s)
+  { getPayoffVector(ownWorkspace, dest, player, s); }
+  AggNumber getV (int player, int action,const StrategyProfile &s)
+  { return getV(ownWorkspace, player, action, s); }
+  AggNumber getJ(int player,int action, int player2,int action2,StrategyProfile &s)
+  { return getJ(ownWorkspace, player, action, player2, action2, s); }
+
+  //the same, using the scratch space in w
+  AggNumber getMixedPayoff(workspace &w, int player, StrategyProfile &s);
+  void getPayoffVector(workspace &w, AggNumberVector &dest, int player,const StrategyProfile &s);
+  AggNumber getV (workspace &w, int player, int action,const StrategyProfile &s);
+  AggNumber getJ(workspace &w, int player,int action, int player2,int action2,StrategyProfile &s);
 
 
   AggNumber getPurePayoff(int player, int *s);
@@ -177,7 +230,9 @@ std::vector<projtype>& projTypes, int seed, bool int_payoffs=false, int int_fact
     return true;
   }
   AggNumber getSymMixedPayoff( StrategyProfile &s);
-  AggNumber getSymMixedPayoff(int actnode, StrategyProfile &s);
+  AggNumber getSymMixedPayoff(int actnode, StrategyProfile &s)
+  { return getSymMixedPayoff(ownWorkspace, actnode, s); }
+  AggNumber getSymMixedPayoff(workspace &w, int actnode, StrategyProfile &s);
   void getSymPayoffVector(AggNumberVector& dest, StrategyProfile &s);
   AggNumber getKSymMixedPayoff( int playerClass,std::vector<StrategyProfile> &s);
   AggNumber getKSymMixedPayoff( int playerClass,StrategyProfile &s);
@@ -248,10 +303,6 @@ private:
   // the contribution of s' to D^(s)
   //std::vector<std::vector<config> > projection;
 
-  //foreach s \in S, foreach i \in N, the projected mixed strat
-  //which is a prob distribution over the set of 'contributions'
-  std::vector< std::vector<aggdistrib > > projectedStrat;
-
   // foreach s in S, i in N, the full set of projected actions.
   std::vector<std::vector<aggdistrib> >fullProjectedStrat;
 
@@ -262,21 +313,18 @@ private:
   // in which we apply the DP algorithm
   std::vector< std::vector< std::vector<int> > > Porder;
 
-  //when computing the induced distribution via ComputeP():
-  //foreach k<= n-1,  
-  //prob. distrib P_k induced by the partial strat profile of agents o_1..o_k
-
-  //when computing the partial distributions for the payoff jacobian:
-  //  foreach  j \in N,
-  // the partial distribution induced by all agents except j. 
-  std::vector<aggdistrib>  Pr;
-
   //foreach s in S, whether s's neighbors are all action nodes
   std::vector<bool> isPure;
 
   //foreach s in S, j in N, the index of s in j's action set, or -1 if N/A
   std::vector<std::vector<int> > node2Action;
 
+  //foreach s in S, the number of players having s in their action sets
+  std::vector<int> numNodePlayers;
+
+  //the agg's own scratch space
+  workspace ownWorkspace;
+
   //cache of jacobian entries.
   trie_map<AggNumber> cache;
 
@@ -336,15 +384,32 @@ private:
 
 
   //private methods:
-  void computeP(int player, int act, int player2=-1,int act2=-1);
-  void doProjection(int Node,const StrategyProfile& s){
-	  doProjection (Node, &(const_cast<StrategyProfile &>(s)[0]));
+  void computeP(workspace &w, int player, int act, int player2=-1,int act2=-1);
+
+  //compute in dest the distribution at Node induced by the players
+  //before player2, other than player (player<player2).
+  //returns false (leaving dest empty) if there are no such players.
+  bool computePartialP(workspace &w, int Node, int player, int player2, aggdistrib &dest);
+  void updatePrefixP(workspace &w, int Node, int k);
+  //the payoff at Node of the action contributing x, in expectation over
+  //players k..n-1, when the other players induce the configuration c.
+  //x must be the same on every call for a given Node.
+  AggNumber getSuffixU(workspace &w, int Node, int k, const config &x, const config &c);
+  //the same, in expectation over the distribution P of c
+  AggNumber getSuffixU(workspace &w, int Node, int k, const config &x, const aggdistrib &P);
+  //to be called whenever w.projectedStrat[Node][player] changes
+  static void invalidatePartialP(workspace &w, int Node, int player){
+    w.prefixValid[Node] = std::min(w.prefixValid[Node], player);
+    w.suffixValid[Node] = std::max(w.suffixValid[Node], player+1);
+  }
+  void doProjection(workspace &w, int Node,const StrategyProfile& s){
+	  doProjection (w, Node, &(const_cast<StrategyProfile &>(s)[0]));
   }
-  void doProjection(int Node, int player, const StrategyProfile& s){
-	  doProjection(Node,player, &(const_cast<StrategyProfile &>(s)[firstAction(player)]));
+  void doProjection(workspace &w, int Node, int player, const StrategyProfile& s){
+	  doProjection(w, Node,player, &(const_cast<StrategyProfile &>(s)[firstAction(player)]));
   }
-  void doProjection(int Node, AggNumber* s);
-  void doProjection(int Node, int player, AggNumber* s);
+  void doProjection(workspace &w, int Node, AggNumber* s);
+  void doProjection(workspace &w, int Node, int player, AggNumber* s);
 
   void getSymConfigProb(int plClass, StrategyProfile &s, int ownPlClass, int act, aggdistrib &dest,int plClass2=-1,int act2=-1);
 };
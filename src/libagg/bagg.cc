@@ -226,11 +226,11 @@ AggNumber bagg::getMixedPayoff(int player, StrategyProfile &s){
   return res;
 }
 
-AggNumber bagg::getMixedPayoff(int player,int tp, StrategyProfile &s){
+AggNumber bagg::getMixedPayoff(agg::workspace &w, int player,int tp, StrategyProfile &s){
     AggNumber res(0);
     for (size_t act=0;act<typeActionSets[player][tp].size(); ++act)
 	if (s[act+firstAction(player,tp)]>AggNumber(0.0))
-	    res+= s[act+firstAction(player,tp)] * getV(player,tp,act,s);
+	    res+= s[act+firstAction(player,tp)] * getV(w,player,tp,act,s);
     return res;
 }
 
@@ -260,20 +260,20 @@ void bagg::getAGGStrat(StrategyProfile &as, const StrategyProfile &s, int player
     }
 
 }
-AggNumber bagg::getV (int player, int tp, int action,const StrategyProfile &s){
+AggNumber bagg::getV (agg::workspace &w, int player, int tp, int action,const StrategyProfile &s){
     StrategyProfile as(aggPtr->getNumActions());
     getAGGStrat(as, s, player,tp,action);
-    return aggPtr->getV(player, typeAction2ActionIndex[player][tp][action], as);
+    return aggPtr->getV(w, player, typeAction2ActionIndex[player][tp][action], as);
 }
 
-AggNumber bagg::getPurePayoff(int player, int tp, int *ps)
+AggNumber bagg::getPurePayoff(agg::workspace &w, int player, int tp, int *ps)
 {
   StrategyProfile st(strategyOffset[typeOffset[numPlayers]]);
   for (int i=0;i<strategyOffset[typeOffset[numPlayers]];i++) st[i]=(AggNumber) 0.0;
   for(int i=0;i<typeOffset[numPlayers];i++){
     st[ strategyOffset[i]+ps[i] ]=(AggNumber)1.0;
   }
-  return getMixedPayoff(player,tp,st);
+  return getMixedPayoff(w,player,tp,st);
 }
 
 void bagg::getSymAGGStrat(StrategyProfile &as, const StrategyProfile &s)
@@ -74,15 +74,26 @@ public:
 	  return aggPtr->getMinPayoff();
   }
 
+  //size and clear a workspace for computing payoffs (see agg::workspace)
+  void initWorkspace(agg::workspace &w) { aggPtr->initWorkspace(w); }
+  //the workspace of the underlying agg
+  agg::workspace &getWorkspace() { return aggPtr->getWorkspace(); }
+
   //exp. payoff under mixed strat profile
   AggNumber getMixedPayoff(int player, StrategyProfile &s);
   //exp payoff for player, conditioned on her receiving type tp.
-  AggNumber getMixedPayoff(int player,int tp, StrategyProfile &s);
+  AggNumber getMixedPayoff(int player,int tp, StrategyProfile &s)
+  { return getMixedPayoff(aggPtr->getWorkspace(), player, tp, s); }
+  AggNumber getMixedPayoff(agg::workspace &w, int player,int tp, StrategyProfile &s);
 
   void getPayoffVector(AggNumberVector &dest, int player,int tp, const StrategyProfile &s);
-  AggNumber getV (int player, int tp, int action,const StrategyProfile &s);
+  AggNumber getV (int player, int tp, int action,const StrategyProfile &s)
+  { return getV(aggPtr->getWorkspace(), player, tp, action, s); }
+  AggNumber getV (agg::workspace &w, int player, int tp, int action,const StrategyProfile &s);
 
-  AggNumber getPurePayoff(int player, int tp, int *s);
+  AggNumber getPurePayoff(int player, int tp, int *s)
+  { return getPurePayoff(aggPtr->getWorkspace(), player, tp, s); }
+  AggNumber getPurePayoff(agg::workspace &w, int player, int tp, int *s);
   AggNumber getPurePayoff(int player, int *s){
     AggNumber r=0;
     for(int i=0;i<numTypes[player];++i){
@@ -26,10 +26,24 @@
 
 //Mapping from vector of ints to type V.
 //WARNING: traversal using the iterators is in the reverse order of insertion.
+//
+//Storage is flat: trie nodes live in a single node array, each node's
+//children occupy a block of a shared child array, and the entries are
+//kept in insertion order as packed integer keys alongside a contiguous
+//array of values.  reset() and the in-place products empty the map but
+//keep all of this storage (and the trie structure) for reuse, so that
+//maps which are rebuilt on every payoff evaluation stop allocating once
+//they have reached their working size.
+//
+//Iterators refer to entries by position, so they remain valid as
+//further entries are inserted.  Dereferencing an iterator gives a
+//proxy whose "first" is a view of the stored key and whose "second" is
+//a reference to the stored value.
 
 #include <math.h>
-#include <list>
+#include <vector>
 #include <iterator>
+#include <algorithm>
 
 using std::ostream;
 using std::endl;
@@ -45,27 +59,29 @@ template <class V>
 ostream& operator<< (ostream& s, const trie_map<V>& t);
 
 
+//A view of a key stored in a trie_map
+class trie_key {
+public:
+  typedef int*        iterator;
+  typedef const int*  const_iterator;
+  typedef size_t      size_type;
 
-template <class V>
-struct TrieNode
-{
-  //members:
-  std::vector<TrieNode*> children;
-  typename std::list<std::pair<std::vector<int>,V> >::iterator val;
-
+  trie_key(int *b, int *e):b(b),e(e) {}
 
-  //methods:
+  inline iterator begin() const {return b;}
+  inline iterator end() const {return e;}
+  inline size_type size() const {return e-b;}
+  inline int& operator[](size_t i) const {return b[i];}
 
-  //constructor  
-  TrieNode(size_t branches, typename std::list<std::pair<std::vector<int>,V> >::iterator v):children(branches,(TrieNode*)NULL),val(v) {}
-  
+  inline operator std::vector<int>() const {return std::vector<int>(b,e);}
+  inline bool operator==(const std::vector<int>& v) const
+  {return size()==v.size() && std::equal(b,e,v.begin());}
 
-  inline TrieNode*& operator[](size_t i){
-    if (i<children.size()) return children[i];
-    else {children.resize(i+1,(TrieNode*)NULL); return children[i];}
-  }
+private:
+  int *b, *e;
 };
 
+
 template <class V>
 class trie_map {
 
@@ -75,44 +91,78 @@ public:
   typedef std::pair<std::vector<int>, V> value_type;
 
   typedef V* 		pointer;
-  typedef V&		reference;
 
   typedef unsigned int  size_type;
 
-  typedef typename std::list<value_type>::iterator iterator;
-  typedef typename std::list<value_type>::const_iterator const_iterator;
+  //the result of dereferencing an iterator
+  struct reference {
+    trie_key first;
+    V& second;
+
+    reference(const trie_key& k, V& v):first(k),second(v) {}
+    inline reference* operator->() {return this;}
+    inline operator value_type() const {return value_type(first,second);}
+  };
+
+  class iterator {
+  public:
+    iterator():m(NULL),i(-1) {}
+    iterator(const trie_map<V>* m, int i):m(const_cast<trie_map<V>*>(m)),i(i) {}
+
+    inline reference operator*() const {return m->entry(i);}
+    inline reference operator->() const {return m->entry(i);}
+    //entries are visited from the most recently inserted
+    inline iterator& operator++() {--i; return *this;}
+    inline iterator operator++(int) {iterator r(*this); --i; return r;}
+    inline bool operator==(const iterator& other) const
+    {return i==other.i && (i<0 || m==other.m);}
+    inline bool operator!=(const iterator& other) const {return !(*this==other);}
+
+  private:
+    friend class trie_map<V>;
+    trie_map<V>* m;
+    int i;
+  };
+  typedef iterator const_iterator;
 
 
   //friends
   friend ostream& operator<< <V>(ostream& s, const trie_map<V>& t);
-  
+
   friend class agg;
 
   //constructors
-  trie_map():initBranches(1),root(new TrieNode<V>(1,data.end())){}
-  trie_map(int branches):initBranches(branches),root(new TrieNode<V>(branches,data.end())){}
+  trie_map():initBranches(1) {keyStart.push_back(0);}
+  trie_map(int branches):initBranches(branches) {keyStart.push_back(0);}
 
 
   //copy constructor
   trie_map(const trie_map<V>& other);
 
   //destructor
-  virtual ~trie_map(){deleteNodes(root);}
+  virtual ~trie_map() { }
 
   //assignment
   inline trie_map<V>& operator=( const trie_map<V>& other);
 
   inline void swap (trie_map<V>& other);
 
-  inline size_type size() const {return data.size();}
-  inline bool empty() const {return data.empty();}
-  inline iterator begin() {return data.begin();}
-  inline iterator end() {return data.end();}
-  inline const_iterator begin() const {return data.begin();}
-  inline const_iterator end() const {return data.end();}
+  //same entries, inserted in the same order
+  inline bool operator==(const trie_map<V>& other) const {
+    return values==other.values && keys==other.keys && keyStart==other.keyStart;
+  }
+  inline bool operator!=(const trie_map<V>& other) const {return !(*this==other);}
+
+  inline size_type size() const {return values.size();}
+  inline bool empty() const {return values.empty();}
+  inline iterator begin() const {return iterator(this,(int)values.size()-1);}
+  inline iterator end() const {return iterator(this,-1);}
 
   //insert: same interface as in STL map
-  inline std::pair<iterator,bool> insert (const value_type& x);
+  inline std::pair<iterator,bool> insert (const value_type& x)
+  {return insert_key(x.first, x.second);}
+  inline std::pair<iterator,bool> insert (const reference& x)
+  {return insert_key(x.first, x.second);}
 
   template <class InputIterator>
   inline void insert(InputIterator f, InputIterator l){
@@ -123,96 +173,71 @@ public:
 
   //insert or add
   inline trie_map<V>& operator+=(const value_type& x){
-    std::pair<typename trie_map<V>::iterator ,bool> r=insert(x);
-    if (!r.second) (*r.first).second += x.second;
+    add(x.first, x.second);
     return (*this);
   }
 
+  //insert or add, without building a value_type
+  template <class Key>
+  inline void add(const Key& k, const V& v){
+    std::pair<iterator,bool> r=insert_key(k,v);
+    if (!r.second) values[r.first.i] += v;
+  }
+
 
   //prefix matching
-  //return a reference to iterator
-  inline iterator& find (const key_type& k) const __attribute__((always_inline));
+  template <class Key>
+  inline iterator find (const Key& k) const __attribute__((always_inline));
 
   //exact matching
-  inline iterator findExact (const key_type& k);
+  template <class Key>
+  inline iterator findExact (const Key& k) const;
 
   //clear the tree strucutre as well as data
   inline void clear(){
-	deleteNodes(root);
-	root=new TrieNode<V> (initBranches, data.end()); 
-#ifdef AGGDEBUG
-	iterator endp = data.end();
-#endif
-	data.clear();
-#ifdef AGGDEBUG
-	if(endp != end()) {std::cerr<<"Error: end() changed"<<endl; exit(1);}
-#endif
-	leaves.clear();
+    nodes.clear();
+    children.clear();
+    clearEntries();
   }
 
   //clear data, but keep the tree structure
   inline void reset(){
-    while(!leaves.empty()) {
-
-#ifdef AGGDEBUG
-      if(!leaves.back()){
-	  cout<<"WARNING: NULL pointer in leaves. leaves are:"<<endl;
-	  for(size_t i=0;i<leaves.size();++i){ 
-	      cout << (long long) leaves[i]<<": ";
-	      
-	      if (leaves[i])cout<<leaves[i]->val->second;
-	      cout<<endl;
-	  }
-	  cout<<endl<<"trie is:"<< *this<< endl;
-	  cout<<"in order:"<<endl;
-	  print_in_order();
-      }
-#endif
-
-
-      leaves.back()->val=data.end();
-      leaves.pop_back();
-    }
-    data.clear();
+    releaseLeaves();
+    clearEntries();
   }
 
   //number of elements with key exactly k.
-  // returns 1 or 0 
-  inline size_type count(const key_type& k) {
-    size_t i=0;
-    TrieNode<V>* ptr=root;
-    for (;i<k.size()&&k[i]<(int)ptr->children.size()&&  ptr->children[k[i]];ptr=ptr->children[k[i++]]) ;
-    
-    return (i>=k.size()&&ptr->val!=data.end());
+  // returns 1 or 0
+  template <class Key>
+  inline size_type count(const Key& k) const {
+    return (findExact(k) != end());
   }
 
   //in order traversal
   template <class UnaryFunction>
   inline void in_order(UnaryFunction f, bool debug=false){
-	in_order_subtree(f, root, debug);
+	if (!nodes.empty()) in_order_subtree(f, 0, debug);
   }
-  inline void print_in_order (){in_order(print_helper(end()),true);}
+  inline void print_in_order (){in_order(print_helper(),true);}
 
   //polynomial multiplication of t1 and t2, store the result in self
   void multiply (const trie_map<V>& t1,const trie_map<V>& t2,size_t keylen,
 	 std::vector<proj_func*>& f)
   {
-    static size_t i;
-    static std::pair<std::vector<int>, V> v;
+    size_t i;
     const_iterator p1,p2;
     //assert(this!=&t1 && this != &t2);
-    v.first.resize(keylen);
+    scratchKey.resize(keylen);
     reset();
     for (p1=t1.begin(); p1!=t1.end(); ++p1)if((*p1).second>(V)0){
       for(p2=t2.begin(); p2!=t2.end(); ++p2)if((*p2).second>(V)0){
 	//assert((*p1).first.size()==keylen&& (*p2).first.size()==keylen);
 	for (i=0;i<keylen;++i){
-	  v.first[i]= (*(f[i])) ((*p1).first[i], (*p2).first[i]);
+	  scratchKey[i]= (*(f[i])) ((*p1).first[i], (*p2).first[i]);
 	}
-	v.second = (V)((*p1).second * (*p2).second);
-	(*this) += v;
+	add(scratchKey, (V)((*p1).second * (*p2).second));
       }//end for(p2
-    }//end for(p1 
+    }//end for(p1
   }
 
   //polynomial multiplication
@@ -222,8 +247,8 @@ public:
   void multiply_smart (const trie_map<V>& P_k_minus_1,const trie_map<V>& projectedStrat,size_t keylen,
                         std::vector<proj_func*>& f)
         {
-                static std::pair<std::vector<int>, V> v;
-                v.first.resize(keylen);
+                std::vector<int>& v = scratchKey;
+                v.resize(keylen);
                 reset();
 
                 for (const_iterator P_c_kminus1=P_k_minus_1.begin(); P_c_kminus1!=P_k_minus_1.end(); ++P_c_kminus1)if((*P_c_kminus1).second>V(0)) {
@@ -239,15 +264,15 @@ public:
                         const_iterator a_k = projectedStrat.begin();
                         for (size_t i=0;i<keylen;++i) {
                                 prevConfigObtained[i]= (*(f[i])) ((*P_c_kminus1).first[i], (*a_k).first[i]); // keys
-                                v.first[i] = prevConfigObtained[i];
+                                v[i] = prevConfigObtained[i];
                         }
                         a_k++;
                         for(; a_k!=projectedStrat.end(); a_k++)
                         {
                                 if((*a_k).second> V(0)) { // FIXME what if played with prob 0????
                                         for (size_t i=0;i<keylen;++i) {
-                                                v.first[i]= (*(f[i])) ((*P_c_kminus1).first[i], (*a_k).first[i]); // keys
-                                                if( v.first[i] != prevConfigObtained[i] ) {
+                                                v[i]= (*(f[i])) ((*P_c_kminus1).first[i], (*a_k).first[i]); // keys
+                                                if( v[i] != prevConfigObtained[i] ) {
                                                         canSimplify = false;
                                                         break;
                                                 }
@@ -256,17 +281,15 @@ public:
                                 }
                         }
                         if( canSimplify ){
-                                // v.first should already be initialized
-                                v.second = (V)(*P_c_kminus1).second;
-                                (*this) += v;
+                                // v should already be initialized
+                                add(v, (V)(*P_c_kminus1).second);
                         }else{
                                 for(const_iterator a_k=projectedStrat.begin(); a_k!=projectedStrat.end(); ++a_k)if((*a_k).second>V(0)) {
 				    //assert((*P_c_kminus1).first.size()==keylen&& (*a_k).first.size()==keylen);
                                         for (size_t i=0;i<keylen;++i) {
-                                                v.first[i]= (*(f[i])) ((*P_c_kminus1).first[i], (*a_k).first[i]); // keys
+                                                v[i]= (*(f[i])) ((*P_c_kminus1).first[i], (*a_k).first[i]); // keys
                                         }
-                                        v.second = (V)((*P_c_kminus1).second * (*a_k).second); // this is the 'value'
-                                        (*this) += v;
+                                        add(v, (V)((*P_c_kminus1).second * (*a_k).second)); // this is the 'value'
                                 }//end for(p2
                         }
                 }//end for(p1
@@ -277,44 +300,25 @@ public:
 
   //squaring
   void square(trie_map<V>& dest, size_t keylen, std::vector<proj_func*>& f) const{
-    static std::pair<std::vector<int>, V> v;
-    v.first.resize(keylen);
+    std::vector<int>& v = dest.scratchKey;
+    v.resize(keylen);
     //assert(this!=&dest);
     dest.reset();
     for (const_iterator p1=begin(); p1!=end(); ++p1)if((*p1).second>(V)0){
       for(const_iterator p2=p1; p2!=end(); ++p2)if((*p2).second>(V)0){
 	  //assert((*p1).first.size()==keylen&& (*p2).first.size()==keylen);
         for (size_t i=0;i<keylen;++i){
-          v.first[i]= (*(f[i])) ((*p1).first[i], (*p2).first[i]);
+          v[i]= (*(f[i])) ((*p1).first[i], (*p2).first[i]);
         }
-        v.second = (V)((*p1).second * (*p2).second);
-        if(p1!=p2)v.second *=2;
-        dest += v;
+        V y = (V)((*p1).second * (*p2).second);
+        if(p1!=p2)y *=2;
+        dest.add(v, y);
       }//end for(p2
     }//end for(p1
   }
 
   //squaring in-place
-  void square(size_t keylen, std::vector<proj_func*>& f){
-    static typename std::list<typename trie_map<V>::value_type>::iterator p1,p2;
-    static std::pair<std::vector<int>, V> v;
-    v.first.resize(keylen);
-    std::list<typename trie_map<V>::value_type> data2;
-    //data.swap(data2);
-    data2=data;
-    reset();
-    for(p1=data2.begin();p1!=end();++p1)if((*p1).second>(V)0){
-      for(p2=p1; p2!=data2.end(); ++p2)if((*p2).second>(V)0){
-	  //assert((*p1).first.size()==keylen&& (*p2).first.size()==keylen);
-        for (size_t i=0;i<keylen;++i){
-          v.first[i]= (*(f[i])) ((*p1).first[i], (*p2).first[i]);
-        }
-        v.second = (V)((*p1).second * (*p2).second);
-        if(p1!=p2)v.second *=2;
-        (*this) += v;
-      }//end for(p2
-    }//end for(p1
-  }
+  void square(size_t keylen, std::vector<proj_func*>& f);
 
   //take power of self using repeated squaring. result stored in dest.
   //this is actually slower than power by straight multiplication, if the # of configurations grow polynomially
@@ -365,18 +369,18 @@ public:
   V inner_prod( trie_map<V>& other, V init= (V)(0) ) const{
     V result(init);
     //V th(THRESH);
-    for(const_iterator p=begin(); p!=end(); ++p)if((*p).second>(V)0){
-	typename trie_map<V>::iterator p2=other.find( (*p).first);
+    for(int e=(int)values.size()-1; e>=0; --e)if(values[e]>(V)0){
+	iterator p2=other.find(key(e));
 	//assert(p2 != other.end());
 	if (p2==other.end()){
-	  if(p->second>(V) THRESH){
+	  if(values[e]>(V) THRESH){
 	    cout<<"inner_prod WARNING: discarding [";
-	    copy(p->first.begin(),p->first.end(), ostream_iterator<int>(cout," "));
-	    cout<<"] "<<p->second<<endl;
+	    copy(key(e).begin(),key(e).end(), ostream_iterator<int>(cout," "));
+	    cout<<"] "<<values[e]<<endl;
 	  }
-	} 
+	}
 	else {
-	  result+= (*p).second * (*p2).second;
+	  result+= values[e] * other.values[p2.i];
 	}
     }
     return result;
@@ -385,144 +389,176 @@ public:
   //first apply the action x, then inner prod
   V inner_prod(const std::vector<int>& x, size_t keylen, std::vector<proj_func*>& f,
 	trie_map<V>& other, V init=(V)(0) ) const
-  { 
+  {
     V result(init);
     V th(THRESH);
-    static iterator p2;
-    //V s(-1);
-    for (const_iterator p=begin(); p!=end();++p)if((*p).second>(V)0){
-      value_type y= *p;
-      //assert(y.first.size()==keylen);
+    std::vector<int>& y = scratchKey;
+    y.resize(keylen);
+    for(int e=(int)values.size()-1; e>=0; --e)if(values[e]>(V)0){
+      trie_key k=key(e);
+      //assert(k.size()==keylen);
       for (size_t i=0; i<keylen;++i){
-	y.first[i] = (*(f[i])) (y.first[i],x[i]); 
+	y[i] = (*(f[i])) (k[i],x[i]);
       }
-      //s += y.second;
 
-      p2 = other.find(y.first);
+      iterator p2 = other.find(y);
       //assert(p2!= other.end());
       if (p2==other.end()){
-        if(y.second>th){
+        if(values[e]>th){
 	  cout<<"inner_prod WARNING: discarding [";
-	  copy(y.first.begin(),y.first.end(), ostream_iterator<int>(cout," "));
-	  cout<<"] "<<y.second<<endl;
+	  copy(y.begin(),y.end(), ostream_iterator<int>(cout," "));
+	  cout<<"] "<<values[e]<<endl;
         }
       }
       else{
-        result += y.second  * (*p2).second;
+        result += values[e]  * other.values[p2.i];
       }
     }
 
-//    if (s>THRESH ||s<-THRESH){
-//	cout<<"inner_prod WARNING: sum differ from 1.0: diff is"<<s<<endl;
-//    } 
     return result;
   }
 
-  
+
   //polynomial division
   inline trie_map<V>& operator/= (const std::vector<V>& denom);
 
-  
+
 private:
+  //a trie node: the entry stored at the node (or -1), and the
+  //block of the children array holding its children (0 for none;
+  //node 0 is the root, which is never a child)
+  struct node {
+    int val;
+    int childStart, childCount, childCap;
+    node():val(-1),childStart(0),childCount(0),childCap(0) {}
+  };
+
   //member variables:
-  std::list<value_type> data;
-  size_type initBranches; //default branching factor
-  TrieNode<V> *root;
+  std::vector<node> nodes;
+  std::vector<int> children;
+
+  //entries, in insertion order
+  std::vector<int> keys;      //packed keys
+  std::vector<int> keyStart;  //entry e has key keys[keyStart[e]..keyStart[e+1]-1]
+  std::vector<V> values;
+  std::vector<int> leaves;    //the node holding each entry
+
+  //entries moved aside during in-place operations
+  std::vector<int> spareKeys, spareKeyStart;
+  std::vector<V> spareValues;
 
-  std::vector<TrieNode<V>*> leaves;
+  mutable std::vector<int> scratchKey;
+
+  size_type initBranches; //default branching factor
 
   static const double  THRESH;
-  
-  
+
+
   struct print_helper {
-   print_helper (typename trie_map<V>::iterator en):endp(en){}
    void operator()(typename trie_map<V>::iterator p){
-    if (p== endp) {cout<< "leaf with no data"<<endl; return;}
+    if (p== iterator()) {cout<< "leaf with no data"<<endl; return;}
     cout<<"[";
     copy(p->first.begin(),p->first.end(),ostream_iterator<int>(cout," "));
     cout <<"]: "<<p->second<<endl;
    }
-   typename trie_map<V>::iterator endp;
   };
 
 
 
   //private methods:
-  //div: helper for operator/=()
-  void  div(const std::vector<V>& denom, TrieNode<V>* n, int current, int pivot);
-
-
+  inline trie_key key(int e) const {
+    int *base = const_cast<int*>(keys.empty() ? NULL : &keys[0]);
+    return trie_key(base+keyStart[e], base+keyStart[e+1]);
+  }
+  inline reference entry(int e) {return reference(key(e), values[e]);}
 
-  __attribute__((noinline)) void deleteNodes(TrieNode<V> *n){
-	if (!n) return;
-	size_type i,s=n->children.size();
-	for (i=0;i<s;++i) if (n->children[i]) {
-	  deleteNodes (n->children[i]);
-	}
-	delete n;
+  inline int child(int n, int i) const {
+    const node& nd=nodes[n];
+    return (i<nd.childCount) ? children[nd.childStart+i] : 0;
+  }
+  //returns the child of n at branch i, creating it if necessary
+  inline int makeChild(int n, int i);
+  inline int root() {
+    if (nodes.empty()) nodes.push_back(node());
+    return 0;
   }
 
+  template <class Key>
+  inline std::pair<iterator,bool> insert_key(const Key& k, const V& v);
 
-  /*
-  __attribute__((noinline)) void remove (TrieNode<V> *n){
-	if (!n) return;
-	size_type i, s=n->children.size();
-	for (i=0;i<s;++i) if (n->children[i]){
-	  remove(n->children[i]);
-	}
+  //detach the entries from the trie nodes holding them
+  inline void releaseLeaves(){
+    for (size_t e=0; e<leaves.size(); ++e) {
+#ifdef AGGDEBUG
+      if (nodes[leaves[e]].val != (int)e) {
+	cout<<"WARNING: leaf "<<leaves[e]<<" does not hold entry "<<e<<endl;
+	cout<<"trie is:"<< *this<< endl;
+	cout<<"in order:"<<endl;
+	print_in_order();
+      }
+#endif
+      nodes[leaves[e]].val = -1;
+    }
+  }
 
-	//if (n->val!=data.end()) {
-        //    n->val->second=0;
-        //    n->val= data.end();
-        //}
-	//else {
-        //    delete n;
-        //}
+  inline void clearEntries(){
+    keys.clear();
+    keyStart.resize(1);
+    values.clear();
+    leaves.clear();
+  }
+  //move the entries into the spare arrays, leaving the map empty
+  inline void setAside(){
+    releaseLeaves();
+    keys.swap(spareKeys);
+    keyStart.swap(spareKeyStart);
+    values.swap(spareValues);
+    clearEntries();
   }
-  */
+
+  //div: helper for operator/=()
+  void  div(const std::vector<V>& denom, int n, int current, int pivot);
 
 
   //in order traversal
   template <class UnaryFunction>
-  __attribute__((noinline)) void in_order_subtree(UnaryFunction& f, TrieNode<V> *n, bool debug=false)
+  __attribute__((noinline)) void in_order_subtree(UnaryFunction& f, int n, bool debug=false)
   {
-    if (n==NULL) return;
-    size_type i,s=n->children.size();
+    size_type i,s=nodes[n].childCount;
     bool is_leaf=true;
-    for (i=0;i<s;++i)if (n->children[i]){
+    for (i=0;i<s;++i)if (child(n,i)){
 	is_leaf=false;
 	if (debug) cout<< i<<" ";
-	in_order_subtree(f, n->children[i], debug);
+	in_order_subtree(f, child(n,i), debug);
     }
     if(is_leaf) {
 	if(debug) cout<< "(leaf): ";
-	f(n->val);
+	f((nodes[n].val>=0) ? iterator(this,nodes[n].val) : iterator());
     }
     return;
-  }    
+  }
 
 
 
   //private helper functor classes:
 
   struct div_helper :public std::unary_function<void, iterator>{
-    div_helper(const std::vector<V>& den, int piv,iterator en)
-	:pivot(piv), denom(den),endp(en){}
+    div_helper(const std::vector<V>& den, int piv)
+	:pivot(piv), denom(den){}
     inline void operator()(iterator p){
-	if (p==endp) return;
+	if (p==iterator()) return;
 	p->first[pivot]--;
 	p->second /= denom[pivot];
-    } 
+    }
     int pivot;
     const std::vector<V>& denom;
-    iterator endp;
   };
 
   struct div_helper_mul: public std::unary_function<void,iterator>{
-    div_helper_mul(const std::vector<V>& den, int piv, TrieNode<V>* des,iterator en)
-	:pivot(piv),denom(den), dest(des),endp(en) {}
+    div_helper_mul(const std::vector<V>& den, int piv, trie_map<V>* t, int des)
+	:pivot(piv),denom(den), t(t), dest(des) {}
 
-    void add(const std::vector<int>& conf, V y){
+    void add(const trie_key& conf, V y){
       size_t i,keylen=conf.size();
       double th(THRESH/(double)denom[pivot]);
       //if (y<=th&&y>=-th) return;
@@ -533,45 +569,47 @@ private:
 	    <<y<<endl;
         return;
       }
-      TrieNode<V>* ptr=dest;
+      int ptr=dest;
       for (i=pivot+1; i<keylen; ++i){
-	if( (*ptr)[conf[i]]==NULL){
+	if( t->child(ptr,conf[i])==0){
 	    if((double)y>th||(double)y<-th)
 	      cout<<"division (pivot=" << denom[pivot]<<") WARNING: discarding "
 	        <<y<<endl;
 	    return;
 	}
-	ptr = (*ptr)[conf[i]];
+	ptr = t->child(ptr,conf[i]);
       }
-      ptr->val->second += y;
-      //assert(ptr->val->second>-THRESH);
-      if ((double)ptr->val->second <= -th)
+      V& val = t->values[t->nodes[ptr].val];
+      val += y;
+      //assert(val>-THRESH);
+      if ((double)val <= -th)
 	cout<<"division (pivot=" << denom[pivot]<<") WARNING: discarding "
-	    <<ptr->val->second<<endl;
-      if (ptr->val->second <(V)0) ptr->val->second=0;
+	    <<val<<endl;
+      if (val <(V)0) val=0;
     }
     void operator()(iterator p){
-      if (p==endp) return;
-      size_t i, keylen = p->first.size();
+      if (p==iterator()) return;
+      trie_key k = p->first;
+      size_t i, keylen = k.size();
       //assert(keylen==denom.size());
       V null_prob(((V)1)-denom[pivot]);
       //V th(THRESH);
       for (i=pivot+1; i<keylen; ++i)if(denom[i]>(V)0){
-	p->first[i]++;
-	add(p->first, -denom[i]* p->second);
-	p->first[i]--;
+	k[i]++;
+	add(k, -denom[i]* p->second);
+	k[i]--;
 	null_prob-= denom[i];
       }
-      
+
       if (null_prob>(V)0)
-        add(p->first, -null_prob * p->second);
+        add(k, -null_prob * p->second);
     }
 
-    
+
     int pivot;
     const std::vector<V>& denom;
-    TrieNode<V>* dest;
-    iterator endp;
+    trie_map<V>* t;
+    int dest;
   };  //end struct div_helper_mul
 
 };
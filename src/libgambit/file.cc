@@ -628,7 +628,9 @@ Game BuildNfg(GameParserState &p_parser, TableFileGame &p_data)
     dim[pl] = p_data.NumStrategies(pl);
   }
 
-  GameRep *nfg = NewTable(dim);
+  // A body in outcome format lists the distinct outcomes itself, so
+  // only those are created; a body in payoff format has one per cell
+  GameRep *nfg = NewTable(dim, p_parser.GetCurrentToken() == TOKEN_LBRACE);
   // Assigning this to the container assures that, if something goes
   // wrong, the class will automatically be cleaned up
   Game game = nfg;
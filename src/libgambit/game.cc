@@ -46,6 +46,7 @@ GameOutcomeRep::GameOutcomeRep(GameRep *p_game, int p_number)
 void GameStrategyRep::DeleteStrategy(void)
 {
   if (m_player->GetGame()->IsTree())  throw UndefinedException();
+  if (m_player->m_game->IsFrozen())  throw FrozenGameException();
   if (m_player->NumStrategies() == 1)  return;
 
   m_player->m_strategies.Remove(m_player->m_strategies.Find(this));
@@ -79,6 +80,11 @@ GamePlayerRep::~GamePlayerRep()
 GameStrategy GamePlayerRep::NewStrategy(void)
 {
   if (m_game->IsTree())  throw UndefinedException();
+  if (m_game->IsFrozen())  throw FrozenGameException();
+  // Throws if the table would become too large
+  Array<int> dim = m_game->NumStrategies();
+  dim[m_number]++;
+  GameTableRep::CountContingencies(dim);
 
   GameStrategyRep *strategy = new GameStrategyRep(this);
   m_strategies.Append(strategy);
@@ -88,6 +94,18 @@ GameStrategy GamePlayerRep::NewStrategy(void)
   return strategy;
 }
 
+void GamePlayerRep::ShareObjects(void)
+{
+  Share();
+  for (int st = 1; st <= m_strategies.Length(); m_strategies[st++]->Share());
+  for (int iset = 1; iset <= m_infosets.Length(); iset++) {
+    GameTreeInfosetRep *infoset = m_infosets[iset];
+    infoset->Share();
+    for (int act = 1; act <= infoset->m_actions.Length(); 
+	 infoset->m_actions[act++]->Share());
+  }
+}
+
 void GamePlayerRep::MakeStrategy(void)
 {
   Array<int> c(NumInfosets());
@@ -396,6 +414,18 @@ PureBehaviorProfile::ToMixedBehaviorProfile(void) const
   return temp;
 }
 
+//========================================================================
+//                            class GameRep
+//========================================================================
+
+void GameRep::Freeze(void)
+{
+  if (m_frozen)  return;
+  BuildComputedValues();
+  PrepareForThreads();
+  m_frozen = true;
+}
+
 //========================================================================
 //                       class GameExplicitRep
 //========================================================================
@@ -412,6 +442,13 @@ GameExplicitRep::~GameExplicitRep()
        m_outcomes[outc++]->Invalidate());
 }
 
+void GameExplicitRep::PrepareForThreads(void)
+{
+  GameRep::PrepareForThreads();
+  for (int pl = 1; pl <= m_players.Length(); m_players[pl++]->ShareObjects());
+  for (int outc = 1; outc <= m_outcomes.Length(); m_outcomes[outc++]->Share());
+}
+
 //------------------------------------------------------------------------
 //                  GameExplicitRep: General data access
 //------------------------------------------------------------------------
@@ -491,12 +528,12 @@ GameStrategy GameExplicitRep::GetStrategy(int p_index) const
   throw IndexException();
 }
 
-int GameExplicitRep::NumStrategyContingencies(void) const
+ContingencyIndex GameExplicitRep::NumStrategyContingencies(void) const
 {
   const_cast<GameExplicitRep *>(this)->BuildComputedValues();
-  int ncont = 1;
+  ContingencyIndex ncont = 1;
   for (int pl = 1; pl <= m_players.Length(); pl++) {
-    ncont *= m_players[pl]->m_strategies.Length();
+    ncont = MultiplyContingencies(ncont, m_players[pl]->m_strategies.Length());
   }
   return ncont;
 }
@@ -517,6 +554,7 @@ int GameExplicitRep::MixedProfileLength(void) const
 
 GameOutcome GameExplicitRep::NewOutcome(void)
 {
+  if (m_frozen)  throw FrozenGameException();
   m_outcomes.Append(new GameOutcomeRep(this, m_outcomes.Length() + 1));
   return m_outcomes[m_outcomes.Last()];
 }
@@ -30,6 +30,29 @@
 
 namespace Gambit {
 
+/// Increments a counter which may be shared between threads, and
+/// returns the new value.  Where the compiler provides no atomic
+/// operations this is ordinary arithmetic.
+inline int AtomicIncrement(int &p_value)
+{
+#ifdef HAVE_SYNC_BUILTINS
+  return __sync_add_and_fetch(&p_value, 1);
+#else
+  return ++p_value;
+#endif  // HAVE_SYNC_BUILTINS
+}
+
+/// Decrements a counter which may be shared between threads, and
+/// returns the new value.
+inline int AtomicDecrement(int &p_value)
+{
+#ifdef HAVE_SYNC_BUILTINS
+  return __sync_sub_and_fetch(&p_value, 1);
+#else
+  return --p_value;
+#endif  // HAVE_SYNC_BUILTINS
+}
+
 /// This is a base class for all game-related objects.  Primary among
 /// its responsibility is maintaining a reference count.  Calling code
 /// which maintains pointers to objects representing parts of a game
@@ -38,17 +61,21 @@ namespace Gambit {
 /// with a positive reference count will not have its memory deleted,
 /// but will instead be marked as deleted.  Calling code should always
 /// be careful to check the deleted status of the object before any
-/// operations on it.
+/// operations on it.  Once an object is shared, its reference count is
+/// updated atomically, so that handles to it may be copied and released
+/// on several threads at once.  GameRep::Freeze() shares all the objects
+/// of a game; the counts of other objects are updated with ordinary
+/// arithmetic, which is much cheaper.
 class GameObject {
 protected:
   int m_refCount;
-  bool m_valid;
+  bool m_valid, m_shared;
 
 public:
   /// @name Lifecycle
   //@{
   /// Constructor; initializes reference count
-  GameObject(void) : m_refCount(0), m_valid(true) { }
+  GameObject(void) : m_refCount(0), m_valid(true), m_shared(false) { }
   /// Destructor
   virtual ~GameObject() { }
   //@}
@@ -65,11 +92,16 @@ public:
   /// @name Reference counting
   //@{
   /// Increment the reference count
-  void IncRef(void) { m_refCount++; }
+  void IncRef(void) 
+  { if (m_shared) AtomicIncrement(m_refCount); else ++m_refCount; }
   /// Decrement the reference count; delete if reference count is zero.
-  void DecRef(void) { if (!--m_refCount && !m_valid) delete this; }
+  void DecRef(void) 
+  { if (!((m_shared) ? AtomicDecrement(m_refCount) : --m_refCount) && 
+	!m_valid) delete this; }
   /// Returns the reference count
   int RefCount(void) const { return m_refCount; }
+  /// Update the reference count atomically from now on
+  void Share(void) { m_shared = true; }
   //@}
 };
 
@@ -162,10 +194,20 @@ template <class T> class MixedStrategyProfile;
 template <class T> class MixedBehaviorProfile;
 class StrategySupportProfile;
 
+//
+// The contingencies (pure strategy profiles) of a strategic game are
+// numbered from one, with player 1's strategy varying fastest.  Tables
+// may have more than 2^31 of them, so the index is 64 bits wide on
+// every platform.
+//
+typedef long long ContingencyIndex;
+
+/// The largest value a ContingencyIndex can hold
+const ContingencyIndex MaxContingencyIndex = 0x7fffffffffffffffLL;
+
 //=======================================================================
 //         Exceptions thrown from game representation classes
 //=======================================================================
-
 /// Exception thrown when an operation that is undefined is attempted
 class UndefinedException : public Exception {
 public:
@@ -182,6 +224,35 @@ public:
   { return "Operation between objects in different games"; }
 };
 
+/// Exception thrown when attempting to change a frozen game
+class FrozenGameException : public Exception {
+public:
+  virtual ~FrozenGameException() throw() { }
+  const char *what(void) const throw()  
+  { return "Attempting to change a frozen game"; }
+};
+
+/// Exception thrown when a game would have more strategy contingencies
+/// than can be numbered by a ContingencyIndex, or stored in memory
+class ContingencyOverflowException : public Exception {
+public:
+  virtual ~ContingencyOverflowException() throw() { }
+  const char *what(void) const throw()  
+  { return "The game has too many strategy contingencies to be represented"; }
+};
+
+/// Returns p_count * p_factor, throwing ContingencyOverflowException
+/// if this is more than p_limit
+inline ContingencyIndex 
+MultiplyContingencies(ContingencyIndex p_count, int p_factor,
+		      ContingencyIndex p_limit = MaxContingencyIndex)
+{
+  if (p_factor > 0 && p_count > p_limit / p_factor) {
+    throw ContingencyOverflowException();
+  }
+  return p_count * p_factor;
+}
+
 /// Exception thrown on a parse error when reading a game savefile
 class InvalidFileException : public Exception {
 public:
@@ -236,11 +307,7 @@ public:
   template <class T> const T &GetPayoff(int pl) const 
     { return (const T &) m_payoffs[pl]; }
   /// Sets the payoff to player 'pl'
-  void SetPayoff(int pl, const std::string &p_value)
-  {
-    m_payoffs[pl] = p_value;
-    //m_game->ClearComputedValues();
-  }
+  void SetPayoff(int pl, const std::string &p_value);
 
   /// Map the outcome to the corresponding outcome in the unrestricted game
   GameOutcome Unrestrict(void) const 
@@ -350,7 +417,7 @@ class GameStrategyRep : public GameObject  {
 private:
   int m_number, m_id;
   GamePlayerRep *m_player;
-  long m_offset;
+  ContingencyIndex m_offset;
   std::string m_label;
   Array<int> m_behav;
   GameStrategy m_unrestricted;
@@ -408,6 +475,10 @@ class GamePlayerRep : public GameObject {
   void MakeStrategy(void);
   void MakeReducedStrats(GameTreeNodeRep *, GameTreeNodeRep *);
   //@}
+
+  /// Shares the player, its strategies, and its information sets and
+  /// their actions (see GameObject::Share())
+  void ShareObjects(void);
   
 private:
   GameRep *m_game;
@@ -539,7 +610,7 @@ public:
   /// @name Data access and manipulation
   //@{
   /// Get the index uniquely identifying the strategy profile
-  virtual long GetIndex(void) const { throw UndefinedException(); }
+  virtual ContingencyIndex GetIndex(void) const { throw UndefinedException(); }
   /// Get the strategy played by player pl  
   const GameStrategy &GetStrategy(int pl) const { return m_profile[pl]; }
   /// Get the strategy played by the player
@@ -659,8 +730,9 @@ class GameRep : public GameObject {
 
 protected:
   std::string m_title, m_comment;
+  bool m_frozen;
 
-  GameRep(void) { }
+  GameRep(void) : m_frozen(false) { }
 
   /// @name Managing the representation
   //@{
@@ -672,6 +744,9 @@ protected:
   virtual void BuildComputedValues(void) { }
   /// Have computed values been built?
   virtual bool HasComputedValues(void) const { return false; }
+  /// Prepare the game to be read by several threads at once, sharing
+  /// all its objects (see GameObject::Share()); called by Freeze()
+  virtual void PrepareForThreads(void) { Share(); }
   //@}
 
 
@@ -684,6 +759,21 @@ public:
   virtual Game Copy(void) const = 0;
   //@}
 
+  /// @name Sharing the game between threads
+  //@{
+  /// Builds all values which are otherwise computed on demand, and
+  /// makes the structure and payoffs of the game read-only; attempts
+  /// to change them throw FrozenGameException.  A frozen game may then
+  /// be read, and profiles on it evaluated, by several threads at once,
+  /// as long as each profile is used by only one thread at a time.
+  /// Labels and comments may still be set, but not while other threads
+  /// are using the game.  Freezing cannot be undone; Copy() returns an
+  /// unfrozen copy.
+  void Freeze(void);
+  /// Returns true if the game has been frozen
+  bool IsFrozen(void) const { return m_frozen; }
+  //@}
+
   /// @name General data access
   //@{
   /// Returns true if the game has a game tree representation
@@ -709,6 +799,11 @@ public:
 
   /// Returns true if the game is constant-sum
   virtual bool IsConstSum(void) const = 0; 
+  /// Returns true if every permutation of the players leaves the game
+  /// unchanged: all players have the same number of strategies, and
+  /// each player's payoff depends only on the player's own strategy
+  /// and the multiset of strategies of the others
+  virtual bool IsSymmetric(void) const { return false; }
   /// Returns the smallest payoff in any outcome of the game
   virtual Rational GetMinPayoff(int pl = 0) const = 0;
   /// Returns the largest payoff in any outcome of the game
@@ -741,7 +836,7 @@ public:
   /// Gets the i'th strategy in the game, numbered globally
   virtual GameStrategy GetStrategy(int p_index) const = 0;
   /// Returns the number of strategy contingencies in the game
-  virtual int NumStrategyContingencies(void) const = 0;
+  virtual ContingencyIndex NumStrategyContingencies(void) const = 0;
   /// Returns the total number of actions in the game
   virtual int BehavProfileLength(void) const = 0;
   /// Returns the total number of strategies in the game
@@ -814,6 +909,12 @@ Game NewTable(const Array<int> &p_dim, bool p_sparseOutcomes = false);
 // all classes to be defined.
 
 inline Game GameOutcomeRep::GetGame(void) const { return m_game; }
+inline void GameOutcomeRep::SetPayoff(int pl, const std::string &p_value)
+{
+  if (m_game->IsFrozen())  throw FrozenGameException();
+  m_payoffs[pl] = p_value;
+  //m_game->ClearComputedValues();
+}
 
 inline GamePlayer GameStrategyRep::GetPlayer(void) const { return m_player; }
 
@@ -99,6 +99,14 @@ GameAggRep::GameAggRep(agg* p_aggPtr)
   }
 }
 
+GameAggRep::~GameAggRep()
+{
+  for (size_t i = 0; i < m_workspaces.size(); i++) {
+    delete m_workspaces[i];
+  }
+  delete aggPtr;
+}
+
 Game GameAggRep::Copy(void) const
 {
   std::ostringstream os;
@@ -107,6 +115,34 @@ Game GameAggRep::Copy(void) const
   return ReadAggFile(is);
 }
 
+//
+// Until the game is frozen, payoffs are computed single-threaded using
+// the agg's own scratch space, as before.  Once frozen, each thread is
+// given a workspace of its own the first time it asks for one; these
+// are kept until the game is deleted.
+//
+agg::workspace &GameAggRep::GetWorkspace(void) const
+{
+  if (!m_frozen) {
+    return aggPtr->getWorkspace();
+  }
+  agg::workspace *ws = static_cast<agg::workspace *>(m_threadWorkspace.Get());
+  if (!ws) {
+    ws = new agg::workspace;
+    aggPtr->initWorkspace(*ws);
+    MutexLock lock(m_workspaceMutex);
+    m_workspaces.push_back(ws);
+    m_threadWorkspace.Set(ws);
+  }
+  return *ws;
+}
+
+void GameAggRep::PrepareForThreads(void)
+{
+  GameRep::PrepareForThreads();
+  for (int pl = 1; pl <= m_players.Length(); m_players[pl++]->ShareObjects());
+}
+
 //------------------------------------------------------------------------
 //                  GameAggRep: Dimensions of the game
 //------------------------------------------------------------------------
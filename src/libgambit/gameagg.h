@@ -24,6 +24,7 @@
 #define GAMEAGG_H
 
 #include "libagg/agg.h"
+#include "thread.h"
 
 class aggame;
 
@@ -38,17 +39,29 @@ class GameAggRep : public GameRep {
 private:
   agg *aggPtr;
   Array<GamePlayerRep *> m_players;
+  /// Scratch space for computing payoffs, one per thread once frozen
+  mutable ThreadLocalMember m_threadWorkspace;
+  mutable Mutex m_workspaceMutex;
+  mutable std::vector<agg::workspace *> m_workspaces;
 
   /// Constructor; takes ownership of the passed pointer
   GameAggRep(agg *);
 
+  /// Returns the scratch space to use for computing payoffs on the
+  /// calling thread
+  agg::workspace &GetWorkspace(void) const;
+  /// Shares the players and strategies of the game
+  virtual void PrepareForThreads(void);
+
 public:
   /// @name Lifecycle
   //@{
   /// Create a game from a serialized file in AGG format
   static Game ReadAggFile(std::istream &);
+  /// Create a game from an AGG built in memory; takes ownership of it
+  static Game FromAgg(agg *p_aggPtr) { return new GameAggRep(p_aggPtr); }
   /// Destructor
-  virtual ~GameAggRep() { delete aggPtr; }
+  virtual ~GameAggRep();
   /// Create a copy of the game, as a new game
   virtual Game Copy(void) const;
   //@}
@@ -68,7 +81,7 @@ public:
   /// Returns the total number of strategies in the game
   virtual int MixedProfileLength(void) const 
   { return aggPtr->getNumActions(); }
-  virtual int NumStrategyContingencies(void) const
+  virtual ContingencyIndex NumStrategyContingencies(void) const
   { throw UndefinedException(); }
   //@}
 
@@ -63,9 +63,10 @@ Rational BagentPureStrategyProfileRep::GetPayoff(int pl) const
   for (int i = 1; i <= m_nfg->NumPlayers(); i++) {
     s[i-1] = m_profile[i]->GetNumber() - 1;
   }
-  int bp = dynamic_cast<GameBagentRep &>(*m_nfg).agent2baggPlayer[pl];
+  GameBagentRep &g = dynamic_cast<GameBagentRep &>(*m_nfg);
+  int bp = g.agent2baggPlayer[pl];
   int tp = pl - 1 - baggPtr->typeOffset[bp-1];
-  return baggPtr->getPurePayoff(bp-1,tp,s);
+  return baggPtr->getPurePayoff(g.GetWorkspace(), bp-1,tp,s);
 }
 
 Rational
@@ -78,9 +79,10 @@ BagentPureStrategyProfileRep::GetStrategyValue(const GameStrategy &p_strategy) c
     s[i-1] = m_profile[i]->GetNumber() - 1;
   }
   s[player-1] = p_strategy->GetNumber() - 1;
-  int bp = dynamic_cast<GameBagentRep &>(*m_nfg).agent2baggPlayer[player];
+  GameBagentRep &g = dynamic_cast<GameBagentRep &>(*m_nfg);
+  int bp = g.agent2baggPlayer[player];
   int tp = player - 1 - baggPtr->typeOffset[bp-1];
-  return baggPtr->getPurePayoff(bp-1,tp,s);
+  return baggPtr->getPurePayoff(g.GetWorkspace(), bp-1,tp,s);
 }
 
 
@@ -109,6 +111,40 @@ GameBagentRep::GameBagentRep(bagg* _baggPtr)
   }
 }
 
+GameBagentRep::~GameBagentRep()
+{
+  for (size_t i = 0; i < m_workspaces.size(); i++) {
+    delete m_workspaces[i];
+  }
+  delete baggPtr;
+}
+
+//
+// As for GameAggRep, each thread computes payoffs in a workspace of
+// its own once the game is frozen.
+//
+agg::workspace &GameBagentRep::GetWorkspace(void) const
+{
+  if (!m_frozen) {
+    return baggPtr->getWorkspace();
+  }
+  agg::workspace *ws = static_cast<agg::workspace *>(m_threadWorkspace.Get());
+  if (!ws) {
+    ws = new agg::workspace;
+    baggPtr->initWorkspace(*ws);
+    MutexLock lock(m_workspaceMutex);
+    m_workspaces.push_back(ws);
+    m_threadWorkspace.Set(ws);
+  }
+  return *ws;
+}
+
+void GameBagentRep::PrepareForThreads(void)
+{
+  GameRep::PrepareForThreads();
+  for (int pl = 1; pl <= m_players.Length(); m_players[pl++]->ShareObjects());
+}
+
 Game GameBagentRep::Copy(void) const
 {
   std::ostringstream os;
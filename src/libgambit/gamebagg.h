@@ -24,6 +24,7 @@
 #define GAMEBAGG_H
 
 #include "libagg/bagg.h"
+#include "thread.h"
 
 namespace Gambit {
 
@@ -36,17 +37,27 @@ private:
   bagg *baggPtr;
   Array<int> agent2baggPlayer;
   Array<GamePlayerRep *> m_players;
+  /// Scratch space for computing payoffs, one per thread once frozen
+  mutable ThreadLocalMember m_threadWorkspace;
+  mutable Mutex m_workspaceMutex;
+  mutable std::vector<agg::workspace *> m_workspaces;
 
   /// Constructor; takes ownership of the passed pointer
   GameBagentRep(bagg *_baggPtr);
 
+  /// Returns the scratch space to use for computing payoffs on the
+  /// calling thread
+  agg::workspace &GetWorkspace(void) const;
+  /// Shares the players and strategies of the game
+  virtual void PrepareForThreads(void);
+
 public:
   /// @name Lifecycle
   //@{
   /// Create a game from a serialized file in BAGG format
   static Game ReadBaggFile(std::istream &);
   /// Destructor
-  virtual ~GameBagentRep() { delete baggPtr; }
+  virtual ~GameBagentRep();
   /// Create a copy of the game, as a new game
   virtual Game Copy(void) const;
   //@}
@@ -63,7 +74,7 @@ public:
   virtual GameStrategy GetStrategy(int p_index) const
   { throw UndefinedException(); }
   /// Returns the number of strategy contingencies in the game
-  virtual int NumStrategyContingencies(void) const
+  virtual ContingencyIndex NumStrategyContingencies(void) const
   { throw UndefinedException(); }
   /// Returns the total number of actions in the game
   virtual int BehavProfileLength(void) const
@@ -33,6 +33,11 @@ protected:
   Array<GamePlayerRep *> m_players;
   Array<GameOutcomeRep *> m_outcomes;
 
+  /// @name Managing the representation
+  //@{
+  virtual void PrepareForThreads(void);
+  //@}
+
   /// @name Writing data files
   //@{
   /// Write the game in .efg format to the specified stream
@@ -65,7 +70,7 @@ public:
   /// Gets the i'th strategy in the game, numbered globally
   virtual GameStrategy GetStrategy(int p_index) const;
   /// Returns the number of strategy contingencies in the game
-  virtual int NumStrategyContingencies(void) const;
+  virtual ContingencyIndex NumStrategyContingencies(void) const;
   /// Returns the total number of strategies in the game
   virtual int MixedProfileLength(void) const;
   //@}
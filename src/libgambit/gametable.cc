@@ -22,6 +22,8 @@
 
 #include <iostream>
 #include <sstream>
+#include <algorithm>
+#include <climits>
 
 #include "libgambit.h"
 #include "gametable.h"
@@ -34,13 +36,13 @@ namespace Gambit {
 
 class TablePureStrategyProfileRep : public PureStrategyProfileRep {
 protected:
-  long m_index;
+  ContingencyIndex m_index;
 
   virtual PureStrategyProfileRep *Copy(void) const;
 
 public:
   TablePureStrategyProfileRep(const Game &p_game);
-  virtual long GetIndex(void) const { return m_index; }
+  virtual ContingencyIndex GetIndex(void) const { return m_index; }
   virtual void SetStrategy(const GameStrategy &);
   virtual GameOutcome GetOutcome(void) const;
   virtual void SetOutcome(GameOutcome p_outcome);
@@ -82,17 +84,19 @@ void TablePureStrategyProfileRep::SetStrategy(const GameStrategy &s)
 
 GameOutcome TablePureStrategyProfileRep::GetOutcome(void) const
 { 
-  return dynamic_cast<GameTableRep &>(*m_nfg).m_results[m_index]; 
+  return dynamic_cast<GameTableRep &>(*m_nfg).GetContingencyOutcome(m_index); 
 }
 
 void TablePureStrategyProfileRep::SetOutcome(GameOutcome p_outcome)
 {
-  dynamic_cast<GameTableRep &>(*m_nfg).m_results[m_index] = p_outcome; 
+  if (m_nfg->IsFrozen())  throw FrozenGameException();
+  dynamic_cast<GameTableRep &>(*m_nfg).m_results.Set(m_index, 
+							(p_outcome) ? p_outcome->GetNumber() : 0);
 }
 
 Rational TablePureStrategyProfileRep::GetPayoff(int pl) const
 {
-  GameOutcomeRep *outcome = dynamic_cast<GameTableRep &>(*m_nfg).m_results[m_index];
+  GameOutcomeRep *outcome = dynamic_cast<GameTableRep &>(*m_nfg).GetContingencyOutcome(m_index);
   if (outcome) {
     return outcome->GetPayoff<Rational>(pl);
   }
@@ -105,7 +109,7 @@ Rational
 TablePureStrategyProfileRep::GetStrategyValue(const GameStrategy &p_strategy) const
 {
   int player = p_strategy->GetPlayer()->GetNumber();
-  GameOutcomeRep *outcome = dynamic_cast<GameTableRep &>(*m_nfg).m_results[m_index - m_profile[player]->m_offset + p_strategy->m_offset];
+  GameOutcomeRep *outcome = dynamic_cast<GameTableRep &>(*m_nfg).GetContingencyOutcome(m_index - m_profile[player]->m_offset + p_strategy->m_offset);
   if (outcome) {
     return outcome->GetPayoff<Rational>(player);
   }
@@ -121,27 +125,76 @@ PureStrategyProfile GameTableRep::NewPureStrategyProfile(void) const
 
 
 
+//------------------------------------------------------------------------
+//                    class OutcomeIdArray
+//------------------------------------------------------------------------
+
+void OutcomeIdArray::Swap(OutcomeIdArray &p_other)
+{
+  std::swap(m_length, p_other.m_length);
+  std::swap(m_width, p_other.m_width);
+  std::swap(m_buffer, p_other.m_buffer);
+}
+
+void OutcomeIdArray::Reserve(unsigned int p_maxId)
+{
+  int width = (p_maxId <= 0xffu) ? 1 : ((p_maxId <= 0xffffu) ? 2 : 4);
+  if (width <= m_width)  return;
+
+  OutcomeIdArray wider(0);
+  delete wider.m_buffer;
+  wider.m_buffer = new MappedBuffer(m_length * width);
+  wider.m_length = m_length;
+  wider.m_width = width;
+  m_buffer->Advise(0, m_length * m_width, MappedBuffer::accessSequential);
+  for (ContingencyIndex i = 1; i <= m_length; i++) {
+    wider.Set(i, (*this)[i]);
+  }
+  Swap(wider);
+}
+
+void OutcomeIdArray::Remove(unsigned int p_id)
+{
+  Advise(1, m_length, MappedBuffer::accessSequential);
+  for (ContingencyIndex i = 1; i <= m_length; i++) {
+    unsigned int id = (*this)[i];
+    if (id == p_id) {
+      Set(i, 0);
+    }
+    else if (id > p_id) {
+      Set(i, id - 1);
+    }
+  }
+  Advise(1, m_length, MappedBuffer::accessNormal);
+}
+
 //------------------------------------------------------------------------
 //                     GameTableRep: Lifecycle
 //------------------------------------------------------------------------
 
-namespace {
-/// This convenience function computes the Cartesian product of the
-/// elements in dim.
-int Product(const Array<int> &dim)
+ContingencyIndex GameTableRep::CountContingencies(const Array<int> &p_dim)
 {
-  int accum = 1;
-  for (int i = 1; i <= dim.Length(); accum *= dim[i++]);
+  // The outcome numbers of all contingencies, at up to four bytes each,
+  // must be addressable
+  const ContingencyIndex limit = (ContingencyIndex) 
+    ((size_t) -1 / sizeof(unsigned int));
+  ContingencyIndex accum = 1;
+  for (int i = 1; i <= p_dim.Length(); i++) {
+    accum = MultiplyContingencies(accum, p_dim[i], limit);
+  }
   return accum;
 }
 
-} // end anonymous namespace
-
-  
 GameTableRep::GameTableRep(const Array<int> &dim, 
 			   bool p_sparseOutcomes /* = false */)
 {
-  m_results = Array<GameOutcomeRep *>(Product(dim));
+  ContingencyIndex size = CountContingencies(dim);
+  if (!p_sparseOutcomes && size > INT_MAX) {
+    // There would be an outcome for each contingency, but outcomes
+    // are numbered by int
+    throw ContingencyOverflowException();
+  }
+  OutcomeIdArray(size).Swap(m_results);
   for (int pl = 1; pl <= dim.Length(); pl++)  {
     m_players.Append(new GamePlayerRep(this, pl, dim[pl]));
     m_players[pl]->m_label = lexical_cast<std::string>(pl);
@@ -151,16 +204,13 @@ GameTableRep::GameTableRep(const Array<int> &dim,
   }
   IndexStrategies();
 
-  if (p_sparseOutcomes) {
-    for (int cont = 1; cont <= m_results.Length();
-	 m_results[cont++] = 0);
-  }
-  else {
+  if (!p_sparseOutcomes) {
     m_outcomes = Array<GameOutcomeRep *>(m_results.Length());
+    m_results.Reserve(m_results.Length());
     for (int i = 1; i <= m_outcomes.Length(); i++) {
       m_outcomes[i] = new GameOutcomeRep(this, i);
+      m_results.Set(i, i);
     }
-    m_results = m_outcomes;
   }
 }
 
@@ -200,6 +250,72 @@ bool GameTableRep::IsConstSum(void) const
   return true;
 }
 
+namespace {
+
+Rational GetTablePayoff(const GameOutcome &p_outcome, int pl)
+{
+  return (p_outcome) ? p_outcome->GetPayoff<Rational>(pl) : Rational(0);
+}
+
+}  // end anonymous namespace
+
+bool GameTableRep::IsSymmetric(void) const
+{
+  int n = m_players.Length();
+  if (n < 2) {
+    return true;
+  }
+  int m = m_players[1]->NumStrategies();
+  for (int pl = 2; pl <= n; pl++) {
+    if (m_players[pl]->NumStrategies() != m) {
+      return false;
+    }
+  }
+
+  // The transposition of the first two players and the cycle of all
+  // of them generate the symmetric group, so it suffices to check that
+  // each of these two permutations maps the payoffs onto themselves.
+  // Under a permutation p, player i's payoff in a contingency s must
+  // equal player p(i)'s payoff in the contingency where p(i) plays s_i.
+  Array<int> strategy(n), permuted(n);
+  for (int gen = 1; gen <= ((n > 2) ? 2 : 1); gen++) {
+    Array<int> perm(n);
+    for (int pl = 1; pl <= n; pl++) {
+      perm[pl] = (gen == 1) ? pl : (pl % n) + 1;
+    }
+    if (gen == 1) {
+      perm[1] = 2;
+      perm[2] = 1;
+    }
+
+    for (int pl = 1; pl <= n; strategy[pl++] = 0);
+    for (ContingencyIndex index = 1; index <= m_results.Length(); index++) {
+      // Strategies are indexed with the first player varying fastest
+      ContingencyIndex pindex = 1, offset = 1;
+      for (int pl = 1; pl <= n; pl++) {
+	permuted[perm[pl]] = strategy[pl];
+      }
+      for (int pl = 1; pl <= n; pl++, offset *= m) {
+	pindex += permuted[pl] * offset;
+      }
+
+      GameOutcome outcome = GetContingencyOutcome(index), poutcome = GetContingencyOutcome(pindex);
+      for (int pl = 1; pl <= n; pl++) {
+	if (GetTablePayoff(outcome, pl) != GetTablePayoff(poutcome, perm[pl])) {
+	  return false;
+	}
+      }
+
+      for (int pl = 1; pl <= n; pl++) {
+	if (++strategy[pl] < m) break;
+	strategy[pl] = 0;
+      }
+    }
+  }
+
+  return true;
+}
+
 //------------------------------------------------------------------------
 //                   GameTableRep: Writing data files
 //------------------------------------------------------------------------
@@ -242,11 +358,6 @@ void GameTableRep::WriteNfgFile(std::ostream &p_file) const
 
   p_file << "\"" << EscapeQuotes(m_comment) << "\"\n\n";
 
-  int ncont = 1;
-  for (int i = 1; i <= NumPlayers(); i++) {
-    ncont *= m_players[i]->m_strategies.Length();
-  }
-
   p_file << "{\n";
   for (int outc = 1; outc <= m_outcomes.Length(); outc++)   {
     p_file << "{ \"" << EscapeQuotes(m_outcomes[outc]->m_label) << "\" ";
@@ -263,13 +374,8 @@ void GameTableRep::WriteNfgFile(std::ostream &p_file) const
   }
   p_file << "}\n";
   
-  for (int cont = 1; cont <= ncont; cont++)  {
-    if (m_results[cont] != 0) {
-      p_file << m_results[cont]->m_number << ' ';
-    }
-    else {
-      p_file << "0 ";
-    }
+  for (ContingencyIndex cont = 1; cont <= m_results.Length(); cont++)  {
+    p_file << m_results[cont] << ' ';
   }
 
   p_file << '\n';
@@ -281,6 +387,7 @@ void GameTableRep::WriteNfgFile(std::ostream &p_file) const
 
 GamePlayer GameTableRep::NewPlayer(void)
 {
+  if (m_frozen)  throw FrozenGameException();
   GamePlayerRep *player = 0;
   player = new GamePlayerRep(this, m_players.Length() + 1, 1);
   m_players.Append(player);
@@ -297,11 +404,8 @@ GamePlayer GameTableRep::NewPlayer(void)
 
 void GameTableRep::DeleteOutcome(const GameOutcome &p_outcome)
 {
-  for (int i = 1; i <= m_results.Length(); i++) {
-    if (m_results[i] == p_outcome) {
-      m_results[i] = 0;
-    }
-  }
+  if (m_frozen)  throw FrozenGameException();
+  m_results.Remove(p_outcome->m_number);
   m_outcomes.Remove(m_outcomes.Find(p_outcome))->Invalidate();
   for (int outc = 1; outc <= m_outcomes.Length(); outc++) {
     m_outcomes[outc]->m_number = outc;
@@ -341,23 +445,25 @@ MixedStrategyProfile<Rational> GameTableRep::NewMixedStrategyProfile(const Ratio
 /// numbered -1 are identified as the new strategies.
 void GameTableRep::RebuildTable(void)
 {
-  long size = 1L;
-  Array<long> offsets(m_players.Length());
+  // GamePlayerRep::NewStrategy() has checked that the new size can
+  // be represented
+  ContingencyIndex size = 1;
+  Array<ContingencyIndex> offsets(m_players.Length());
   for (int pl = 1; pl <= m_players.Length(); pl++) {
     offsets[pl] = size;
     size *= m_players[pl]->NumStrategies();
   }
 
-  Array<GameOutcomeRep *> newResults(size);
-  for (int i = 1; i <= newResults.Length(); newResults[i++] = 0);
+  OutcomeIdArray newResults(size);
+  newResults.Reserve(m_results.MaxId());
 
   for (StrategyProfileIterator iter(StrategySupportProfile(const_cast<GameTableRep *>(this)));
        !iter.AtEnd(); iter++) {
-    long newindex = 1L;
+    ContingencyIndex newindex = 1;
     for (int pl = 1; pl <= m_players.Length(); pl++) {
       if (iter.m_profile->GetStrategy(pl)->m_offset < 0) {
 	// This is a contingency involving a new strategy... skip
-	newindex = -1L;
+	newindex = -1;
 	break;
       }
       else {
@@ -366,18 +472,18 @@ void GameTableRep::RebuildTable(void)
     }
 
     if (newindex >= 1) {
-      newResults[newindex] = m_results[iter.m_profile->GetIndex()];
+      newResults.Set(newindex, m_results[iter.m_profile->GetIndex()]);
     }
   }
 
-  m_results = newResults;
+  m_results.Swap(newResults);
 
   IndexStrategies();
 }
 
 void GameTableRep::IndexStrategies(void)
 {
-  long offset = 1L;
+  ContingencyIndex offset = 1;
   for (GamePlayers::const_iterator player = m_players.begin();
        player != m_players.end(); ++player)  {
     int st = 1;
@@ -24,9 +24,97 @@
 #define GAMETABLE_H
 
 #include "gameexpl.h"
+#include "mapped.h"
 
 namespace Gambit {
 
+//
+// The outcome of each contingency of a table game, stored as the
+// number of the outcome (zero for none).  Generated games often repeat
+// a few outcomes over very many contingencies, so the numbers are kept
+// in the narrowest of 8, 16 or 32 bits which holds them all; the array
+// widens itself when a larger number is stored.  The numbers are held
+// in a MappedBuffer, so the tables of very large games are paged to
+// disk rather than held in memory.
+//
+class OutcomeIdArray {
+private:
+  ContingencyIndex m_length;
+  int m_width;
+  MappedBuffer *m_buffer;
+
+  OutcomeIdArray(const OutcomeIdArray &);
+  OutcomeIdArray &operator=(const OutcomeIdArray &);
+
+public:
+  /// @name Lifecycle
+  //@{
+  /// Creates an array of p_length entries, all zero
+  explicit OutcomeIdArray(ContingencyIndex p_length = 0)
+    : m_length(p_length), m_width(1), m_buffer(new MappedBuffer(p_length)) { }
+  ~OutcomeIdArray()  { delete m_buffer; }
+
+  /// Exchanges the contents of the arrays
+  void Swap(OutcomeIdArray &);
+  //@}
+
+  /// @name Data access
+  //@{
+  /// Returns the number of entries
+  ContingencyIndex Length(void) const { return m_length; }
+  /// Returns the number of bytes used for each entry
+  int Width(void) const { return m_width; }
+  /// Returns the largest number which can be stored without widening
+  unsigned int MaxId(void) const
+  { return (m_width == 1) ? 0xffu : ((m_width == 2) ? 0xffffu : 0xffffffffu); }
+
+  /// Returns the p_index'th entry (numbered from one)
+  unsigned int operator[](ContingencyIndex p_index) const
+  {
+    const char *data = m_buffer->GetData();
+    switch (m_width) {
+    case 1:  
+      return reinterpret_cast<const unsigned char *>(data)[p_index - 1];
+    case 2:  
+      return reinterpret_cast<const unsigned short *>(data)[p_index - 1];
+    default:  
+      return reinterpret_cast<const unsigned int *>(data)[p_index - 1];
+    }
+  }
+  /// Sets the p_index'th entry, widening the array if needed
+  void Set(ContingencyIndex p_index, unsigned int p_id)
+  {
+    if (p_id > MaxId())  Reserve(p_id);
+    char *data = m_buffer->GetData();
+    switch (m_width) {
+    case 1:  
+      reinterpret_cast<unsigned char *>(data)[p_index - 1] = p_id;  
+      break;
+    case 2:  
+      reinterpret_cast<unsigned short *>(data)[p_index - 1] = p_id;  
+      break;
+    default:  
+      reinterpret_cast<unsigned int *>(data)[p_index - 1] = p_id;  
+      break;
+    }
+  }
+
+  /// Hints how the p_count entries from the p_index'th will be used
+  void Advise(ContingencyIndex p_index, ContingencyIndex p_count,
+	      MappedBuffer::Access p_access) const
+  { m_buffer->Advise((p_index - 1) * m_width, p_count * m_width, p_access); }
+  //@}
+
+  /// @name Maintenance
+  //@{
+  /// Widens the array, if needed, so that it can store p_maxId
+  void Reserve(unsigned int p_maxId);
+  /// Sets entries equal to p_id to zero, and decrements larger ones,
+  /// as when outcome p_id is deleted and the later ones renumbered
+  void Remove(unsigned int p_id);
+  //@}
+};
+
 class GameTableRep : public GameExplicitRep {
   friend class StrategySupportProfile;
   friend class GamePlayerRep;
@@ -35,7 +123,7 @@ class GameTableRep : public GameExplicitRep {
   template <class T> friend class MixedStrategyProfile;
   template <class T> friend class TableMixedStrategyProfileRep;
 private:
-  Array<GameOutcomeRep *> m_results;
+  OutcomeIdArray m_results;
   Game m_unrestricted;
 
   /// @name Private auxiliary functions
@@ -51,12 +139,18 @@ public:
   /// If p_sparseOutcomes = true, outcomes for all contingencies are left null
   GameTableRep(const Array<int> &p_dim, bool p_sparseOutcomes = false);
   virtual Game Copy(void) const;
+
+  /// Returns the number of contingencies of a table with the given
+  /// dimension, throwing ContingencyOverflowException if it cannot
+  /// be indexed or stored
+  static ContingencyIndex CountContingencies(const Array<int> &p_dim);
   //@}
 
   /// @name General data access
   //@{
   virtual bool IsTree(void) const { return false; }
   virtual bool IsConstSum(void) const;
+  virtual bool IsSymmetric(void) const;
   virtual bool IsPerfectRecall(GameInfoset &, GameInfoset &) const
   { return true; }
   //@}
@@ -116,6 +210,24 @@ public:
   virtual void DeleteOutcome(const GameOutcome &);
   //@}
 
+  /// @name Direct access to the table of outcomes
+  //@{
+  /// Returns the amount the strategy adds to the index of a contingency.
+  /// The index of a contingency, as returned by 
+  /// PureStrategyProfileRep::GetIndex(), is one plus the sum of these.
+  ContingencyIndex GetStrategyOffset(const GameStrategy &p_strategy) const
+  { return p_strategy->m_offset; }
+  /// Returns the outcome of the contingency with the given index
+  GameOutcome GetContingencyOutcome(ContingencyIndex p_index) const
+  { unsigned int id = m_results[p_index]; return (id) ? m_outcomes[id] : 0; }
+  /// Returns the number of the outcome of the contingency with the
+  /// given index, or zero if it has none
+  unsigned int GetOutcomeNumber(ContingencyIndex p_index) const { return m_results[p_index]; }
+  /// Returns the numbers of the outcomes of all the contingencies, for
+  /// algorithms which scan through them in order
+  const OutcomeIdArray &GetOutcomeNumbers(void) const { return m_results; }
+  //@}
+
   /// @name Writing data files
   //@{
   virtual void WriteNfgFile(std::ostream &) const;
@@ -49,6 +49,7 @@ bool GameTreeActionRep::Precedes(const GameNode &n) const
 
 void GameTreeActionRep::DeleteAction(void)
 {
+  if (m_infoset->m_efg->IsFrozen())  throw FrozenGameException();
   if (m_infoset->NumActions() == 1) throw UndefinedException();
 
   int where;
@@ -101,6 +102,7 @@ Game GameTreeInfosetRep::GetGame(void) const { return m_efg; }
 
 void GameTreeInfosetRep::SetPlayer(GamePlayer p_player)
 {
+  if (m_efg->IsFrozen())  throw FrozenGameException();
   if (p_player->GetGame() != m_efg) throw MismatchException();
   if (m_player->IsChance() || p_player->IsChance()) throw UndefinedException();
   if (m_player == p_player) return;
@@ -129,6 +131,7 @@ bool GameTreeInfosetRep::Precedes(GameNode p_node) const
 
 GameAction GameTreeInfosetRep::InsertAction(GameAction p_action /* =0 */)
 {
+  if (m_efg->IsFrozen())  throw FrozenGameException();
   if (p_action && p_action->GetInfoset() != this) throw MismatchException();
   
   int where = m_actions.Length() + 1;
@@ -170,6 +173,7 @@ void GameTreeInfosetRep::RemoveAction(int which)
 
 void GameTreeInfosetRep::SetActionProb(int act, const std::string &p_value)
 {
+  if (m_efg->IsFrozen())  throw FrozenGameException();
   m_probs[act] = p_value;
   m_efg->ClearComputedValues();
 }
@@ -188,6 +192,7 @@ void GameTreeInfosetRep::RemoveMember(GameTreeNodeRep *p_node)
 
 void GameTreeInfosetRep::Reveal(GamePlayer p_player)
 {
+  if (m_efg->IsFrozen())  throw FrozenGameException();
   for (int act = 1; act <= m_actions.Length(); act++) {
     GameActionRep *action = m_actions[act];
     for (int iset = 1; iset <= p_player->m_infosets.Length(); iset++) {
@@ -285,6 +290,7 @@ void GameTreeNodeRep::DeleteOutcome(GameOutcomeRep *outc)
 
 void GameTreeNodeRep::SetOutcome(const GameOutcome &p_outcome)
 {
+  if (m_efg->IsFrozen())  throw FrozenGameException();
   if (p_outcome != outcome) {
     outcome = p_outcome;
     m_efg->ClearComputedValues();
@@ -328,6 +334,7 @@ bool GameTreeNodeRep::IsSubgameRoot(void) const
 
 void GameTreeNodeRep::DeleteParent(void)
 {
+  if (m_efg->IsFrozen())  throw FrozenGameException();
   if (!m_parent) return;
   GameTreeNodeRep *oldParent = m_parent;
 
@@ -348,6 +355,7 @@ void GameTreeNodeRep::DeleteParent(void)
 
 void GameTreeNodeRep::DeleteTree(void)
 {
+  if (m_efg->IsFrozen())  throw FrozenGameException();
   while (children.Length() > 0) {
     children[1]->DeleteTree();
     children[1]->Invalidate();
@@ -385,6 +393,7 @@ void GameTreeNodeRep::CopySubtree(GameTreeNodeRep *src, GameTreeNodeRep *stop)
 
 void GameTreeNodeRep::CopyTree(GameNode p_src)
 {
+  if (m_efg->IsFrozen())  throw FrozenGameException();
   if (p_src->GetGame() != m_efg) throw MismatchException();
   if (p_src == this || children.Length() > 0) return;
 
@@ -403,6 +412,7 @@ void GameTreeNodeRep::CopyTree(GameNode p_src)
 
 void GameTreeNodeRep::MoveTree(GameNode p_src)
 {
+  if (m_efg->IsFrozen())  throw FrozenGameException();
   if (p_src->GetGame() != m_efg) throw MismatchException();
   if (p_src == this || children.Length() > 0 || IsSuccessorOf(p_src)) {
     return;
@@ -441,6 +451,7 @@ Game GameTreeNodeRep::CopySubgame(void) const
 
 void GameTreeNodeRep::SetInfoset(GameInfoset p_infoset)
 {
+  if (m_efg->IsFrozen())  throw FrozenGameException();
   if (p_infoset->GetGame() != m_efg) throw MismatchException();
   if (!infoset || infoset == p_infoset) return;
   if (p_infoset->NumActions() != children.Length()) 
@@ -456,6 +467,7 @@ void GameTreeNodeRep::SetInfoset(GameInfoset p_infoset)
 
 GameInfoset GameTreeNodeRep::LeaveInfoset(void)
 {
+  if (m_efg->IsFrozen())  throw FrozenGameException();
   if (!infoset) return 0;
 
   GameTreeInfosetRep *oldInfoset = infoset;
@@ -477,6 +489,7 @@ GameInfoset GameTreeNodeRep::LeaveInfoset(void)
 
 GameInfoset GameTreeNodeRep::AppendMove(GamePlayer p_player, int p_actions)
 {
+  if (m_efg->IsFrozen())  throw FrozenGameException();
   if (p_actions <= 0 || children.Length() > 0) throw UndefinedException();
   if (p_player->GetGame() != m_efg) throw MismatchException();
 
@@ -487,6 +500,7 @@ GameInfoset GameTreeNodeRep::AppendMove(GamePlayer p_player, int p_actions)
 
 GameInfoset GameTreeNodeRep::AppendMove(GameInfoset p_infoset)
 {
+  if (m_efg->IsFrozen())  throw FrozenGameException();
   if (children.Length() > 0) throw UndefinedException();
   if (p_infoset->GetGame() != m_efg) throw MismatchException();
   
@@ -503,6 +517,7 @@ GameInfoset GameTreeNodeRep::AppendMove(GameInfoset p_infoset)
   
 GameInfoset GameTreeNodeRep::InsertMove(GamePlayer p_player, int p_actions)
 {
+  if (m_efg->IsFrozen())  throw FrozenGameException();
   if (p_actions <= 0) throw UndefinedException();
   if (p_player->GetGame() != m_efg) throw MismatchException();
 
@@ -513,6 +528,7 @@ GameInfoset GameTreeNodeRep::InsertMove(GamePlayer p_player, int p_actions)
 
 GameInfoset GameTreeNodeRep::InsertMove(GameInfoset p_infoset)
 {
+  if (m_efg->IsFrozen())  throw FrozenGameException();
   if (p_infoset->GetGame() != m_efg) throw MismatchException();
 
   GameTreeNodeRep *newNode = new GameTreeNodeRep(m_efg, m_parent);
@@ -681,6 +697,20 @@ void GameTreeRep::NumberNodes(GameTreeNodeRep *n, int &index)
        NumberNodes(n->children[child++], index));
 } 
 
+void GameTreeRep::ShareNodes(GameTreeNodeRep *n)
+{
+  n->Share();
+  for (int child = 1; child <= n->children.Length();
+       ShareNodes(n->children[child++]));
+}
+
+void GameTreeRep::PrepareForThreads(void)
+{
+  GameExplicitRep::PrepareForThreads();
+  m_chance->ShareObjects();
+  ShareNodes(m_root);
+}
+
 void GameTreeRep::Canonicalize(void)
 {
   int nodeindex = 1;
@@ -970,6 +1000,7 @@ int GameTreeRep::BehavProfileLength(void) const
 
 GamePlayer GameTreeRep::NewPlayer(void)
 {
+  if (m_frozen)  throw FrozenGameException();
   GamePlayerRep *player = 0;
   player = new GamePlayerRep(this, m_players.Length() + 1);
   m_players.Append(player);
@@ -1031,6 +1062,7 @@ GameAction GameTreeRep::GetAction(int p_index) const
 
 void GameTreeRep::DeleteOutcome(const GameOutcome &p_outcome)
 {
+  if (m_frozen)  throw FrozenGameException();
   m_root->DeleteOutcome(p_outcome);
   m_outcomes.Remove(m_outcomes.Find(p_outcome))->Invalidate();
   for (int outc = 1; outc <= m_outcomes.Length(); outc++) {
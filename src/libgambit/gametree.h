@@ -208,6 +208,7 @@ protected:
   /// @name Private auxiliary functions
   //@{
   void NumberNodes(GameTreeNodeRep *, int &);
+  void ShareNodes(GameTreeNodeRep *);
   //@}
 
   /// @name Managing the representation
@@ -217,6 +218,7 @@ protected:
   virtual void ClearComputedValues(void) const;
   /// Have computed values been built?
   virtual bool HasComputedValues(void) const { return m_computedValues; }
+  virtual void PrepareForThreads(void);
   //@}
 
 public: 
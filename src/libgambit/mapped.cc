@@ -0,0 +1,133 @@
+//
+// This file is part of Gambit
+// Copyright (c) 1994-2014, The Gambit Project (http://www.gambit-project.org)
+//
+// FILE: src/libgambit/mapped.cc
+// Large buffers which can be paged out to disk
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+//
+
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <new>
+#include "mapped.h"
+
+#ifdef HAVE_SYS_MMAN_H
+#include <sys/mman.h>
+#include <unistd.h>
+#endif  // HAVE_SYS_MMAN_H
+
+namespace Gambit {
+
+size_t MappedBuffer::s_threshold = 256 * 1024 * 1024;
+
+#ifdef HAVE_SYS_MMAN_H
+
+namespace {
+
+/// Creates an unlinked temporary file of p_size bytes, returning its
+/// descriptor, or -1 if that cannot be done
+int CreateBackingFile(size_t p_size)
+{
+  const char *dir = getenv("TMPDIR");
+  std::string name = std::string((dir && *dir) ? dir : "/tmp") +
+    "/gambit-XXXXXX";
+  char *buffer = new char[name.length() + 1];
+  strcpy(buffer, name.c_str());
+  int file = mkstemp(buffer);
+  if (file >= 0) {
+    // The file disappears from the directory now, and from the disk
+    // when it is closed, even if the program does not exit cleanly
+    unlink(buffer);
+    if (ftruncate(file, (off_t) p_size) != 0) {
+      close(file);
+      file = -1;
+    }
+  }
+  delete [] buffer;
+  return file;
+}
+
+}  // end anonymous namespace
+
+#endif  // HAVE_SYS_MMAN_H
+
+MappedBuffer::MappedBuffer(size_t p_size)
+  : m_data(0), m_size(p_size), m_mapped(false), m_file(-1)
+{
+#ifdef HAVE_SYS_MMAN_H
+  if (p_size > 0 && p_size >= s_threshold) {
+    m_file = CreateBackingFile(p_size);
+    if (m_file >= 0) {
+      void *data = mmap(0, p_size, PROT_READ | PROT_WRITE, MAP_SHARED,
+			m_file, 0);
+      if (data != MAP_FAILED) {
+	m_data = static_cast<char *>(data);
+	m_mapped = true;
+	return;
+      }
+      close(m_file);
+      m_file = -1;
+    }
+  }
+#endif  // HAVE_SYS_MMAN_H
+
+  // Either the buffer is small, or it could not be mapped
+  if (p_size > 0) {
+    m_data = static_cast<char *>(calloc(p_size, 1));
+    if (!m_data)  throw std::bad_alloc();
+  }
+}
+
+MappedBuffer::~MappedBuffer()
+{
+#ifdef HAVE_SYS_MMAN_H
+  if (m_mapped) {
+    munmap(m_data, m_size);
+    close(m_file);
+    return;
+  }
+#endif  // HAVE_SYS_MMAN_H
+  free(m_data);
+}
+
+void MappedBuffer::Advise(size_t p_offset, size_t p_size,
+			  Access p_access) const
+{
+#ifdef HAVE_SYS_MMAN_H
+  if (!m_mapped || p_offset >= m_size)  return;
+  if (p_size > m_size - p_offset)  p_size = m_size - p_offset;
+
+  // madvise() requires the start of the range to be on a page boundary
+  size_t page = sysconf(_SC_PAGESIZE);
+  size_t start = p_offset - p_offset % page;
+  p_size += p_offset - start;
+
+  int advice;
+  switch (p_access) {
+  case accessSequential:  advice = MADV_SEQUENTIAL;  break;
+  case accessRandom:  advice = MADV_RANDOM;  break;
+  case accessWillNeed:  advice = MADV_WILLNEED;  break;
+  case accessDontNeed:  advice = MADV_DONTNEED;  break;
+  default:  advice = MADV_NORMAL;  break;
+  }
+  // This is only a hint, so failure is of no consequence
+  madvise(m_data + start, p_size, advice);
+#endif  // HAVE_SYS_MMAN_H
+}
+
+}  // end namespace Gambit
@@ -0,0 +1,98 @@
+//
+// This file is part of Gambit
+// Copyright (c) 1994-2014, The Gambit Project (http://www.gambit-project.org)
+//
+// FILE: src/libgambit/mapped.h
+// Large buffers which can be paged out to disk
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+//
+
+#ifndef LIBGAMBIT_MAPPED_H
+#define LIBGAMBIT_MAPPED_H
+
+#include <config.h>
+#include <cstddef>
+
+namespace Gambit {
+
+//
+// A block of memory, initially zero, for data which may be larger than
+// the memory of the machine, such as the outcomes of the contingencies
+// of a very large table.  Buffers of at least GetThreshold() bytes are
+// mapped from an unlinked temporary file (in $TMPDIR, or /tmp), so
+// that the system can write their pages out to the file and read them
+// back as they are used, rather than to swap.  Smaller buffers, and all
+// buffers where memory mapping is not available, are allocated on the
+// heap.
+//
+// The contents of a mapped buffer are read a page at a time; Advise()
+// passes hints on the order in which they will be read to the system,
+// so that it can read ahead of a scan and drop pages behind it.
+//
+class MappedBuffer {
+public:
+  /// How a range of the buffer is about to be used
+  enum Access {
+    accessNormal = 0,
+    accessSequential,
+    accessRandom,
+    accessWillNeed,
+    accessDontNeed
+  };
+
+private:
+  char *m_data;
+  size_t m_size;
+  bool m_mapped;
+  int m_file;
+
+  static size_t s_threshold;
+
+  MappedBuffer(const MappedBuffer &);
+  MappedBuffer &operator=(const MappedBuffer &);
+
+public:
+  /// @name Lifecycle
+  //@{
+  /// Allocates a buffer of p_size bytes, all zero
+  explicit MappedBuffer(size_t p_size);
+  ~MappedBuffer();
+  //@}
+
+  /// @name Data access
+  //@{
+  char *GetData(void) const { return m_data; }
+  size_t GetSize(void) const { return m_size; }
+  /// Returns true if the buffer is mapped from a file
+  bool IsMapped(void) const { return m_mapped; }
+
+  /// Hints how the p_size bytes from p_offset will be used.  This
+  /// does nothing for buffers on the heap.
+  void Advise(size_t p_offset, size_t p_size, Access p_access) const;
+  //@}
+
+  /// @name Settings
+  //@{
+  /// Returns the size from which buffers are mapped (256 MB by default)
+  static size_t GetThreshold(void) { return s_threshold; }
+  /// Sets the size from which buffers are mapped
+  static void SetThreshold(size_t p_threshold) { s_threshold = p_threshold; }
+  //@}
+};
+
+}  // end namespace Gambit
+
+#endif  // LIBGAMBIT_MAPPED_H
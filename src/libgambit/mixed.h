@@ -26,6 +26,7 @@
 #include "vector.h"
 #include "gameagg.h"
 #include "gamebagg.h"
+#include "stats.h"
 
 namespace Gambit {
 
@@ -75,13 +76,14 @@ private:
   /// @name Private recursive payoff functions
   //@{
   /// Recursive computation of payoff to player pl
-  T GetPayoff(int pl, int index, int i) const;
+  T GetPayoff(int pl, ContingencyIndex index, int i) const;
   /// Recursive computation of payoff derivative
-  void GetPayoffDeriv(int pl, int const_pl, int cur_pl, long index,
-		      const T &prob, T &value) const;
+  void GetPayoffDeriv(int pl, int const_pl, int cur_pl, 
+		      ContingencyIndex index, const T &prob, T &value) const;
   /// Recursive computation of payoff second derivative
   void GetPayoffDeriv(int pl, int const_pl1, int const_pl2, 
-		      int cur_pl, long index, const T &prob, T &value) const;
+		      int cur_pl, ContingencyIndex index, const T &prob, 
+		      T &value) const;
   //@}
 
 public:
@@ -229,7 +231,12 @@ public:
   /// @name Computation of interesting quantities
   //@{
   /// Computes the payoff of the profile to player 'pl'
-  T GetPayoff(int pl) const { return m_rep->GetPayoff(pl); }
+  T GetPayoff(int pl) const
+  {
+    GAMBIT_STATS_TIMER(statsSectionPayoff);
+    GAMBIT_STATS_COUNT(statsPayoffEvaluations);
+    return m_rep->GetPayoff(pl);
+  }
 
   /// Computes the payoff of the profile to the player
   T GetPayoff(const GamePlayer &p_player) const
@@ -240,14 +247,22 @@ public:
   /// Computes the derivative of the payoff to the player with respect
   /// to the probability the strategy is played
   T GetPayoffDeriv(int pl, const GameStrategy &s) const
-  { return m_rep->GetPayoffDeriv(pl, s); }
+  {
+    GAMBIT_STATS_TIMER(statsSectionPayoff);
+    GAMBIT_STATS_COUNT(statsPayoffEvaluations);
+    return m_rep->GetPayoffDeriv(pl, s);
+  }
   
   /// \brief Computes the second derivative of the player's payoff
   ///
   /// Computes the second derivative of the payoff to the player,
   /// with respect to the probabilities with which the strategies are played
   T GetPayoffDeriv(int pl, const GameStrategy &s1, const GameStrategy &s2) const
-  { return m_rep->GetPayoffDeriv(pl, s1, s2); }
+  {
+    GAMBIT_STATS_TIMER(statsSectionPayoff);
+    GAMBIT_STATS_COUNT(statsPayoffEvaluations);
+    return m_rep->GetPayoffDeriv(pl, s1, s2);
+  }
 
   /// Computes the payoff to playing the pure strategy against the profile
   T GetPayoff(const GameStrategy &p_strategy) const
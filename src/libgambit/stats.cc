@@ -0,0 +1,183 @@
+//
+// This file is part of Gambit
+// Copyright (c) 1994-2014, The Gambit Project (http://www.gambit-project.org)
+//
+// FILE: src/libgambit/stats.cc
+// Counters and timers for the hot paths of the solvers
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+//
+
+#include <cstdlib>
+#include <vector>
+#include <sys/time.h>
+#include "libgambit.h"
+#include "thread.h"
+#include "stats.h"
+
+#ifdef HAVE_SYS_RESOURCE_H
+#include <sys/resource.h>
+#endif  // HAVE_SYS_RESOURCE_H
+
+namespace Gambit {
+
+// The names in the reports, in the order of the enumerations
+static const char *s_counterNames[statsNumCounters] = {
+  "payoff_evaluations",
+  "pivots",
+  "refactorizations",
+  "bfs_comparisons",
+  "path_steps",
+  "corrector_iterations",
+  "jacobians",
+  "qr_decompositions",
+  "subdivisions",
+  "cache_hits",
+  "cache_misses"
+};
+
+static const char *s_sectionNames[statsNumSections] = {
+  "payoff",
+  "jacobian",
+  "qr",
+  "refactor",
+  "subdivision"
+};
+
+bool g_statsEnabled = false;
+
+// The blocks of all threads which have recorded anything.  Blocks
+// outlive their threads, so that nothing is lost from the report.
+static Mutex s_blocksMutex;
+static std::vector<StatsBlock *> s_blocks;
+static ThreadLocalPointer s_threadBlock;
+
+static std::string s_reportFormat;
+
+StatsBlock::StatsBlock(void)
+{
+  for (int i = 0; i < statsNumCounters; i++)  m_counts[i] = 0;
+  for (int i = 0; i < statsNumSections; i++)  m_seconds[i] = 0.0;
+}
+
+StatsBlock &GetStatsBlock(void)
+{
+  StatsBlock *block = static_cast<StatsBlock *>(s_threadBlock.Get());
+  if (!block) {
+    block = new StatsBlock;
+    s_threadBlock.Set(block);
+    MutexLock lock(s_blocksMutex);
+    s_blocks.push_back(block);
+  }
+  return *block;
+}
+
+double GetStatsClock(void)
+{
+  struct timeval now;
+  gettimeofday(&now, 0);
+  return now.tv_sec + now.tv_usec * 1.0e-6;
+}
+
+// Peak resident memory of the process in kilobytes, or zero if unknown
+static long GetPeakMemory(void)
+{
+#ifdef HAVE_SYS_RESOURCE_H
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) == 0) {
+#ifdef __APPLE__
+    // Darwin reports bytes rather than kilobytes
+    return usage.ru_maxrss / 1024;
+#else
+    return usage.ru_maxrss;
+#endif  // __APPLE__
+  }
+#endif  // HAVE_SYS_RESOURCE_H
+  return 0;
+}
+
+void WriteStats(std::ostream &p_stream, const std::string &p_format)
+{
+  StatsBlock total;
+  size_t threads;
+  {
+    MutexLock lock(s_blocksMutex);
+    threads = s_blocks.size();
+    for (size_t j = 0; j < s_blocks.size(); j++) {
+      for (int i = 0; i < statsNumCounters; i++) {
+	total.m_counts[i] += s_blocks[j]->m_counts[i];
+      }
+      for (int i = 0; i < statsNumSections; i++) {
+	total.m_seconds[i] += s_blocks[j]->m_seconds[i];
+      }
+    }
+  }
+
+  if (p_format == "csv") {
+    p_stream << "statistic,value\n";
+    for (int i = 0; i < statsNumCounters; i++) {
+      p_stream << s_counterNames[i] << ',' << total.m_counts[i] << '\n';
+    }
+    for (int i = 0; i < statsNumSections; i++) {
+      p_stream << "seconds_" << s_sectionNames[i] << ','
+	       << total.m_seconds[i] << '\n';
+    }
+    p_stream << "threads," << threads << '\n';
+    p_stream << "peak_memory_kb," << GetPeakMemory() << '\n';
+  }
+  else {
+    p_stream << "{\n  \"counters\": {";
+    for (int i = 0; i < statsNumCounters; i++) {
+      p_stream << ((i > 0) ? "," : "") << "\n    \"" << s_counterNames[i]
+	       << "\": " << total.m_counts[i];
+    }
+    p_stream << "\n  },\n  \"seconds\": {";
+    for (int i = 0; i < statsNumSections; i++) {
+      p_stream << ((i > 0) ? "," : "") << "\n    \"" << s_sectionNames[i]
+	       << "\": " << total.m_seconds[i];
+    }
+    p_stream << "\n  },\n  \"threads\": " << threads;
+    p_stream << ",\n  \"peak_memory_kb\": " << GetPeakMemory() << "\n}\n";
+  }
+  p_stream.flush();
+}
+
+extern "C" void WriteStatsAtExit(void)
+{
+  WriteStats(std::cerr, s_reportFormat);
+}
+
+bool EnableStats(const std::string &p_format)
+{
+  if (p_format != "json" && p_format != "csv") {
+    return false;
+  }
+#ifdef GAMBIT_STATS
+  if (s_reportFormat.empty()) {
+    atexit(WriteStatsAtExit);
+  }
+  s_reportFormat = p_format;
+  g_statsEnabled = true;
+  // The calling thread counts towards the report even if it records
+  // nothing itself
+  GetStatsBlock();
+#else
+  std::cerr << "Warning: statistics were not compiled in; "
+	    << "configure without --disable-stats to record them\n";
+#endif  // GAMBIT_STATS
+  return true;
+}
+
+}  // end namespace Gambit
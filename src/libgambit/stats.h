@@ -0,0 +1,140 @@
+//
+// This file is part of Gambit
+// Copyright (c) 1994-2014, The Gambit Project (http://www.gambit-project.org)
+//
+// FILE: src/libgambit/stats.h
+// Counters and timers for the hot paths of the solvers
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+//
+
+#ifndef LIBGAMBIT_STATS_H
+#define LIBGAMBIT_STATS_H
+
+#include <config.h>
+#include <string>
+#include <iostream>
+
+namespace Gambit {
+
+//
+// The solvers count what they do in their inner loops, and time a few
+// sections of them, through the GAMBIT_STATS_ macros below.  Nothing
+// is recorded until EnableStats() is called, which the tools do for
+// their --stats option; until then each macro costs one test of a
+// flag.  Configuring with --disable-stats leaves GAMBIT_STATS
+// undefined, and the macros then compile to nothing at all.
+//
+// Each thread records into its own StatsBlock, so counting takes no
+// locks.  The blocks are summed when the report is written.
+//
+
+/// The events which are counted
+enum StatsCounter {
+  statsPayoffEvaluations = 0,
+  statsPivots,
+  statsRefactorizations,
+  statsBFSComparisons,
+  statsPathSteps,
+  statsCorrectorIterations,
+  statsJacobians,
+  statsQRDecompositions,
+  statsSubdivisions,
+  statsCacheHits,
+  statsCacheMisses,
+  statsNumCounters
+};
+
+/// The sections whose running time is measured.  Time spent in a
+/// section nested in another counts towards both.
+enum StatsSection {
+  statsSectionPayoff = 0,
+  statsSectionJacobian,
+  statsSectionQR,
+  statsSectionRefactor,
+  statsSectionSubdivision,
+  statsNumSections
+};
+
+/// The counts and times recorded by one thread
+class StatsBlock {
+public:
+  unsigned long m_counts[statsNumCounters];
+  double m_seconds[statsNumSections];
+
+  StatsBlock(void);
+};
+
+/// Whether statistics are being recorded; this is read on every count,
+/// so it is a plain variable rather than a function
+extern bool g_statsEnabled;
+
+/// Returns the block of the calling thread, creating it on first use
+StatsBlock &GetStatsBlock(void);
+
+/// Returns a time in seconds, for measuring intervals
+double GetStatsClock(void);
+
+/// Adds the time from its construction to its destruction to a section
+class StatsTimer {
+private:
+  StatsSection m_section;
+  double m_start;
+
+  StatsTimer(const StatsTimer &);
+  StatsTimer &operator=(const StatsTimer &);
+
+public:
+  explicit StatsTimer(StatsSection p_section)
+    : m_section(p_section), m_start((g_statsEnabled) ? GetStatsClock() : -1.0)
+  { }
+  ~StatsTimer()
+  {
+    if (m_start >= 0.0) {
+      GetStatsBlock().m_seconds[m_section] += GetStatsClock() - m_start;
+    }
+  }
+};
+
+/// The value getopt_long() returns for the --stats option of the tools
+const int STATS_OPTION = 1000;
+
+/// Starts recording, and arranges for a report to be written to the
+/// standard error when the program exits.  The format is "json" or
+/// "csv"; returns false for anything else.  If statistics were
+/// compiled out, writes a warning and records nothing.
+bool EnableStats(const std::string &p_format);
+
+/// Writes the totals over all threads, with the peak memory use of
+/// the process, in the format "json" or "csv"
+void WriteStats(std::ostream &p_stream, const std::string &p_format);
+
+}  // end namespace Gambit
+
+#ifdef GAMBIT_STATS
+#define GAMBIT_STATS_ADD(counter, n)  \
+  do { if (Gambit::g_statsEnabled) \
+      Gambit::GetStatsBlock().m_counts[Gambit::counter] += (n); } while (0)
+#define GAMBIT_STATS_COUNT(counter)  GAMBIT_STATS_ADD(counter, 1)
+/// Times the rest of the enclosing block; at most one per block
+#define GAMBIT_STATS_TIMER(section) \
+  Gambit::StatsTimer gambit_stats_timer(Gambit::section)
+#else
+#define GAMBIT_STATS_ADD(counter, n)  ((void) 0)
+#define GAMBIT_STATS_COUNT(counter)  ((void) 0)
+#define GAMBIT_STATS_TIMER(section)  ((void) 0)
+#endif  // GAMBIT_STATS
+
+#endif  // LIBGAMBIT_STATS_H
@@ -221,10 +221,92 @@ bool StrategySupportProfile::RemoveStrategy(const GameStrategy &p_strategy)
 //                 Identification of dominated strategies
 //---------------------------------------------------------------------------
 
+namespace {
+
+//
+// For table games, dominance is checked by reading the outcome numbers
+// of the contingencies directly, in the order in which they are stored,
+// rather than through a profile for each contingency.  The tables of
+// very large games are paged from disk, and this reads each page once.
+//
+bool TableDominates(const StrategySupportProfile &p_support,
+		    const GameTableRep &p_table,
+		    const GameStrategy &s, const GameStrategy &t,
+		    bool p_strict)
+{
+  int player = s->GetPlayer()->GetNumber();
+  Game game = p_support.GetGame();
+  // Outcome number zero is no outcome, which pays nothing.  Payoffs are
+  // only looked up for contingencies where s and t differ in outcome.
+  const Rational zero(0);
+
+  // The contingencies of the other players' strategies in the support
+  // are visited with player 1's strategy varying fastest, which is the
+  // order of the table
+  int numPlayers = p_table.NumPlayers();
+  Array<int> current(numPlayers);
+  ContingencyIndex index = 1;
+  for (int pl = 1; pl <= numPlayers; pl++) {
+    current[pl] = 1;
+    if (pl != player) {
+      index += p_table.GetStrategyOffset(p_support.GetStrategy(pl, 1));
+    }
+  }
+  ContingencyIndex sOffset = p_table.GetStrategyOffset(s);
+  ContingencyIndex tOffset = p_table.GetStrategyOffset(t);
+
+  const OutcomeIdArray &outcomes = p_table.GetOutcomeNumbers();
+  outcomes.Advise(1, outcomes.Length(), MappedBuffer::accessSequential);
+  bool dominates = true, equal = true;
+  while (dominates) {
+    unsigned int a = outcomes[index + sOffset], b = outcomes[index + tOffset];
+    if (a == b) {
+      if (p_strict)  dominates = false;
+    }
+    else {
+      const Rational &payoffA = 
+	(a > 0) ? game->GetOutcome(a)->GetPayoff<Rational>(player) : zero;
+      const Rational &payoffB = 
+	(b > 0) ? game->GetOutcome(b)->GetPayoff<Rational>(player) : zero;
+      if (p_strict) {
+	if (payoffA <= payoffB)  dominates = false;
+      }
+      else if (payoffA < payoffB) {
+	dominates = false;
+      }
+      else if (payoffA > payoffB) {
+	equal = false;
+      }
+    }
+
+    int pl = 1;
+    for (; pl <= numPlayers; pl++) {
+      if (pl == player)  continue;
+      index -= p_table.GetStrategyOffset(p_support.GetStrategy(pl, current[pl]));
+      if (++current[pl] > p_support.NumStrategies(pl)) {
+	current[pl] = 1;
+      }
+      index += p_table.GetStrategyOffset(p_support.GetStrategy(pl, current[pl]));
+      if (current[pl] > 1)  break;
+    }
+    if (pl > numPlayers)  break;
+  }
+  outcomes.Advise(1, outcomes.Length(), MappedBuffer::accessNormal);
+
+  return dominates && (p_strict || !equal);
+}
+
+}  // end anonymous namespace
+
 bool StrategySupportProfile::Dominates(const GameStrategy &s,
 				const GameStrategy &t, 
 				bool p_strict) const
 {
+  const GameTableRep *table = dynamic_cast<const GameTableRep *>(&*m_nfg);
+  if (table) {
+    return TableDominates(*this, *table, s, t, p_strict);
+  }
+
   bool equal = true;
   
   for (StrategyProfileIterator iter(*this); !iter.AtEnd(); iter++) {
@@ -0,0 +1,96 @@
+//
+// This file is part of Gambit
+// Copyright (c) 1994-2014, The Gambit Project (http://www.gambit-project.org)
+//
+// FILE: src/libgambit/symmetric.h
+// Declaration of compressed payoff tables for symmetric games
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+//
+
+
+#ifndef LIBGAMBIT_SYMMETRIC_H
+#define LIBGAMBIT_SYMMETRIC_H
+
+#include "libgambit.h"
+
+namespace Gambit {
+
+//
+// In a symmetric game, a player's payoff depends only on the player's
+// own strategy and on how many of the other players choose each
+// strategy.  This table stores the payoffs of a single player to each
+// strategy against each multiset of strategies of the N-1 others;
+// with M strategies there are C(N+M-2, M-1) such multisets, rather
+// than the M^(N-1) contingencies of the opponents.  Against a profile
+// in which every player uses the same mixed strategy, the probability
+// of a multiset is its multinomial coefficient times the product of
+// the probabilities, so payoffs are computed in time polynomial in N.
+//
+template <class T> class SymmetricPayoffTable {
+private:
+  Game m_game;
+  int m_numPlayers, m_numStrategies;
+  /// The number of opponents choosing each strategy, by multiset
+  Array<Array<int> > m_counts;
+  /// The number of contingencies of the opponents in each multiset
+  Array<T> m_coefficients;
+  /// The payoff to each strategy against each multiset
+  Matrix<T> m_payoffs;
+
+  /// Returns the probability of each multiset, and the powers of the
+  /// probabilities of the strategies from which it is computed
+  void ComputeWeights(const Vector<T> &p_sigma, RectArray<T> &p_powers,
+		      Vector<T> &p_weights) const;
+
+public:
+  /// @name Lifecycle
+  //@{
+  /// Constructs the table for a game; throws UndefinedException if
+  /// the game is not symmetric
+  explicit SymmetricPayoffTable(const Game &p_game);
+  //@}
+
+  /// @name General data access
+  //@{
+  /// Returns the game from which the table was built
+  const Game &GetGame(void) const { return m_game; }
+  /// Returns the number of players in the game
+  int NumPlayers(void) const { return m_numPlayers; }
+  /// Returns the number of strategies of each player
+  int NumStrategies(void) const { return m_numStrategies; }
+  /// Returns the number of multisets of strategies of the opponents
+  int NumMultisets(void) const { return m_counts.Length(); }
+  //@}
+
+  /// @name Computations at symmetric profiles
+  //@{
+  /// Computes the payoff to each strategy when all other players use
+  /// the mixed strategy p_sigma
+  void GetPayoffs(const Vector<T> &p_sigma, Vector<T> &p_payoffs) const;
+  /// Computes the derivatives of the payoffs of GetPayoffs(); entry
+  /// (a,b) is the derivative of the payoff to strategy a with respect
+  /// to the probability of strategy b.  The payoffs are homogeneous of
+  /// degree N-1 in p_sigma, so the derivatives times p_sigma are N-1
+  /// times the payoffs.
+  void GetPayoffDerivs(const Vector<T> &p_sigma, Matrix<T> &p_derivs) const;
+  /// Returns the profile of the game in which every player uses p_sigma
+  MixedStrategyProfile<T> ToProfile(const Vector<T> &p_sigma) const;
+  //@}
+};
+
+}  // end namespace Gambit
+
+#endif  // LIBGAMBIT_SYMMETRIC_H
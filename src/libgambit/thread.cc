@@ -0,0 +1,294 @@
+//
+// This file is part of Gambit
+// Copyright (c) 1994-2014, The Gambit Project (http://www.gambit-project.org)
+//
+// FILE: src/libgambit/thread.cc
+// Minimal wrappers for running work on several threads
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+//
+
+#include <vector>
+#include <unistd.h>
+#include "libgambit.h"
+#include "thread.h"
+
+namespace Gambit {
+
+//========================================================================
+//                            class Mutex
+//========================================================================
+
+#ifdef HAVE_PTHREAD
+
+Mutex::Mutex(void)
+{ pthread_mutex_init(&m_mutex, 0); }
+
+Mutex::~Mutex()
+{ pthread_mutex_destroy(&m_mutex); }
+
+void Mutex::Lock(void)
+{ pthread_mutex_lock(&m_mutex); }
+
+void Mutex::Unlock(void)
+{ pthread_mutex_unlock(&m_mutex); }
+
+#else
+
+Mutex::Mutex(void) { }
+Mutex::~Mutex() { }
+void Mutex::Lock(void) { }
+void Mutex::Unlock(void) { }
+
+#endif  // HAVE_PTHREAD
+
+//========================================================================
+//                          class Condition
+//========================================================================
+
+#ifdef HAVE_PTHREAD
+
+Condition::Condition(void)
+{ pthread_cond_init(&m_cond, 0); }
+
+Condition::~Condition()
+{ pthread_cond_destroy(&m_cond); }
+
+void Condition::Wait(Mutex &p_mutex)
+{ pthread_cond_wait(&m_cond, &p_mutex.m_mutex); }
+
+void Condition::Signal(void)
+{ pthread_cond_signal(&m_cond); }
+
+void Condition::Broadcast(void)
+{ pthread_cond_broadcast(&m_cond); }
+
+#else
+
+Condition::Condition(void) { }
+Condition::~Condition() { }
+void Condition::Wait(Mutex &) { }
+void Condition::Signal(void) { }
+void Condition::Broadcast(void) { }
+
+#endif  // HAVE_PTHREAD
+
+//========================================================================
+//                      class ThreadLocalPointer
+//========================================================================
+
+#ifdef HAVE_PTHREAD
+
+ThreadLocalPointer::ThreadLocalPointer(void)
+{
+  if (pthread_key_create(&m_key, 0) != 0) {
+    throw Exception("Unable to create thread-specific storage");
+  }
+}
+
+ThreadLocalPointer::~ThreadLocalPointer()
+{ pthread_key_delete(m_key); }
+
+void *ThreadLocalPointer::Get(void) const
+{ return pthread_getspecific(m_key); }
+
+void ThreadLocalPointer::Set(void *p_value)
+{ pthread_setspecific(m_key, p_value); }
+
+#else
+
+ThreadLocalPointer::ThreadLocalPointer(void) : m_value(0) { }
+ThreadLocalPointer::~ThreadLocalPointer() { }
+void *ThreadLocalPointer::Get(void) const { return m_value; }
+void ThreadLocalPointer::Set(void *p_value) { m_value = p_value; }
+
+#endif  // HAVE_PTHREAD
+
+//========================================================================
+//                      class ThreadLocalMember
+//========================================================================
+
+namespace {
+
+// For each thread, its number and the member it used last, with the
+// value it has there.  Like the blocks of statistics, these are not
+// freed when their threads finish.
+struct ThreadRecord {
+  unsigned long m_thread, m_serial;
+  void *m_value;
+};
+
+Mutex s_recordMutex;
+unsigned long s_lastThread = 0, s_lastSerial = 0;
+ThreadLocalPointer s_threadRecord;
+
+ThreadRecord &GetThreadRecord(void)
+{
+  ThreadRecord *record = static_cast<ThreadRecord *>(s_threadRecord.Get());
+  if (!record) {
+    record = new ThreadRecord;
+    MutexLock lock(s_recordMutex);
+    record->m_thread = ++s_lastThread;
+    record->m_serial = 0;
+    record->m_value = 0;
+    s_threadRecord.Set(record);
+  }
+  return *record;
+}
+
+}  // end anonymous namespace
+
+ThreadLocalMember::ThreadLocalMember(void)
+{
+  MutexLock lock(s_recordMutex);
+  m_serial = ++s_lastSerial;
+}
+
+void *ThreadLocalMember::Get(void) const
+{
+  ThreadRecord &record = GetThreadRecord();
+  if (record.m_serial == m_serial)  return record.m_value;
+
+  void *value = 0;
+  {
+    MutexLock lock(m_mutex);
+    for (size_t i = 0; i < m_values.size(); i++) {
+      if (m_values[i].first == record.m_thread) {
+	value = m_values[i].second;
+	break;
+      }
+    }
+  }
+  record.m_serial = m_serial;
+  record.m_value = value;
+  return value;
+}
+
+void ThreadLocalMember::Set(void *p_value)
+{
+  ThreadRecord &record = GetThreadRecord();
+  {
+    MutexLock lock(m_mutex);
+    size_t i = 0;
+    while (i < m_values.size() && m_values[i].first != record.m_thread)  i++;
+    if (i < m_values.size()) {
+      m_values[i].second = p_value;
+    }
+    else {
+      m_values.push_back(std::make_pair(record.m_thread, p_value));
+    }
+  }
+  record.m_serial = m_serial;
+  record.m_value = p_value;
+}
+
+//========================================================================
+//                         Reporting progress
+//========================================================================
+
+static ThreadLocalPointer s_threadObserver;
+
+void SetProgressObserver(ProgressObserver *p_observer)
+{ s_threadObserver.Set(p_observer); }
+
+ProgressObserver *GetProgressObserver(void)
+{ return static_cast<ProgressObserver *>(s_threadObserver.Get()); }
+
+void ReportProgress(void)
+{
+  ProgressObserver *observer = GetProgressObserver();
+  if (observer)  observer->OnProgress();
+}
+
+//========================================================================
+//                           Running threads
+//========================================================================
+
+#ifdef HAVE_PTHREAD
+
+namespace {
+
+struct ThreadStart {
+  void (*m_worker)(void *, int);
+  void *m_data;
+  int m_index;
+  ProgressObserver *m_observer;
+};
+
+extern "C" void *RunThreadStart(void *p_start)
+{
+  ThreadStart *start = static_cast<ThreadStart *>(p_start);
+  SetProgressObserver(start->m_observer);
+  start->m_worker(start->m_data, start->m_index);
+  return 0;
+}
+
+}  // end anonymous namespace
+
+void RunThreads(int p_threads, void (*p_worker)(void *, int), void *p_data)
+{
+  if (p_threads <= 1) {
+    p_worker(p_data, 0);
+    return;
+  }
+
+  std::vector<ThreadStart> starts(p_threads);
+  std::vector<pthread_t> threads(p_threads);
+  std::vector<bool> started(p_threads, false);
+  for (int i = 1; i < p_threads; i++) {
+    starts[i].m_worker = p_worker;
+    starts[i].m_data = p_data;
+    starts[i].m_index = i;
+    starts[i].m_observer = GetProgressObserver();
+    started[i] = (pthread_create(&threads[i], 0, RunThreadStart,
+				 &starts[i]) == 0);
+  }
+
+  p_worker(p_data, 0);
+
+  for (int i = 1; i < p_threads; i++) {
+    if (started[i]) {
+      pthread_join(threads[i], 0);
+    }
+    else {
+      // Could not create the thread; do its share here instead
+      p_worker(p_data, i);
+    }
+  }
+}
+
+#else
+
+void RunThreads(int p_threads, void (*p_worker)(void *, int), void *p_data)
+{
+  for (int i = 0; i < p_threads || i == 0; i++) {
+    p_worker(p_data, i);
+  }
+}
+
+#endif  // HAVE_PTHREAD
+
+int NumberOfProcessors(void)
+{
+#ifdef _SC_NPROCESSORS_ONLN
+  long count = sysconf(_SC_NPROCESSORS_ONLN);
+  if (count >= 1) {
+    return (int) count;
+  }
+#endif  // _SC_NPROCESSORS_ONLN
+  return 1;
+}
+
+}  // end namespace Gambit
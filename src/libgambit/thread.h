@@ -0,0 +1,177 @@
+//
+// This file is part of Gambit
+// Copyright (c) 1994-2014, The Gambit Project (http://www.gambit-project.org)
+//
+// FILE: src/libgambit/thread.h
+// Minimal wrappers for running work on several threads
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+//
+
+#ifndef LIBGAMBIT_THREAD_H
+#define LIBGAMBIT_THREAD_H
+
+#include <config.h>
+
+#include <vector>
+#include <utility>
+
+#ifdef HAVE_PTHREAD
+#include <pthread.h>
+#endif  // HAVE_PTHREAD
+
+namespace Gambit {
+
+//
+// These classes wrap POSIX threads where configure found them.
+// Otherwise locking does nothing and RunThreads() calls the workers
+// one after another on the calling thread, so code written against
+// them must not rely on two workers actually running at once.
+//
+
+/// A mutual exclusion lock
+class Mutex {
+  friend class Condition;
+private:
+#ifdef HAVE_PTHREAD
+  pthread_mutex_t m_mutex;
+#endif  // HAVE_PTHREAD
+
+  Mutex(const Mutex &);
+  Mutex &operator=(const Mutex &);
+
+public:
+  Mutex(void);
+  ~Mutex();
+
+  void Lock(void);
+  void Unlock(void);
+};
+
+/// Holds a mutex locked for the lifetime of the object
+class MutexLock {
+private:
+  Mutex &m_mutex;
+
+  MutexLock(const MutexLock &);
+  MutexLock &operator=(const MutexLock &);
+
+public:
+  MutexLock(Mutex &p_mutex) : m_mutex(p_mutex) { m_mutex.Lock(); }
+  ~MutexLock() { m_mutex.Unlock(); }
+};
+
+/// A condition variable, used together with a Mutex
+class Condition {
+private:
+#ifdef HAVE_PTHREAD
+  pthread_cond_t m_cond;
+#endif  // HAVE_PTHREAD
+
+  Condition(const Condition &);
+  Condition &operator=(const Condition &);
+
+public:
+  Condition(void);
+  ~Condition();
+
+  /// Atomically release the (locked) mutex and wait to be signalled
+  void Wait(Mutex &);
+  void Signal(void);
+  void Broadcast(void);
+};
+
+/// A pointer which has a separate value on each thread, initially null.
+/// The objects pointed to are not owned.
+class ThreadLocalPointer {
+private:
+#ifdef HAVE_PTHREAD
+  pthread_key_t m_key;
+#else
+  void *m_value;
+#endif  // HAVE_PTHREAD
+
+  ThreadLocalPointer(const ThreadLocalPointer &);
+  ThreadLocalPointer &operator=(const ThreadLocalPointer &);
+
+public:
+  ThreadLocalPointer(void);
+  ~ThreadLocalPointer();
+
+  /// Returns the value set by the calling thread
+  void *Get(void) const;
+  /// Sets the value seen by the calling thread
+  void Set(void *);
+};
+
+/// A ThreadLocalPointer for a member of objects of which there may be
+/// any number, such as games.  Each ThreadLocalPointer uses a key from
+/// the system, and there are only a few hundred of those; members of
+/// this class share one key, through which each thread remembers the
+/// value of the member it used last.  The values of other threads are
+/// kept with the member and looked up under a lock.
+class ThreadLocalMember {
+private:
+  unsigned long m_serial;
+  mutable Mutex m_mutex;
+  /// The value set by each thread, with the number of the thread
+  std::vector<std::pair<unsigned long, void *> > m_values;
+
+  ThreadLocalMember(const ThreadLocalMember &);
+  ThreadLocalMember &operator=(const ThreadLocalMember &);
+
+public:
+  ThreadLocalMember(void);
+  ~ThreadLocalMember() { }
+
+  /// Returns the value set by the calling thread
+  void *Get(void) const;
+  /// Sets the value seen by the calling thread
+  void Set(void *);
+};
+
+/// Receives reports of progress from computations on the threads it is
+/// attached to.  Solvers report at points where they can be abandoned,
+/// such as after each pivot; an observer stops the computation by
+/// throwing from OnProgress().  Threads started by RunThreads() share
+/// the observer of the thread which started them, so OnProgress() may
+/// be called from several threads at once.
+class ProgressObserver {
+public:
+  virtual ~ProgressObserver() { }
+  /// Called after each step of the computation
+  virtual void OnProgress(void) = 0;
+};
+
+/// Attaches the observer to the calling thread, replacing any previous
+/// one; null detaches it.  The observer is not owned.
+void SetProgressObserver(ProgressObserver *);
+/// Returns the observer attached to the calling thread, or null
+ProgressObserver *GetProgressObserver(void);
+/// Reports a step of the computation to the observer of the calling
+/// thread, if any
+void ReportProgress(void);
+
+/// Calls p_worker(p_data, i) for i = 0, ..., p_threads - 1, each on its
+/// own thread (index 0 on the calling thread), and returns once all
+/// have finished.  Workers must not let exceptions escape.
+void RunThreads(int p_threads, void (*p_worker)(void *, int), void *p_data);
+
+/// Returns the number of processors available, or 1 if unknown
+int NumberOfProcessors(void);
+
+}  // end namespace Gambit
+
+#endif  // LIBGAMBIT_THREAD_H
@@ -24,6 +24,7 @@
 #define BFS_H
 
 #include "libgambit/libgambit.h"
+#include "libgambit/stats.h"
 #include <map>
 
 template <class T> class BFS {
@@ -38,6 +39,7 @@ public:
 
   // define two BFS's to be equal if their bases are equal
   bool operator==(const BFS &M) const {
+    GAMBIT_STATS_COUNT(statsBFSComparisons);
     if (m_map.size() != M.m_map.size())  return false;
 
     for (typename std::map<int, T>::const_iterator iter = m_map.begin();
@@ -22,8 +22,8 @@
 
 #include "ludecomp.imp"
 
-template class EtaMatrix<double>;
+template class EtaFile<double>;
 template class LUdecomp<double>;
 
-template class EtaMatrix<Gambit::Rational>;
+template class EtaFile<Gambit::Rational>;
 template class LUdecomp<Gambit::Rational>;
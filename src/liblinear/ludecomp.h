@@ -23,27 +23,41 @@
 #ifndef LUDECOMP_H
 #define LUDECOMP_H
 
+#include <vector>
 #include "libgambit/libgambit.h"
 #include "basis.h"
 
 template <class T> class Tableau;
 
 // ---------------------------------------------------------------------------
-// Class EtaMatrix
+// Class EtaFile
 // ---------------------------------------------------------------------------
 
-template <class T> class EtaMatrix {
-  public:
-  int col;
-  Gambit::Vector<T> etadata;
-  
-  
-  EtaMatrix(int c, Gambit::Vector<T> &v) : col(c), etadata(v) {};
+//
+// A sequence of eta matrices, each an identity matrix with one column
+// replaced.  Only the nonzero entries of the replaced columns are kept,
+// and these are stored contiguously in the order the etas were appended,
+// so that solving against the whole file is a single pass over memory.
+//
+template <class T> class EtaFile {
+public:
+  EtaFile(void) { m_start.push_back(0); }
+
+  int Length(void) const { return m_col.size(); }
+  long NumEntries(void) const { return m_index.size(); }
 
-// required for list class
-bool operator==(const EtaMatrix<T> &) const;
-bool operator!=(const EtaMatrix<T> &) const;
+  void Clear(void);
+  // append the eta whose column col is given by the nonzeros of v
+  void Append(int col, const Gambit::Vector<T> &v);
 
+  // d := E_k^{-1} d
+  void Solve(int k, Gambit::Vector<T> &d) const;
+  // y := y E_k^{-1}
+  void SolveT(int k, Gambit::Vector<T> &y) const;
+
+private:
+  std::vector<int> m_col, m_start, m_index;
+  std::vector<T> m_pivot, m_value;
 };
 
 // ---------------------------------------------------------------------------
@@ -57,9 +71,9 @@ private:
   Tableau<T> &tab;
   Basis &basis;
 
-  Gambit::List< EtaMatrix<T> > L;
-  Gambit::List< EtaMatrix<T> > U;
-  Gambit::List< EtaMatrix<T> > E;
+  EtaFile<T> L;
+  EtaFile<T> U;
+  EtaFile<T> E;
   Gambit::List< int > P;
 
   Gambit::Vector<T> scratch1; // scratch vectors so we don't reallocate them
@@ -67,7 +81,7 @@ private:
 
   int refactor_number;
   int iterations;
-  int total_operations;
+  long factor_size;  // number of nonzeros in the factors L and U
 
   const LUdecomp<T> *parent;
   int copycount;
@@ -129,7 +143,9 @@ public:
   void solveT( const Gambit::Vector<T> &, Gambit::Vector <T> & ) const;
 
   // set number of etamatrices added before refactoring;
-  // if number is set to zero, refactoring is done automatically.
+  // if number is set to zero, refactoring is done automatically,
+  // when the eta file holds more nonzeros than the factors, or
+  // an update pivot is too small relative to its column.
   // if number is < 0, no refactoring is done;
   void SetRefactor( int );
 
@@ -153,19 +169,6 @@ private:
   void LPd_Trans( Gambit::Vector<T> & ) const;
   void yLP_Trans( Gambit::Vector<T> & ) const;
 
-  void VectorEtaSolve( const Gambit::Vector<T> &v,  
-		      const EtaMatrix<T> &, 
-		      Gambit::Vector<T> &y ) const;
-
-  void EtaVectorSolve( const Gambit::Vector<T> &v, 
-		      const EtaMatrix<T> &,
-		      Gambit::Vector<T> &d ) const;
-
-  void yLP_mult( const Gambit::Vector<T> &y, int j, Gambit::Vector<T> &) const;
-
-  void LPd_mult( Gambit::Vector<T> &d, int j, Gambit::Vector<T> &) const;
-
-
 };  // end of class LUdecomp
     
 #endif // LUDECOMP_H
@@ -0,0 +1,148 @@
+//
+// This file is part of Gambit
+// Copyright (c) 1994-2014, The Gambit Project (http://www.gambit-project.org)
+//
+// FILE: src/liblinear/sparselu.h
+// Interface to sparse matrix and sparse LU decomposition classes
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+//
+
+#ifndef SPARSELU_H
+#define SPARSELU_H
+
+#include <map>
+#include <vector>
+#include "libgambit/libgambit.h"
+
+// ---------------------------------------------------------------------------
+// Class SparseVector
+// ---------------------------------------------------------------------------
+
+//
+// A sparse vector is a list of (index, value) pairs, in no particular
+// order, with no repeated indices.
+//
+template <class T> class SparseVector {
+public:
+  std::vector<int> index;
+  std::vector<T> value;
+
+  void Clear(void) { index.clear(); value.clear(); }
+  void Append(int i, const T &v) { index.push_back(i); value.push_back(v); }
+  int Length(void) const { return index.size(); }
+};
+
+// ---------------------------------------------------------------------------
+// Class SparseMatrix
+// ---------------------------------------------------------------------------
+
+//
+// A matrix stored by columns, holding only the entries which have been
+// explicitly set.  Row and column index ranges follow the conventions
+// of Gambit::Matrix, so that a SparseMatrix can stand in for the
+// constraint matrix of a tableau.
+//
+template <class T> class SparseMatrix {
+public:
+  SparseMatrix(int p_minrow, int p_maxrow, int p_mincol, int p_maxcol);
+  ~SparseMatrix() { }
+
+  int MinRow(void) const { return m_minrow; }
+  int MaxRow(void) const { return m_maxrow; }
+  int MinCol(void) const { return m_columns.First(); }
+  int MaxCol(void) const { return m_columns.Last(); }
+  /// Returns the number of stored entries
+  long NumEntries(void) const;
+
+  /// Returns a reference to entry (row, col), creating it if absent
+  T &operator()(int row, int col);
+  /// Returns entry (row, col), or zero if it is not stored
+  T operator()(int row, int col) const;
+
+  /// Copies the nonzero entries of column col into v
+  void GetColumn(int col, SparseVector<T> &v) const;
+
+private:
+  int m_minrow, m_maxrow;
+  Gambit::Array<std::map<int, T> > m_columns;
+};
+
+// ---------------------------------------------------------------------------
+// Class SparseLUdecomp
+// ---------------------------------------------------------------------------
+
+//
+// LU decomposition of a sparse basis matrix, computed by Gaussian
+// elimination with Markowitz pivot selection.  The factors are held in
+// contiguous arrays (L by columns, U by rows).  Column replacements are
+// handled by appending sparse product-form eta columns; once the etas
+// hold more entries than the factors themselves, or the number of
+// updates passes the refactoring limit, NeedsRefactor() returns true
+// and the owner is expected to call Factor() with the current basis.
+//
+template <class T> class SparseLUdecomp {
+public:
+  class BadPivot : public Gambit::Exception  {
+  public:
+    virtual ~BadPivot() throw() { }
+    const char *what(void) const throw() { return "Singular matrix in SparseLUdecomp"; }
+  };
+
+  /// Sets up the decomposition of an identity matrix with rows and
+  /// columns indexed first..last
+  SparseLUdecomp(int first, int last);
+  ~SparseLUdecomp() { }
+
+  /// Factors the matrix whose column i is p_columns[i]
+  void Factor(const Gambit::Array<SparseVector<T> > &p_columns);
+  /// Replaces column col by the column a (with entries indexed by row)
+  void Update(int col, const SparseVector<T> &a);
+  /// Returns true if the eta file has grown enough to warrant refactoring
+  bool NeedsRefactor(void) const;
+  /// Sets the maximum number of updates before refactoring;
+  /// zero selects the default limit, negative disables the limit
+  void SetRefactor(int p_limit) { m_refactorLimit = p_limit; }
+
+  /// Solves B x = b
+  void Solve(const Gambit::Vector<T> &b, Gambit::Vector<T> &x) const;
+  /// Solves B x = a, for a sparse right-hand side
+  void Solve(const SparseVector<T> &a, Gambit::Vector<T> &x) const;
+
+private:
+  int m_first, m_size;
+
+  // Pivot sequence: at step k, row m_pivotRow[k] is eliminated using
+  // column m_pivotCol[k], with pivot value m_pivotValue[k]
+  std::vector<int> m_pivotRow, m_pivotCol;
+  std::vector<T> m_pivotValue;
+  // Multipliers of step k are entries m_lStart[k]..m_lStart[k+1]-1
+  std::vector<int> m_lStart, m_lIndex;
+  std::vector<T> m_lValue;
+  // Off-diagonal entries of the pivot row at step k
+  std::vector<int> m_uStart, m_uIndex;
+  std::vector<T> m_uValue;
+  // Eta columns of the updates since the last factorization
+  std::vector<int> m_etaCol, m_etaStart, m_etaIndex;
+  std::vector<T> m_etaPivot, m_etaValue;
+
+  int m_refactorLimit;
+  T m_threshold;
+  mutable std::vector<T> m_work, m_result;
+
+  void SolveWork(void) const;
+};
+
+#endif // SPARSELU_H
@@ -0,0 +1,81 @@
+//
+// This file is part of Gambit
+// Copyright (c) 1994-2014, The Gambit Project (http://www.gambit-project.org)
+//
+// FILE: src/liblinear/sptableau.h
+// Interface to tableau class over a sparse constraint matrix
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+//
+
+#ifndef SPTABLEAU_H
+#define SPTABLEAU_H
+
+#include "btableau.h"
+#include "sparselu.h"
+
+// ---------------------------------------------------------------------------
+// SparseTableau: a tableau whose constraint matrix is a SparseMatrix, and
+// whose basis is held as a sparse LU decomposition.  The same
+// implementation serves for both double and Rational.
+// ---------------------------------------------------------------------------
+
+template <class T> class SparseTableau : public BaseTableau<T> {
+public:
+  SparseTableau(const SparseMatrix<T> &A, const Gambit::Vector<T> &b);
+  SparseTableau(const SparseTableau<T> &);
+  virtual ~SparseTableau() { }
+
+  SparseTableau<T> &operator=(const SparseTableau<T> &);
+
+  // information
+  int MinRow(void) const { return A->MinRow(); }
+  int MaxRow(void) const { return A->MaxRow(); }
+  int MinCol(void) const { return A->MinCol(); }
+  int MaxCol(void) const { return A->MaxCol(); }
+
+  bool Member(int i) const { return basis.Member(i); }
+  int Label(int i) const { return basis.Label(i); }
+  int Find(int i) const { return basis.Find(i); }
+
+  // pivoting
+  bool CanPivot(int outgoing, int incoming) const;
+  void Pivot(int outrow, int col); // pivot -- outgoing is row, incoming is column
+  long NumPivots(void) const { return npivots; }
+
+  void BasisVector(Gambit::Vector<T> &x) const { x = solution; } // solve M x = (*b)
+  void GetColumn(int, SparseVector<T> &) const;  // raw column
+  void SolveColumn(int, Gambit::Vector<T> &);  // column in new basis
+  void Solve(const Gambit::Vector<T> &b, Gambit::Vector<T> &x) const;  // solve M x = b
+
+  // raw Tableau functions
+  void Refactor(void);
+  void SetRefactor(int n) { B.SetRefactor(n); }
+
+  T Epsilon(int i = 2) const;
+
+protected:
+  const SparseMatrix<T> *A;
+  const Gambit::Vector<T> *b;
+  Basis basis;
+  SparseLUdecomp<T> B;
+  Gambit::Vector<T> solution;  // current solution vector
+  long npivots;
+  T eps1, eps2;
+  // A temporary column, to avoid frequent allocation
+  mutable SparseVector<T> tmpcol;
+};
+
+#endif  // SPTABLEAU_H
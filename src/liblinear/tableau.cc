@@ -20,6 +20,8 @@
 // Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
 //
 
+#include "libgambit/stats.h"
+#include "libgambit/thread.h"
 #include "tableau.h"
 
 // ---------------------------------------------------------------------------
@@ -85,6 +87,8 @@ void Tableau<double>::Pivot(int outrow,int col)
   B.update(outrow, col);
   Solve(*b, solution);
   npivots++;
+  GAMBIT_STATS_COUNT(statsPivots);
+  Gambit::ReportProgress();
   // BigDump(gout);
 }
 
@@ -373,6 +377,7 @@ void Tableau<Gambit::Rational>::Pivot(int outrow,int in_col)
   Tabdat(row,col)=old_denom;
   // BigDump(gout);
   npivots++;
+  GAMBIT_STATS_COUNT(statsPivots);
 
   basis.Pivot(outrow,in_col);
   nonbasic[col] = outlabel;
@@ -380,6 +385,7 @@ void Tableau<Gambit::Rational>::Pivot(int outrow,int in_col)
   for (i = solution.First();i<=solution.Last();i++) 
     //** solution[i] = (Gambit::Rational)(Coeff[i])/(Gambit::Rational)(denom*totdenom);
     solution[i] = Gambit::Rational(Coeff[i]*sign(denom*totdenom));
+  Gambit::ReportProgress();
 
   //gout << "Bottom \n" << Tabdat << '\n';
   // BigDump(gout);
@@ -433,6 +439,8 @@ void Tableau<Gambit::Rational>::GetColumn(int col, Gambit::Vector<Gambit::Ration
 
 void Tableau<Gambit::Rational>::Refactor()
 { 
+  GAMBIT_STATS_TIMER(statsSectionRefactor);
+  GAMBIT_STATS_COUNT(statsRefactorizations);
   Gambit::Vector<Gambit::Rational> mytmpcol(tmpcol);
   //BigDump(gout);
   //** Note -- we may need to recompute totdenom here, if A and b have changed. 
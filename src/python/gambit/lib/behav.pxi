@@ -238,13 +238,42 @@ cdef class MixedBehaviorProfile(object):
 
 cdef class MixedBehaviorProfileDouble(MixedBehaviorProfile):
     cdef c_MixedBehaviorProfileDouble *profile
+    cdef Py_ssize_t _shape[1]
+    cdef Py_ssize_t _strides[1]
+    cdef int _views
 
     def __dealloc__(self):
         del self.profile
     def __len__(self):
         return self.profile.Length()
 
+    # The buffer interface exposes the probabilities in place, so that
+    # numpy.asarray(profile) is a view which reads and writes the profile.
+    # Writes through a view bypass the profile, so while any view exists
+    # the cached quantities are recomputed before each use.
+    def __getbuffer__(self, Py_buffer *buffer, int flags):
+        self._shape[0] = self.profile.Length()
+        self._strides[0] = sizeof(double)
+        buffer.buf = <char *> data_MixedBehaviorProfileDouble(self.profile)
+        buffer.format = 'd'
+        buffer.internal = NULL
+        buffer.itemsize = sizeof(double)
+        buffer.len = self._shape[0] * sizeof(double)
+        buffer.ndim = 1
+        buffer.obj = self
+        buffer.readonly = 0
+        buffer.shape = self._shape
+        buffer.strides = self._strides
+        buffer.suboffsets = NULL
+        self._views += 1
+    def __releasebuffer__(self, Py_buffer *buffer):
+        self._views -= 1
+    cdef _sync(self):
+        if self._views > 0:
+            self.profile.Invalidate()
+
     def _is_defined_at(self, Infoset infoset):
+        self._sync()
         return self.profile.IsDefinedAt(infoset.infoset)
     def _getprob(self, int index):
         return self.profile.getitem(index)
@@ -255,18 +284,25 @@ cdef class MixedBehaviorProfileDouble(MixedBehaviorProfile):
     def _setaction(self, Action index, value):
         setaction_MixedBehaviorProfileDouble(self.profile, index.action, value)
     def _payoff(self, Player player):
+        self._sync()
         return self.profile.GetPayoff(player.player.deref().GetNumber())
     def _belief(self, Node node):
+        self._sync()
         return self.profile.GetBeliefProb(node.node)
     def _infoset_prob(self, Infoset infoset):
+        self._sync()
         return self.profile.GetRealizProb(infoset.infoset)
     def _infoset_payoff(self, Infoset infoset):
+        self._sync()
         return self.profile.GetPayoff(infoset.infoset)
     def _action_prob(self, Action action):
+        self._sync()
         return self.profile.GetActionProb(action.action)
     def _action_payoff(self, Action action):
+        self._sync()
         return self.profile.GetPayoff(action.action)
     def _regret(self, Action action):
+        self._sync()
         return self.profile.GetRegret(action.action)
 
     def copy(self):
@@ -276,10 +312,12 @@ cdef class MixedBehaviorProfileDouble(MixedBehaviorProfile):
         return behav
     def as_strategy(self):
         cdef MixedStrategyProfileDouble mixed
+        self._sync()
         mixed = MixedStrategyProfileDouble()
         mixed.profile = new c_MixedStrategyProfileDouble(deref(self.profile).ToMixedProfile())
         return mixed
     def liap_value(self):
+        self._sync()
         return self.profile.GetLiapValue()
 
     property game:
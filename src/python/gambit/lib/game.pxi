@@ -323,6 +323,46 @@ cdef class Game(object):
                 raise TypeError("Must use a tuple of ints, strategy labels, or strategies")
         return self._get_contingency(*tuple(cont))
 
+    def _payoff_shape(self):
+        return (len(self.players),) + \
+               tuple(len(player.strategies) for player in self.players)
+
+    def payoff_tensor(self):
+        """Returns the payoffs of the game as an array of floats, indexed
+        first by player and then by the strategy of each player in turn.
+        The array is computed in one pass over the contingencies; changes
+        to it do not affect the game."""
+        cdef double[::1] data
+        cdef vector[long] strides
+        values = numpy.zeros(self._payoff_shape())
+        if values.size > 0:
+            data = values.reshape(-1)
+            for stride in values.strides:
+                strides.push_back(stride // values.itemsize)
+            GetPayoffTensor(self.game, &data[0], strides)
+        return values
+
+    def set_payoff_tensor(self, values):
+        """Sets all the payoffs of a game with a table representation from
+        an array laid out as for payoff_tensor().  Each contingency is
+        given an outcome of its own if it does not already have one."""
+        cdef double[::1] data
+        cdef vector[long] strides
+        if self.is_tree:
+            raise UndefinedOperationError("Operation only defined for "\
+                                          "games with a table representation")
+        values = numpy.ascontiguousarray(values, dtype=numpy.float64)
+        if values.shape != self._payoff_shape():
+            raise ValueError("payoff array has shape %s, but the game requires %s" %
+                             (values.shape, self._payoff_shape()))
+        if not numpy.isfinite(values).all():
+            raise ValueError("payoffs must be finite")
+        if values.size > 0:
+            data = values.reshape(-1)
+            for stride in values.strides:
+                strides.push_back(stride // values.itemsize)
+            SetPayoffTensor(self.game, &data[0], strides)
+
 
     def mixed_strategy_profile(self, rational=False):
         cdef MixedStrategyProfileDouble mspd
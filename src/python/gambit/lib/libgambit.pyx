@@ -23,7 +23,9 @@
 import decimal
 import fractions
 import warnings
+import numpy
 from libcpp cimport bool
+from libcpp.vector cimport vector
 
 class Rational(fractions.Fraction):
     def _repr_latex_(self):
@@ -303,6 +305,7 @@ cdef extern from "libgambit/behav.h":
         double GetPayoff(c_GameAction)
         double GetRegret(c_GameAction)
         double GetLiapValue()
+        void Invalidate()
         c_MixedStrategyProfileDouble ToMixedProfile()
         c_MixedBehaviorProfileDouble(c_MixedStrategyProfileDouble) except +NotImplementedError
         c_MixedBehaviorProfileDouble(c_Game)
@@ -372,6 +375,13 @@ cdef extern from "util.h":
     void setaction_MixedBehaviorProfileRational(c_MixedBehaviorProfileRational *, 
                                             c_GameAction, char *)
 
+    double *data_MixedStrategyProfileDouble(c_MixedStrategyProfileDouble *)
+    double *data_MixedBehaviorProfileDouble(c_MixedBehaviorProfileDouble *)
+    void strategy_values_MixedStrategyProfileDouble(c_MixedStrategyProfileDouble *,
+                                                    double *)
+    void GetPayoffTensor(c_Game, double *, vector[long]) except +
+    void SetPayoffTensor(c_Game, double *, vector[long]) except +
+
     c_MixedStrategyProfileDouble *CopyElementStrategyDouble(List[c_MixedStrategyProfileDouble], int)
     c_MixedStrategyProfileRational *CopyElementStrategyRational(List[c_MixedStrategyProfileRational], int)
     c_MixedBehaviorProfileDouble *CopyElementBehaviorDouble(List[c_MixedBehaviorProfileDouble], int)
@@ -411,3 +421,4 @@ include "mixed.pxi"
 include "behav.pxi"
 include "game.pxi"
 include "nash.pxi"
+include "pathtrace.pxi"
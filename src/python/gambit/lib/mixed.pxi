@@ -126,7 +126,9 @@ cdef class MixedStrategyProfile(object):
                             strategy.__class__.__name__)
         return self._strategy_value(strategy)
             
-    def strategy_values(self, player):
+    def strategy_values(self, player=None):
+        if player is None:
+            return self._strategy_values()
         if isinstance(player, str):
             player = self.game.players[player]
         elif not isinstance(player, Player):
@@ -158,12 +160,33 @@ cdef class MixedStrategyProfile(object):
 
 cdef class MixedStrategyProfileDouble(MixedStrategyProfile):
     cdef c_MixedStrategyProfileDouble *profile
+    cdef Py_ssize_t _shape[1]
+    cdef Py_ssize_t _strides[1]
 
     def __dealloc__(self):
         del self.profile
     def __len__(self):
         return self.profile.MixedProfileLength()
 
+    # The buffer interface exposes the probabilities in place, so that
+    # numpy.asarray(profile) is a view which reads and writes the profile
+    def __getbuffer__(self, Py_buffer *buffer, int flags):
+        self._shape[0] = self.profile.MixedProfileLength()
+        self._strides[0] = sizeof(double)
+        buffer.buf = <char *> data_MixedStrategyProfileDouble(self.profile)
+        buffer.format = 'd'
+        buffer.internal = NULL
+        buffer.itemsize = sizeof(double)
+        buffer.len = self._shape[0] * sizeof(double)
+        buffer.ndim = 1
+        buffer.obj = self
+        buffer.readonly = 0
+        buffer.shape = self._shape
+        buffer.strides = self._strides
+        buffer.suboffsets = NULL
+    def __releasebuffer__(self, Py_buffer *buffer):
+        pass
+
     def _strategy_index(self, Strategy st):
         return self.profile.GetSupport().GetIndex(st.strategy)
     def _getprob(self, int index):
@@ -178,6 +201,13 @@ cdef class MixedStrategyProfileDouble(MixedStrategyProfile):
         return self.profile.GetPayoff(player.player)
     def _strategy_value(self, Strategy strategy):
         return self.profile.GetPayoff(strategy.strategy)
+    def _strategy_values(self):
+        cdef double[::1] data
+        values = numpy.zeros(self.profile.MixedProfileLength())
+        if len(values) > 0:
+            data = values
+            strategy_values_MixedStrategyProfileDouble(self.profile, &data[0])
+        return values
     def _strategy_value_deriv(self, int pl,
                               Strategy s1, Strategy s2):
         return self.profile.GetPayoffDeriv(pl, s1.strategy, s2.strategy)
@@ -250,6 +280,17 @@ cdef class MixedStrategyProfileRational(MixedStrategyProfile):
         return Rational(rat_str(self.profile.GetPayoff(player.player)).c_str())
     def _strategy_value(self, Strategy strategy):
         return Rational(rat_str(self.profile.GetPayoff(strategy.strategy)).c_str())
+    def _strategy_values(self):
+        cdef c_StrategySupportProfile *support
+        values = [ ]
+        support = new c_StrategySupportProfile(self.profile.GetSupport())
+        try:
+            for pl in range(1, support.NumStrategies().Length()+1):
+                for st in range(1, support.NumStrategiesPlayer(pl)+1):
+                    values.append(Rational(rat_str(self.profile.GetPayoff(support.GetStrategy(pl, st))).c_str()))
+        finally:
+            del support
+        return values
     def _strategy_value_deriv(self, int pl,
                               Strategy s1, Strategy s2):
         return Rational(rat_str(self.profile.GetPayoffDeriv(pl, s1.strategy, s2.strategy)).c_str())
@@ -0,0 +1,319 @@
+//
+// This file is part of Gambit
+// Copyright (c) 1994-2014, The Gambit Project (http://www.gambit-project.org)
+//
+// FILE: src/python/gambit/lib/pathtrace.h
+// Path-following engine and QRE equations for the Python extension
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+//
+
+#include <cmath>
+#include <vector>
+#include <algorithm>
+#include "libgambit/libgambit.h"
+#include "tools/logit/nfglogit.h"
+
+//
+// Thrown when a callback into Python has raised an exception; the
+// extension keeps the Python exception and raises it again once the
+// tracer has unwound.
+//
+class PythonCallbackException : public Exception {
+public:
+  virtual ~PythonCallbackException() throw() { }
+  const char *what(void) const throw()
+  { return "Exception raised in Python callback"; }
+};
+
+//
+// Callbacks into Python.  Points, tangents and LHS are passed as
+// arrays, and the Jacobian row by row.  Each returns nonzero if the
+// Python code raised an exception.
+//
+typedef int (*PathLHSCallback)(void *, const double *, int, double *);
+typedef int (*PathJacobianCallback)(void *, const double *, int, double *);
+typedef int (*PathCriterionCallback)(void *, const double *, const double *,
+				     int, double *);
+typedef int (*PathStepCallback)(void *, const double *, int);
+
+//
+// Equations whose LHS and Jacobian are computed in Python
+//
+class CallbackPathEquations : public PathEquations {
+public:
+  CallbackPathEquations(void *p_context, PathLHSCallback p_lhs,
+			PathJacobianCallback p_jacobian)
+    : m_context(p_context), m_lhs(p_lhs), m_jacobian(p_jacobian) { }
+  virtual ~CallbackPathEquations() { }
+
+  virtual void GetLHS(const Vector<double> &p_point, Vector<double> &p_lhs)
+  {
+    if (m_lhs(m_context, &p_point[1], p_point.Length(), &p_lhs[1])) {
+      throw PythonCallbackException();
+    }
+  }
+
+  virtual void GetJacobian(const Vector<double> &p_point,
+			   Matrix<double> &p_matrix)
+  {
+    m_buffer.resize(p_matrix.NumRows() * p_matrix.NumColumns());
+    if (m_jacobian(m_context, &p_point[1], p_point.Length(), &m_buffer[0])) {
+      throw PythonCallbackException();
+    }
+    for (int i = 1, k = 0; i <= p_matrix.NumRows(); i++) {
+      for (int j = 1; j <= p_matrix.NumColumns(); j++) {
+	p_matrix(i, j) = m_buffer[k++];
+      }
+    }
+  }
+
+private:
+  void *m_context;
+  PathLHSCallback m_lhs;
+  PathJacobianCallback m_jacobian;
+  std::vector<double> m_buffer;
+};
+
+//
+// The equations defining the symmetric logit QRE correspondence of a
+// symmetric game in which each player's payoff depends only on his own
+// strategy and the sum of the (zero-based) strategy numbers of the
+// others.  The payoff table has one row for each strategy, and one
+// column for each possible sum, from 0 to (players-1)*(strategies-1).
+//
+class SymmetricQREEquations : public PathEquations {
+public:
+  SymmetricQREEquations(int p_players, int p_strategies,
+			const double *p_payoffs)
+    : m_players(p_players), m_strategies(p_strategies),
+      m_sums((p_players - 1) * (p_strategies - 1) + 1),
+      m_payoffs(p_payoffs, p_payoffs + p_strategies * m_sums)
+  { }
+  virtual ~SymmetricQREEquations() { }
+
+  virtual void GetLHS(const Vector<double> &p_point, Vector<double> &p_lhs)
+  {
+    double lambda = p_point[p_point.Length()];
+    ComputeProbs(p_point);
+    SumDistribution(m_players - 1, m_others);
+    p_lhs[1] = -1.0;
+    for (int st = 0; st < m_strategies; st++) {
+      p_lhs[1] += m_probs[st];
+    }
+    double value0 = Value(0);
+    for (int st = 1; st < m_strategies; st++) {
+      p_lhs[st + 1] = (p_point[st + 1] - p_point[1] -
+		       lambda * (Value(st) - value0));
+    }
+  }
+
+  virtual void GetJacobian(const Vector<double> &p_point,
+			   Matrix<double> &p_matrix)
+  {
+    double lambda = p_point[p_point.Length()];
+    ComputeProbs(p_point);
+    SumDistribution(m_players - 1, m_others);
+    double value0 = Value(0);
+    SumDistribution(m_players - 2, m_others);
+
+    p_matrix = 0.0;
+    // The sum-to-one equation; its derivative wrt lambda is zero
+    for (int sto = 0; sto < m_strategies; sto++) {
+      p_matrix(sto + 1, 1) = m_probs[sto];
+    }
+    // The ratio equations
+    for (int st = 1; st < m_strategies; st++) {
+      for (int sto = 0; sto < m_strategies; sto++) {
+	p_matrix(sto + 1, st + 1) =
+	  -(m_players - 1) * lambda * m_probs[sto] *
+	  (ValueDeriv(st, sto) - ValueDeriv(0, sto));
+      }
+      p_matrix(1, st + 1) -= 1.0;
+      p_matrix(st + 1, st + 1) += 1.0;
+    }
+    // The column wrt lambda needs the values against all the others
+    SumDistribution(m_players - 1, m_others);
+    for (int st = 1; st < m_strategies; st++) {
+      p_matrix(p_matrix.NumRows(), st + 1) = value0 - Value(st);
+    }
+  }
+
+private:
+  int m_players, m_strategies, m_sums;
+  std::vector<double> m_payoffs;
+  // Working storage: the strategy probabilities, and the distribution
+  // of the sum of the strategy numbers of some number of the others
+  std::vector<double> m_probs, m_others, m_power, m_product;
+
+  void ComputeProbs(const Vector<double> &p_point)
+  {
+    m_probs.resize(m_strategies);
+    for (int st = 0; st < m_strategies; st++) {
+      m_probs[st] = exp(p_point[st + 1]);
+    }
+  }
+
+  static void Convolve(const std::vector<double> &p_a,
+		       const std::vector<double> &p_b,
+		       std::vector<double> &p_result)
+  {
+    p_result.assign(p_a.size() + p_b.size() - 1, 0.0);
+    for (size_t i = 0; i < p_a.size(); i++) {
+      for (size_t j = 0; j < p_b.size(); j++) {
+	p_result[i + j] += p_a[i] * p_b[j];
+      }
+    }
+  }
+
+  // The distribution of the sum of p_count independent choices, by
+  // repeated squaring of the distribution of one choice
+  void SumDistribution(int p_count, std::vector<double> &p_dist)
+  {
+    p_dist.assign(1, 1.0);
+    m_power = m_probs;
+    while (p_count > 0) {
+      if (p_count % 2 == 1) {
+	Convolve(p_dist, m_power, m_product);
+	p_dist.swap(m_product);
+      }
+      p_count /= 2;
+      if (p_count > 0) {
+	Convolve(m_power, m_power, m_product);
+	m_power.swap(m_product);
+      }
+    }
+  }
+
+  // The payoff to st, given m_others is the distribution over all others
+  double Value(int st) const
+  {
+    double value = 0.0;
+    for (size_t j = 0; j < m_others.size(); j++) {
+      value += m_others[j] * m_payoffs[st * m_sums + j];
+    }
+    return value;
+  }
+
+  // The payoff to st if one other plays sto, given m_others is the
+  // distribution over the remaining others
+  double ValueDeriv(int st, int sto) const
+  {
+    double value = 0.0;
+    for (size_t j = 0; j < m_others.size(); j++) {
+      value += m_others[j] * m_payoffs[st * m_sums + j + sto];
+    }
+    return value;
+  }
+};
+
+//
+// A path tracer which takes its equations as an object, and reports
+// steps and evaluates the optional criterion in Python
+//
+class CallbackPathTracer : public PathTracer {
+public:
+  CallbackPathTracer(PathEquations *p_equations, void *p_context,
+		     PathCriterionCallback p_criterion,
+		     PathStepCallback p_step)
+    : m_equations(p_equations), m_context(p_context),
+      m_criterion(p_criterion), m_step(p_step) { }
+  virtual ~CallbackPathTracer() { }
+
+  // Trace from the point p_x, of length p_length, which is updated to
+  // the last point found.  This is the last point reported by the
+  // engine, rather than the point it leaves for restarting a search.
+  void Trace(double *p_x, int p_length, double p_maxLambda, double p_omega)
+  {
+    Vector<double> x(p_length);
+    for (int i = 1; i <= p_length; i++) {
+      x[i] = p_x[i - 1];
+    }
+    m_last.assign(p_x, p_x + p_length);
+    TracePath(x, p_maxLambda, p_omega);
+    std::copy(m_last.begin(), m_last.end(), p_x);
+  }
+
+protected:
+  virtual double Criterion(const Vector<double> &p_point,
+			   const Vector<double> &p_tangent)
+  {
+    if (!m_criterion) {
+      return PathTracer::Criterion(p_point, p_tangent);
+    }
+    double value;
+    if (m_criterion(m_context, &p_point[1], &p_tangent[1],
+		    p_point.Length(), &value)) {
+      throw PythonCallbackException();
+    }
+    return value;
+  }
+
+  virtual void OnStep(const Vector<double> &p_point, bool p_isTerminal)
+  {
+    m_last.assign(&p_point[1], &p_point[1] + p_point.Length());
+    if (m_step && !p_isTerminal &&
+	m_step(m_context, &p_point[1], p_point.Length())) {
+      throw PythonCallbackException();
+    }
+  }
+
+  virtual void GetLHS(const Vector<double> &p_point, Vector<double> &p_lhs)
+  { m_equations->GetLHS(p_point, p_lhs); }
+  virtual void GetJacobian(const Vector<double> &p_point,
+			   Matrix<double> &p_matrix)
+  { m_equations->GetJacobian(p_point, p_matrix); }
+
+private:
+  PathEquations *m_equations;
+  void *m_context;
+  PathCriterionCallback m_criterion;
+  PathStepCallback m_step;
+  std::vector<double> m_last;
+};
+
+//
+// Evaluating equations directly, with the Jacobian written row by row
+//
+inline void
+EvaluatePathLHS(PathEquations *p_equations, const double *p_point,
+		int p_length, double *p_lhs)
+{
+  Vector<double> point(p_length), lhs(p_length - 1);
+  for (int i = 1; i <= p_length; i++) {
+    point[i] = p_point[i - 1];
+  }
+  p_equations->GetLHS(point, lhs);
+  for (int i = 1; i < p_length; i++) {
+    p_lhs[i - 1] = lhs[i];
+  }
+}
+
+inline void
+EvaluatePathJacobian(PathEquations *p_equations, const double *p_point,
+		     int p_length, double *p_matrix)
+{
+  Vector<double> point(p_length);
+  Matrix<double> matrix(p_length, p_length - 1);
+  for (int i = 1; i <= p_length; i++) {
+    point[i] = p_point[i - 1];
+  }
+  p_equations->GetJacobian(point, matrix);
+  for (int i = 1, k = 0; i <= p_length; i++) {
+    for (int j = 1; j < p_length; j++) {
+      p_matrix[k++] = matrix(i, j);
+    }
+  }
+}
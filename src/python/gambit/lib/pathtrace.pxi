@@ -0,0 +1,246 @@
+#
+# This file is part of Gambit
+# Copyright (c) 1994-2014, The Gambit Project (http://www.gambit-project.org)
+#
+# FILE: src/python/gambit/lib/pathtrace.pxi
+# Cython wrapper for the path-following engine and QRE equations
+#
+# This program is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation; either version 2 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program; if not, write to the Free Software
+# Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+#
+
+ctypedef int (*PathLHSCallback)(void *, const double *, int, double *)
+ctypedef int (*PathJacobianCallback)(void *, const double *, int, double *)
+ctypedef int (*PathCriterionCallback)(void *, const double *, const double *,
+                                      int, double *)
+ctypedef int (*PathStepCallback)(void *, const double *, int)
+
+cdef extern from "pathtrace.h":
+    cdef cppclass c_PathEquations "PathEquations":
+        pass
+
+    cdef cppclass c_CallbackPathEquations "CallbackPathEquations"(c_PathEquations):
+        c_CallbackPathEquations(void *, PathLHSCallback, PathJacobianCallback)
+
+    cdef cppclass c_StrategicQREEquations "StrategicQREEquations"(c_PathEquations):
+        c_StrategicQREEquations(c_Game)
+
+    cdef cppclass c_SymmetricQREEquations "SymmetricQREEquations"(c_PathEquations):
+        c_SymmetricQREEquations(int, int, double *)
+
+    cdef cppclass c_CallbackPathTracer "CallbackPathTracer":
+        c_CallbackPathTracer(c_PathEquations *, void *,
+                             PathCriterionCallback, PathStepCallback)
+        void SetMaxDecel(double)
+        void SetStepsize(double)
+        void SetMaxIter(int)
+        void Trace(double *, int, double, double) except +
+
+    void EvaluatePathLHS(c_PathEquations *, double *, int, double *) except +
+    void EvaluatePathJacobian(c_PathEquations *, double *, int, double *) except +
+
+
+cdef object _as_array(const double *data, int length):
+    cdef int i
+    values = numpy.empty(length)
+    cdef double[::1] view = values
+    for i in range(length):
+        view[i] = data[i]
+    return values
+
+# The callbacks keep the first exception raised in Python on the
+# context, so it can be raised again when the tracer has unwound.
+
+cdef int _path_lhs(void *context, const double *point, int length,
+                   double *lhs):
+    cdef int i
+    cdef double[::1] values
+    try:
+        values = numpy.ascontiguousarray(
+            (<CallbackPathEquations> context).lhs(_as_array(point, length)),
+            dtype=numpy.float64)
+        if values.shape[0] != length - 1:
+            raise ValueError("LHS must have one entry fewer than the point")
+        for i in range(length - 1):
+            lhs[i] = values[i]
+        return 0
+    except BaseException as e:
+        (<CallbackPathEquations> context).error = e
+        return 1
+
+cdef int _path_jacobian(void *context, const double *point, int length,
+                        double *matrix):
+    cdef int i
+    cdef double[::1] values
+    try:
+        values = numpy.ascontiguousarray(
+            (<CallbackPathEquations> context).jacobian(_as_array(point, length)),
+            dtype=numpy.float64).reshape(-1)
+        if values.shape[0] != length * (length - 1):
+            raise ValueError("Jacobian must have a row for each entry of the point, "
+                             "and a column for each equation")
+        for i in range(length * (length - 1)):
+            matrix[i] = values[i]
+        return 0
+    except BaseException as e:
+        (<CallbackPathEquations> context).error = e
+        return 1
+
+cdef int _path_criterion(void *context, const double *point,
+                         const double *tangent, int length, double *value):
+    try:
+        value[0] = (<_PathTrace> context).criterion(_as_array(point, length),
+                                                    _as_array(tangent, length))
+        return 0
+    except BaseException as e:
+        (<_PathTrace> context).error = e
+        return 1
+
+cdef int _path_step(void *context, const double *point, int length):
+    try:
+        (<_PathTrace> context).callback(_as_array(point, length))
+        return 0
+    except BaseException as e:
+        (<_PathTrace> context).error = e
+        return 1
+
+
+cdef class PathEquations(object):
+    """
+    A system of equations whose solutions form a path.  A point is an
+    array of the variables followed by the parameter; the LHS has one
+    entry for each variable, and the Jacobian one row for each entry
+    of the point and one column for each equation.
+    """
+    cdef c_PathEquations *equations
+
+    def __dealloc__(self):
+        del self.equations
+
+    def lhs(self, point):
+        cdef double[::1] x
+        cdef double[::1] y
+        x = numpy.array(point, dtype=numpy.float64)
+        values = numpy.zeros(x.shape[0] - 1)
+        y = values
+        EvaluatePathLHS(self.equations, &x[0], x.shape[0], &y[0])
+        return values
+
+    def jacobian(self, point):
+        cdef double[::1] x
+        cdef double[::1] y
+        x = numpy.array(point, dtype=numpy.float64)
+        values = numpy.zeros((x.shape[0], x.shape[0] - 1))
+        y = values.reshape(-1)
+        EvaluatePathJacobian(self.equations, &x[0], x.shape[0], &y[0])
+        return values
+
+cdef class CallbackPathEquations(PathEquations):
+    """
+    Equations whose LHS and Jacobian are computed by Python functions
+    of the point.
+    """
+    cdef object lhs_func, jacobian_func
+    cdef object error
+
+    def __cinit__(self, lhs, jacobian):
+        self.lhs_func = lhs
+        self.jacobian_func = jacobian
+        self.equations = new c_CallbackPathEquations(<void *> self,
+                                                     _path_lhs, _path_jacobian)
+
+    def lhs(self, point):
+        return self.lhs_func(point)
+    def jacobian(self, point):
+        return self.jacobian_func(point)
+
+cdef class StrategicQREEquations(PathEquations):
+    """
+    The equations of the logit QRE correspondence of a game, in terms
+    of the logarithms of the probabilities of its mixed strategy
+    profiles, followed by lambda.
+    """
+    def __cinit__(self, Game game not None):
+        self.equations = new c_StrategicQREEquations(game.game)
+
+cdef class SymmetricQREEquations(PathEquations):
+    """
+    The equations of the symmetric logit QRE correspondence of a
+    symmetric game, in terms of the logarithms of the probabilities
+    of each strategy, followed by lambda.  The game is given by the
+    number of players, and a table of payoffs to each strategy (by row)
+    for each sum of the strategy numbers, counting from zero, of the
+    other players (by column).
+    """
+    def __cinit__(self, int players, payoffs):
+        cdef double[::1] data
+        table = numpy.ascontiguousarray(payoffs, dtype=numpy.float64)
+        if players < 2 or table.ndim != 2 or \
+           table.shape[1] != (players-1) * (table.shape[0]-1) + 1:
+            raise ValueError("payoff table must have a column for each sum of "
+                             "the others' strategy numbers")
+        data = table.reshape(-1)
+        self.equations = new c_SymmetricQREEquations(players, table.shape[0],
+                                                     &data[0])
+
+
+cdef class _PathTrace(object):
+    cdef object criterion, callback
+    cdef object error
+
+def trace_path(start, start_lambda, max_lambda, PathEquations equations not None,
+               omega=1.0, h_start=0.03, max_decel=1.1, max_iter=100,
+               criterion=None, callback=None):
+    """
+    Trace the path of solutions of 'equations', starting at the
+    vector 'start' with parameter 'start_lambda', until 'max_lambda' is
+    reached, or, if given, a zero of 'criterion(point, tangent)' is
+    found along the path.  'omega' gives the orientation in which to
+    trace the path.  'callback(point)' is called at each step.
+    Returns the last point found, as an array of the variables
+    followed by the parameter.
+    """
+    cdef c_CallbackPathTracer *tracer
+    cdef _PathTrace trace
+    cdef double[::1] x
+    cdef PathCriterionCallback on_criterion = NULL
+    cdef PathStepCallback on_step = NULL
+    point = numpy.array(list(start) + [ start_lambda ], dtype=numpy.float64)
+    x = point
+    trace = _PathTrace()
+    trace.criterion = criterion
+    trace.callback = callback
+    if criterion is not None:
+        on_criterion = _path_criterion
+    if callback is not None:
+        on_step = _path_step
+    tracer = new c_CallbackPathTracer(equations.equations, <void *> trace,
+                                      on_criterion, on_step)
+    if isinstance(equations, CallbackPathEquations):
+        (<CallbackPathEquations> equations).error = None
+    try:
+        tracer.SetStepsize(h_start)
+        tracer.SetMaxDecel(max_decel)
+        tracer.SetMaxIter(max_iter)
+        tracer.Trace(&x[0], x.shape[0], max_lambda, omega)
+    except RuntimeError:
+        if trace.error is not None:
+            raise trace.error
+        if isinstance(equations, CallbackPathEquations) and \
+           (<CallbackPathEquations> equations).error is not None:
+            raise (<CallbackPathEquations> equations).error
+        raise
+    finally:
+        del tracer
+    return point
@@ -29,6 +29,11 @@
 #include <string>
 #include <fstream>
 #include <sstream>
+#include <vector>
+#include <set>
+#include <cstdio>
+#include <cstdlib>
+#include <cmath>
 #include "libgambit/libgambit.h"
 
 using namespace std;
@@ -124,3 +129,130 @@ inline void
 setaction_MixedBehaviorProfileRational(MixedBehaviorProfile<Rational> *profile,
            GameAction &action, const char *value)
 { (*profile)(action) = lexical_cast<Rational>(std::string(value)); }
+
+//
+// Bulk access used by the NumPy views of profiles and payoffs, so that
+// whole arrays cross between Python and C++ in one call
+//
+
+inline double *
+data_MixedStrategyProfileDouble(MixedStrategyProfile<double> *profile)
+{ return (profile->MixedProfileLength() > 0) ? &(*profile)[1] : 0; }
+
+inline double *
+data_MixedBehaviorProfileDouble(MixedBehaviorProfile<double> *profile)
+{ return (profile->Length() > 0) ? &(*profile)[1] : 0; }
+
+inline void
+strategy_values_MixedStrategyProfileDouble(const MixedStrategyProfile<double> *profile,
+					   double *values)
+{
+  // Profile entries run over each player's strategies in turn
+  const StrategySupportProfile &support = profile->GetSupport();
+  for (int pl = 1, index = 0; pl <= support.GetGame()->NumPlayers(); pl++) {
+    for (int st = 1; st <= support.NumStrategies(pl); st++) {
+      values[index++] = profile->GetPayoff(support.GetStrategy(pl, st));
+    }
+  }
+}
+
+// Moves to the next contingency, with player 1's strategy changing
+// fastest, keeping offset equal to the sum over players of
+// (strategy number - 1) * strides[player].  Returns false after the last.
+inline bool
+NextContingency(const Game &game, PureStrategyProfile &profile,
+		std::vector<int> &current, long &offset,
+		const std::vector<long> &strides)
+{
+  for (int pl = 1; pl <= game->NumPlayers(); pl++) {
+    GamePlayer player = game->GetPlayer(pl);
+    if (current[pl] < player->NumStrategies()) {
+      profile->SetStrategy(player->GetStrategy(++current[pl]));
+      offset += strides[pl];
+      return true;
+    }
+    offset -= (current[pl] - 1) * strides[pl];
+    current[pl] = 1;
+    profile->SetStrategy(player->GetStrategy(1));
+  }
+  return false;
+}
+
+// The text for a payoff given as a double: integers exactly, and other
+// values as the shortest decimal which reads back as the same double.
+// The rational parser does not accept a '+' in exponents, so large
+// values are written out in full.
+inline std::string
+PayoffText(double value)
+{
+  char buffer[400];
+  if (value == std::floor(value)) {
+    sprintf(buffer, "%.0f", value);
+  }
+  else if (std::fabs(value) >= 1.0e15) {
+    // Doubles this large are multiples of 1/8
+    sprintf(buffer, "%.3f", value);
+  }
+  else {
+    sprintf(buffer, "%.15g", value);
+    if (strtod(buffer, 0) != value) {
+      sprintf(buffer, "%.17g", value);
+    }
+  }
+  return buffer;
+}
+
+// Copies the payoffs of all contingencies to data.  The payoff to
+// player pl in the contingency where player p plays strategy s_p is
+// written to data[(pl-1) * strides[0] + sum_p (s_p-1) * strides[p]].
+inline void
+GetPayoffTensor(const Game &game, double *data,
+		const std::vector<long> &strides)
+{
+  PureStrategyProfile profile = game->NewPureStrategyProfile();
+  std::vector<int> current(game->NumPlayers() + 1, 1);
+  long offset = 0;
+  do {
+    if (game->IsTree()) {
+      for (int pl = 1; pl <= game->NumPlayers(); pl++) {
+	data[offset + (pl - 1) * strides[0]] = (double) profile->GetPayoff(pl);
+      }
+    }
+    else {
+      GameOutcome outcome = profile->GetOutcome();
+      for (int pl = 1; pl <= game->NumPlayers(); pl++) {
+	data[offset + (pl - 1) * strides[0]] = 
+	  (outcome) ? outcome->GetPayoff<double>(pl) : 0.0;
+      }
+    }
+  } while (NextContingency(game, profile, current, offset, strides));
+}
+
+// Sets the payoffs of all contingencies of a table game from data,
+// laid out as for GetPayoffTensor().  A contingency whose outcome is
+// missing, or shared with a contingency already set, is given a new
+// outcome of its own.
+inline void
+SetPayoffTensor(const Game &game, const double *data,
+		const std::vector<long> &strides)
+{
+  if (game->IsTree()) {
+    throw UndefinedException();
+  }
+
+  PureStrategyProfile profile = game->NewPureStrategyProfile();
+  std::vector<int> current(game->NumPlayers() + 1, 1);
+  long offset = 0;
+  std::set<GameOutcomeRep *> seen;
+  do {
+    GameOutcome outcome = profile->GetOutcome();
+    if (!outcome || !seen.insert(outcome).second) {
+      outcome = game->NewOutcome();
+      profile->SetOutcome(outcome);
+      seen.insert(outcome);
+    }
+    for (int pl = 1; pl <= game->NumPlayers(); pl++) {
+      outcome->SetPayoff(pl, PayoffText(data[offset + (pl - 1) * strides[0]]));
+    }
+  } while (NextContingency(game, profile, current, offset, strides));
+}
@@ -23,7 +23,10 @@
 A set of utilities for computing Nash equilibria
 """
 
+import os
 import sys
+import socket
+import struct
 import subprocess
 from fractions import Fraction
 from gambit.profiles import Solution
@@ -36,6 +39,33 @@ class NashSolution(Solution):
                                                self._profile)
     
     
+# The start of the first line of each request to gambit-server
+SERVER_PROTOCOL = "gambit-server 1"
+
+def server_path():
+    """
+    Returns the path of the socket gambit-server listens on, which is
+    the value of GAMBIT_SERVER.  Returns None if GAMBIT_SERVER is not
+    set or empty, or there are no Unix domain sockets.
+    """
+    if not hasattr(socket, "AF_UNIX"):
+        return None
+    return os.environ.get("GAMBIT_SERVER") or None
+
+def peer_is_same_user(sock):
+    """
+    Returns whether the process at the other end of the connected Unix
+    domain socket 'sock' runs as the same user as this one.  Returns
+    False if this cannot be told.
+    """
+    if not hasattr(socket, "SO_PEERCRED"):
+        return False
+    size = struct.calcsize("3i")
+    pid, uid, gid = struct.unpack("3i", sock.getsockopt(socket.SOL_SOCKET,
+                                                        socket.SO_PEERCRED,
+                                                        size))
+    return uid == os.getuid()
+
 class ExternalSolver(object):
     """
     Base class for managing calls to external programs.
@@ -45,18 +75,67 @@ class ExternalSolver(object):
         Helper function for launching calls to external programs.
         Calls the specified program 'prog', passing the game to standard
         input in .efg format (if a tree) or .nfg format (if a table).
-        Returns the object referencing standard output of the external program.
+        If gambit-server is running and handles the request, it computes
+        the equilibria instead, with the game already parsed if it has
+        seen it before.
+        Returns an iterable over the lines of output of the program.
         """
+        text = game.write(format='native')
+        output = self.launch_on_server(prog, text)
+        if output is not None:
+            return output
         p = subprocess.Popen("%s -q" % prog, shell=True,
                              stdin=subprocess.PIPE, stdout=subprocess.PIPE,
                              close_fds=True if sys.platform != "win32" else False)
         child_stdin, child_stdout = p.stdin, p.stdout
-        child_stdin.write(game.write(format='native'))
+        child_stdin.write(text)
         # Need to close, or at least flush, stdin of the child, or else
         # processing won't begin...
         child_stdin.close()
         return child_stdout
 
+    def launch_on_server(self, prog, text):
+        """
+        Asks gambit-server to do what the program 'prog' would do with
+        the game file 'text'.
+        Returns the lines of output, or None if there is no server or it
+        does not handle the request.
+        """
+        path = server_path()
+        args = prog.split() + [ "-q" ]
+        if path is None or not args[0].startswith("gambit-"):
+            return None
+        if not isinstance(text, bytes):
+            text = text.encode("utf-8")
+        header = "%s %s %s\n%d\n" % (SERVER_PROTOCOL, args[0][len("gambit-"):],
+                                     " ".join(args[1:]), len(text))
+        sock = socket.socket(socket.AF_UNIX, socket.SOCK_STREAM)
+        reply = None
+        try:
+            try:
+                sock.connect(path)
+                # Nothing is sent unless the server runs as this user
+                if not peer_is_same_user(sock):
+                    return None
+                sock.sendall(header.encode("ascii") + text)
+                reply = sock.makefile("rb")
+                if reply.readline() != b"#OK\n":
+                    return None
+            except socket.error:
+                return None
+            lines = [ ]
+            for line in reply:
+                if line == b"#END\n":
+                    return lines
+                if line.startswith(b"#ERROR "):
+                    raise RuntimeError(line[len(b"#ERROR "):].strip().decode("utf-8"))
+                lines.append(line)
+            raise RuntimeError("Lost connection to gambit-server")
+        finally:
+            if reply is not None:
+                reply.close()
+            sock.close()
+
     def _parse_output(self, stream, game, rational, extensive=False):
         profiles = [ ]
         for line in stream:
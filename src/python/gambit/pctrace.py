@@ -27,24 +27,12 @@ import math
 import numpy
 import scipy.linalg        
 
+from gambit.lib import libgambit
+
 def qr_decomp(b):
     qq, b[:,:] = scipy.linalg.qr(b, overwrite_a=True)
     return qq.transpose()
 
-def newton_step(q, b, u, y):
-    # Expects q and b to be 2-D arrays, and u and y to be 1-D arrays
-    # Returns steplength
-    for k in xrange(b.shape[1]):
-        y[k] -= numpy.dot(b[:k,k], y[:k])
-        y[k] /= b[k,k]
-
-    d = 0.0
-    for k in xrange(b.shape[0]):
-        s = numpy.dot(q[:-1,k], y)
-        u[k] -= s
-        d += s*s
-    return math.sqrt(d)
-
 def trace_path(start, startLam, maxLam, compute_lhs, compute_jac,
                omega=1.0, hStart=0.03, maxDecel=1.1, maxIter=1000,
                crit=None, callback=None):
@@ -55,120 +43,17 @@ def trace_path(start, startLam, maxLam, compute_lhs, compute_jac,
     of the Jacobian at any point (x, lam).  omega determines the orientation
     to trace the curve.  Optionally, 'crit' is a function to search for a
     zero of along the path.
-    """
-
-    tol = 1.0e-4              # tolerance for corrector iteration
-    maxDist = 0.4             # maximal distance to curve
-    maxContr = 0.6            # maximal contraction rate in corrector
-    eta = 0.1                 # perturbation to avoid cancellation
-                              # in calculating contraction rate
-    h = hStart                # initial stepsize
-    hmin = 1.0e-8             # minimal stepsize
-
-    newton = False            # using Newton steplength (for zero-finding)
 
-    x = numpy.array([x for x in start] + [startLam])
-    if callback is not None:
-        callback(x)
-
-    y = numpy.zeros(len(start))
-    q = numpy.zeros((len(start)+1, len(start)+1)) 
-    b = compute_jac(x)
-    q = qr_decomp(b)
-    t = q[-1]                # last column is tangent
-
-    if startLam == 0.0 and omega*t[-1] < 0.0:
-        # Reverse orientation of curve to trace away from boundary
-        omega = -omega
-    
-    while x[-1] >= 0.0 and x[-1] < maxLam:
-        accept = True
-
-        if abs(h) <= hmin:
-            # Stop.
-            return x
-
-        # Predictor step
-        u = x + h*omega*t
-
-        decel = 1.0 / maxDecel      # initialize deceleration factor
-        b = compute_jac(u)
-        #q, b = scipy.linalg.decomp.qr(b, mode='qr')
-        q = qr_decomp(b)
-
-        it = 1
-        disto = 0.0
-        while True:
-            if it == maxIter:
-                # Give up!
-                return x
-            
-            y = compute_lhs(u)
-            dist = newton_step(q, b, u, y)
-
-            if dist >= maxDist:
-                accept = False
-                break
-
-            decel = max(decel, math.sqrt(dist / maxDist) * maxDecel)
-
-            if it >= 2:
-                contr = dist / (disto + tol * eta)
-                if contr > maxContr:
-                    accept = False
-                    break
-                decel = max(decel, math.sqrt(contr / maxContr) * maxDecel)
-
-            if dist < tol:
-                # Success; break out of iteration
-                break
-
-            disto = dist
-            it += 1
-
-        if not accept:
-            h /= maxDecel       # PC not accepted; change stepsize and retry
-            if abs(h) < hmin:
-                # Stop.
-                return x
-            continue    # back out to main loop to try again
-
-        # Determine new stepsize
-        if decel > maxDecel:
-            decel = maxDecel
-
-        if not newton and crit is not None:
-            # Currently, 't' is the tangent at 'x'.  We also need the
-            # tangent at 'u'.
-            newT = q[-1]
-
-            if crit(x, t) * crit(u, newT) < 0.0:
-                # Enter Newton mode, since a critical point has been bracketed
-                newton = True
-
-        if newton:
-            # Newton-type steplength adaptation, secant method
-            newT = q[-1]
-            h *= -crit(u, newT) / (crit(u, newT) - crit(x, t))
-        else:
-            # Standard steplength adaptaiton
-            h = abs(h / decel)
-
-        # PC step was successful; update and iterate
-        x = u[:]
-
-        if callback is not None:
-            callback(x)
-
-        newT = q[-1]    # new tangent
-        if sum(t * newT) < 0.0:
-            # Bifurcation detected
-            print "Detected bifurcation near %f" % x[-1]
-
-            omega = -omega
-        t = newT[:]
-        
-    return x
+    The tracing itself is done by the C++ engine; lhs() and jac() are
+    called back for each evaluation.  Where the equations are available
+    natively, call gambit.lib.libgambit.trace_path with them instead.
+    """
+    return libgambit.trace_path(start, startLam, maxLam,
+                                libgambit.CallbackPathEquations(compute_lhs,
+                                                                compute_jac),
+                                omega=omega, h_start=hStart,
+                                max_decel=maxDecel, max_iter=maxIter,
+                                criterion=crit, callback=callback)
 
 
 def upd(q, b, x, u, y, w, t, h, angmax):
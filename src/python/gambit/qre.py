@@ -25,9 +25,10 @@ A set of utilities for computing and analyzing quantal response equilbria
 
 import math
 import numpy
-import pctrace
 
 from gambit.profiles import Solution
+from gambit.lib.libgambit import Game, trace_path, \
+     StrategicQREEquations, SymmetricQREEquations
 
 def sym_compute_lhs(game, point):
     """
@@ -109,9 +110,50 @@ class LogitQRE(Solution):
     @property
     def mu(self):       return 1.0 / self._lam
 
+def sym_payoff_table(game):
+    """
+    Tabulate the payoffs of a symmetric mean statistic game, as required
+    by SymmetricQREEquations: one row for each choice, and one column
+    for each value of the sum of the other players' choices.
+    """
+    return [ [ float(game.payoff(own, others)) for others in game.statistics ]
+             for own in game.choices ]
+
+def _qre_equations(game):
+    """
+    The native equations defining the principal branch for 'game'.
+    """
+    if getattr(game, "is_symmetric", False):
+        return SymmetricQREEquations(game.N, sym_payoff_table(game))
+    elif isinstance(game, Game):
+        return StrategicQREEquations(game)
+    raise NotImplementedError
+
+def _qre_start(game):
+    """
+    The starting point of the principal branch, at the centroid.
+    """
+    p = game.mixed_strategy_profile()
+    if getattr(game, "is_symmetric", False):
+        return [ math.log(x) for x in p.profile ]
+    return numpy.log(numpy.asarray(p))
+
+def _qre_profile(game, point):
+    """
+    The profile at 'point' on the path.
+    """
+    if getattr(game, "is_symmetric", False):
+        return game.mixed_strategy_profile(point=[math.exp(x) for x in point[:-1]])
+    profile = game.mixed_strategy_profile()
+    numpy.asarray(profile)[:] = numpy.exp(point[:-1])
+    return profile
+
 class StrategicQREPathTracer(object):
     """
     Compute the principal branch of the logit QRE correspondence of 'game'.
+    The path is traced in C++; symmetric games are traced in the
+    symmetric profiles, and other games with a table or tree
+    representation in their (reduced) strategic form.
     """
     def __init__(self):
         self.h_start = 0.03
@@ -120,53 +162,31 @@ class StrategicQREPathTracer(object):
     def trace_strategic_path(self, game, max_lambda=1000000.0, callback=None):
         points = [ ]
         def on_step(game, points, p, callback):
-            qre = LogitQRE(p[-1],
-                           game.mixed_strategy_profile(point=[math.exp(x) for x in p[:-1]]))
+            qre = LogitQRE(p[-1], _qre_profile(game, p))
             points.append(qre)
             if callback:  callback(qre)
 
-        if game.is_symmetric:
-            p = game.mixed_strategy_profile()
-
-            try:
-                pctrace.trace_path([ math.log(x) for x in p.profile ],
-                                   0.0, max_lambda,
-                                   lambda x: sym_compute_lhs(game, x),
-                                   lambda x: sym_compute_jac(game, x),
-                                   hStart=self.h_start,
-                                   maxDecel=self.max_decel,
-                                   callback=lambda p: on_step(game, points, p, callback),
-                                   crit=None,
-                                   maxIter=100)
-            except KeyboardInterrupt:
-                pass
-
-            return points
-        else:
-            raise NotImplementedError
+        try:
+            trace_path(_qre_start(game), 0.0, max_lambda,
+                       _qre_equations(game),
+                       h_start=self.h_start, max_decel=self.max_decel,
+                       callback=lambda p: on_step(game, points, p, callback))
+        except KeyboardInterrupt:
+            pass
+
+        return points
 
     def compute_at_lambda(self, game, lam, callback=None):
         if callback is not None:
-            on_step = lambda p: callback(LogitQRE(p[-1],
-                                                  game.mixed_strategy_profile(point=[math.exp(x) for x in p[:-1]])))
+            on_step = lambda p: callback(LogitQRE(p[-1], _qre_profile(game, p)))
         else:
             on_step = None
 
-        if game.is_symmetric:
-            p = game.mixed_strategy_profile()
-
-            point = pctrace.trace_path([ math.log(x) for x in p.profile ],
-                                       0.0, 1000000.0,
-                                       lambda x: sym_compute_lhs(game, x),
-                                       lambda x: sym_compute_jac(game, x),
-                                       crit=lambda x,t: x[-1] - lam,
-                                       callback=on_step,
-                                       maxIter=100)
-
-            return LogitQRE(point[-1],
-                            game.mixed_strategy_profile(point=[math.exp(x) for x in point[:-1]]))
-        else:
-            raise NotImplementedError
+        point = trace_path(_qre_start(game), 0.0, 1000000.0,
+                           _qre_equations(game),
+                           criterion=lambda x,t: x[-1] - lam,
+                           callback=on_step)
+        return LogitQRE(point[-1], _qre_profile(game, point))
 
     def compute_max_like(self, game, data):
         log_like = lambda data, profile: \
@@ -174,23 +194,14 @@ class StrategicQREPathTracer(object):
         diff_log_like = lambda data, point, tangent: \
                         sum([ x*y for (x, y) in zip(data, tangent[:-1]) ])
 
-        if game.is_symmetric:
-            p = game.mixed_strategy_profile()
-
-            point = pctrace.trace_path([ math.log(x) for x in p.profile ],
-                                       0.0, 1000000.0,
-                                       lambda x: sym_compute_lhs(game, x),
-                                       lambda x: sym_compute_jac(game, x),
-                                       hStart=1.0,
-                                       crit=lambda x,t: diff_log_like(data,x,t),
-                                       maxIter=100)
-
-            qre = LogitQRE(point[-1],
-                           game.mixed_strategy_profile(point=[math.exp(x) for x in point[:-1]]))
-            qre.logL = log_like(data, qre)
-            return qre
-        else:
-            raise NotImplementedError
+        point = trace_path(_qre_start(game), 0.0, 1000000.0,
+                           _qre_equations(game),
+                           h_start=1.0,
+                           criterion=lambda x,t: diff_log_like(data,x,t))
+
+        qre = LogitQRE(point[-1], _qre_profile(game, point))
+        qre.logL = log_like(data, qre)
+        return qre
 
     def compute_fit_sshist(self, game, data, callback=None):
         """
@@ -202,23 +213,12 @@ class StrategicQREPathTracer(object):
             return 2.0 * sum([ (math.exp(p)-d) * t * math.exp(p)
                                for (p, t, d) in zip(point, tangent, data) ])
 
-        if game.is_symmetric:
-            p = game.mixed_strategy_profile()
-            point = pctrace.trace_path([ math.log(x) for x in p.profile ],
-                                       0.0, 1000000.0,
-                                       lambda x: sym_compute_lhs(game, x),
-                                       lambda x: sym_compute_jac(game, x),
-                                       hStart=1.0,
-                                       crit=lambda x,t: diff_dist(data,x,t),
-                                       maxIter=100,
-                                       callback=callback)
-
-            qre = LogitQRE(point[-1],
-                           game.mixed_strategy_profile(point=[math.exp(x) for x in point[:-1]]))
-            return qre
-        else:
-            raise NotImplementedError
-
+        point = trace_path(_qre_start(game), 0.0, 1000000.0,
+                           _qre_equations(game),
+                           h_start=1.0,
+                           criterion=lambda x,t: diff_dist(data,x,t),
+                           callback=callback)
+        return LogitQRE(point[-1], _qre_profile(game, point))
 
     def compute_criterion(self, game, f):
         def criterion_wrap(x, t):
@@ -226,24 +226,13 @@ class StrategicQREPathTracer(object):
             This translates the internal representation of the tracer
             into a QRE object.
             """
-            return f(LogitQRE(x[-1],
-                              game.mixed_strategy_profile(point=[math.exp(z) for z in x[:-1]])))
+            return f(LogitQRE(x[-1], _qre_profile(game, x)))
             
-        if game.is_symmetric:
-            p = game.mixed_strategy_profile()
-
-            point = pctrace.trace_path([ math.log(x) for x in p.profile ],
-                                       0.0, 1000000.0,
-                                       lambda x: sym_compute_lhs(game, x),
-                                       lambda x: sym_compute_jac(game, x),
-                                       hStart=1.0,
-                                       crit=criterion_wrap,
-                                       maxIter=100)
-
-            return LogitQRE(point[-1],
-                            game.mixed_strategy_profile(point=[math.exp(x) for x in point[:-1]]))
-        else:
-            raise NotImplementedError
+        point = trace_path(_qre_start(game), 0.0, 1000000.0,
+                           _qre_equations(game),
+                           h_start=1.0,
+                           criterion=criterion_wrap)
+        return LogitQRE(point[-1], _qre_profile(game, point))
         
 
 from nash import ExternalSolver
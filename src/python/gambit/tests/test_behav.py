@@ -1,5 +1,7 @@
 import gambit
 import fractions
+from nose.tools import assert_raises
+from gambit.lib.error import UndefinedOperationError
 
 class TestGambitMixedBehavGame(object):
     def setUp(self):
@@ -438,3 +440,20 @@ class TestGambitMixedBehavGame(object):
             for n in xrange(0, len(i.members)):
                 assert self.profile_rational.belief(i.members[n]) == belief[n]
             assert sum(belief) == fractions.Fraction(1,1)
+
+    def test_array_view(self):
+        "Test that values computed after writing through a numpy view are current"
+        import numpy
+        view = numpy.asarray(self.profile_double)
+        assert len(view) == len(self.profile_double)
+        assert self.profile_double.payoff(self.game.players[0]) != 9.0
+        view[:] = [1.0, 0.0, 1.0, 0.0, 1.0, 0.0]
+        assert self.profile_double[0] == 1.0
+        assert self.profile_double.payoff(self.game.players[0]) == 9.0
+
+    def test_payoff_tensor_tree(self):
+        "Test retrieving the payoffs of a tree as an array"
+        payoffs = self.game.payoff_tensor()
+        assert payoffs.shape == (3, 2, 2, 2)
+        assert list(payoffs[:,0,0,0]) == [9.0, 8.0, 12.0]
+        assert_raises(UndefinedOperationError, self.game.set_payoff_tensor, payoffs)
@@ -58,6 +58,24 @@ class TestGambitMixedStrategyGame(object):
         assert self.profile_double.strategy_values("joe") == [0.0, 0.0]
         assert self.profile_rational.strategy_values("joe") == [0.0, 0.0]
         
+    def test_strategy_values_all(self):
+        "Test retrieving the strategy values of all players at once"
+        self.game[0,0][0] = 4
+        self.game[1,1][1] = 2
+        assert list(self.profile_double.strategy_values()) == [2.0, 0.0, 0.0, 1.0]
+        assert self.profile_rational.strategy_values() == [2, 0, 0, 1]
+
+    def test_array_view(self):
+        "Test reading and writing probabilities through a numpy view"
+        import numpy
+        view = numpy.asarray(self.profile_double)
+        assert list(view) == [0.5, 0.5, 0.5, 0.5]
+        view[0] = 0.25
+        view[1] = 0.75
+        assert self.profile_double[0] == 0.25
+        self.profile_double[2] = 1.0
+        assert view[2] == 1.0
+
     def test_get_probabilities_strategy(self):
         "Test retrieving probabilities"
         assert self.profile_double[0] == 0.5
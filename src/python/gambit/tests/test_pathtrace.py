@@ -0,0 +1,74 @@
+import gambit
+import math
+import numpy
+from nose.tools import assert_raises
+from gambit.lib import libgambit
+
+class TestGambitPathTrace(object):
+    def setUp(self):
+        self.game = gambit.Game.read_game("test_games/sample_extensive_game.efg")
+        self.start = [ math.log(x) for x in
+                       self.game.mixed_strategy_profile() ]
+        self.equations = libgambit.StrategicQREEquations(self.game)
+
+    def tearDown(self):
+        del self.game
+        del self.equations
+
+    def test_lhs_at_start(self):
+        "Test that the centroid solves the QRE equations at lambda zero"
+        lhs = self.equations.lhs(self.start + [ 0.0 ])
+        assert len(lhs) == len(self.start)
+        assert abs(lhs).max() < 1.0e-10
+
+    def test_jacobian_shape(self):
+        "Test that the Jacobian has a row for each entry of the point"
+        jac = self.equations.jacobian(self.start + [ 0.5 ])
+        assert jac.shape == (len(self.start)+1, len(self.start))
+
+    def test_trace_to_lambda(self):
+        "Test tracing to a given lambda stops at that lambda"
+        point = libgambit.trace_path(self.start, 0.0, 1000000.0,
+                                     self.equations,
+                                     criterion=lambda x, t: x[-1]-2.0)
+        assert abs(point[-1] - 2.0) < 1.0e-6
+        assert abs(self.equations.lhs(point)).max() < 1.0e-6
+
+    def test_callback_equations(self):
+        "Test tracing with equations computed in Python"
+        equations = libgambit.CallbackPathEquations(self.equations.lhs,
+                                                    self.equations.jacobian)
+        steps = [ ]
+        point = libgambit.trace_path(self.start, 0.0, 1000000.0, equations,
+                                     criterion=lambda x, t: x[-1]-2.0,
+                                     callback=steps.append)
+        native = libgambit.trace_path(self.start, 0.0, 1000000.0,
+                                      self.equations,
+                                      criterion=lambda x, t: x[-1]-2.0)
+        assert len(steps) > 0
+        assert abs(point - native).max() < 1.0e-10
+
+    def test_callback_exception(self):
+        "Test that an exception raised in a callback is raised again"
+        def lhs(point):
+            raise KeyError("lhs")
+        equations = libgambit.CallbackPathEquations(lhs,
+                                                    self.equations.jacobian)
+        assert_raises(KeyError, libgambit.trace_path, self.start, 0.0,
+                      10.0, equations)
+
+    def test_symmetric_equations(self):
+        "Test the symmetric equations agree with the strategic ones"
+        game = gambit.Game.new_table([2,2])
+        # Payoffs to a strategy depend on the sum of the others' strategies
+        table = [ [ 3.0, 0.0 ], [ 5.0, 1.0 ] ]
+        for i in xrange(2):
+            for j in xrange(2):
+                game[i,j][0] = int(table[i][j])
+                game[i,j][1] = int(table[j][i])
+        sym = libgambit.SymmetricQREEquations(2, table)
+        full = libgambit.StrategicQREEquations(game)
+        p = [ math.log(0.3), math.log(0.7) ]
+        assert abs(sym.lhs(p + [ 1.5 ])[1] - full.lhs(p + p + [ 1.5 ])[1]) < 1.0e-10
+        assert_raises(ValueError, libgambit.SymmetricQREEquations, 2,
+                      [ [ 1.0 ], [ 2.0 ] ])
@@ -1,5 +1,7 @@
 import gambit
+import fractions
 import warnings
+from nose.tools import assert_raises
 
 class TestGambitStrategicGame(object):
     def setUp(self):
@@ -72,3 +74,21 @@ class TestGambitStrategicGame(object):
         assert self.game.players[1].strategies[1].label == "Defect"
 
     
+
+    def test_payoff_tensor(self):
+        "Test setting and retrieving all payoffs as an array"
+        import numpy
+        payoffs = numpy.array([[[3, 0], [5, 1]], [[3, 5], [0, 1]]])
+        self.game.set_payoff_tensor(payoffs)
+        assert self.game[1,0][0] == 5
+        assert self.game[0,1][1] == 5
+        assert (self.game.payoff_tensor() == payoffs).all()
+        self.game.set_payoff_tensor(payoffs / 4.0)
+        assert self.game[1,1][1] == fractions.Fraction(1, 4)
+        assert len(self.game.outcomes) == 4
+
+    def test_payoff_tensor_shape(self):
+        "Test that a payoff array of the wrong shape is rejected"
+        import numpy
+        assert_raises(ValueError, self.game.set_payoff_tensor, numpy.zeros((2, 2)))
+
@@ -0,0 +1,708 @@
+//
+// This file is part of Gambit
+// Copyright (c) 1994-2014, The Gambit Project (http://www.gambit-project.org)
+//
+// FILE: src/tools/bench/bench.cc
+// Timings of the core kernels and the command-line solvers
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+//
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cerrno>
+#include <vector>
+#include <unistd.h>
+#include <getopt.h>
+#include <sys/time.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <signal.h>
+#include "libgambit/libgambit.h"
+#include "libgambit/gameagg.h"
+
+using namespace Gambit;
+
+void PrintBanner(std::ostream &p_stream)
+{
+  p_stream << "Time the core kernels and the solvers on a generated corpus\n";
+  p_stream << "Gambit version " VERSION ", Copyright (C) 1994-2014, The Gambit Project\n";
+  p_stream << "This is free software, distributed under the GNU GPL\n\n";
+}
+
+void PrintHelp(char *progname)
+{
+  PrintBanner(std::cerr);
+  std::cerr << "Usage: " << progname << " [OPTIONS]\n";
+  std::cerr << "Writes the timings as JSON to standard output.\n\n";
+
+  std::cerr << "Options:\n";
+  std::cerr << "  -b DIR           run the solvers in DIR (default is the directory\n";
+  std::cerr << "                   of this program)\n";
+  std::cerr << "  -c DIR           write the corpus of games to DIR, and keep it\n";
+  std::cerr << "  -g GROUP         time only GROUP, which is `kernels' or `solvers'\n";
+  std::cerr << "  -l SECONDS       stop a solver after SECONDS (default is 60)\n";
+  std::cerr << "  -t SECONDS       repeat each measurement for at least SECONDS\n";
+  std::cerr << "                   (default is 0.5)\n";
+  std::cerr << "  -h, --help       print this help message\n";
+  std::cerr << "  -q               quiet mode (suppresses banner and progress)\n";
+  std::cerr << "  -v, --version    print version information\n";
+  exit(1);
+}
+
+static double WallClock(void)
+{
+  struct timeval now;
+  gettimeofday(&now, 0);
+  return now.tv_sec + now.tv_usec * 1.0e-6;
+}
+
+//=========================================================================
+//                            Game corpus
+//=========================================================================
+
+//
+// A linear congruential generator, so the corpus is the same on every
+// platform
+//
+class BenchRandom {
+private:
+  unsigned long m_state;
+
+public:
+  BenchRandom(unsigned long p_seed) : m_state(p_seed) { }
+
+  /// Returns an integer from 0 to p_range - 1
+  int Next(int p_range)
+  {
+    m_state = (m_state * 1103515245ul + 12345ul) & 0x7ffffffful;
+    return (int) ((m_state >> 8) % p_range);
+  }
+};
+
+struct BenchGame {
+  std::string m_name, m_file;
+  Game m_game;
+  /// The solvers run on the game, separated by spaces
+  std::string m_solvers;
+
+  BenchGame(const std::string &p_name, const Game &p_game,
+	    const std::string &p_solvers)
+    : m_name(p_name), m_game(p_game), m_solvers(p_solvers) { }
+};
+
+//
+// A strategic game with payoffs from 0 to 99, or a two-player zero-sum
+// game with payoffs from -50 to 49
+//
+static Game RandomTable(int p_players, int p_strategies, bool p_zeroSum,
+			BenchRandom &p_random)
+{
+  Array<int> dim(p_players);
+  for (int pl = 1; pl <= p_players; pl++) {
+    dim[pl] = p_strategies;
+  }
+  Game game = NewTable(dim);
+  for (int i = 1; i <= game->NumOutcomes(); i++) {
+    GameOutcome outcome = game->GetOutcome(i);
+    if (p_zeroSum) {
+      int value = p_random.Next(100) - 50;
+      outcome->SetPayoff(1, lexical_cast<std::string>(value));
+      outcome->SetPayoff(2, lexical_cast<std::string>(-value));
+    }
+    else {
+      for (int pl = 1; pl <= p_players; pl++) {
+	outcome->SetPayoff(pl, lexical_cast<std::string>(p_random.Next(100)));
+      }
+    }
+  }
+  return game;
+}
+
+//
+// An action graph game in which each player chooses one of p_actions
+// shared actions, and the payoff of an action depends on how many
+// choose it and the next action
+//
+static Game RandomAgg(int p_players, int p_actions, int p_seed)
+{
+  std::vector<int> actions(p_players, p_actions);
+  std::vector<std::vector<int> > actionSets(p_players);
+  for (int pl = 0; pl < p_players; pl++) {
+    for (int a = 0; a < p_actions; a++) {
+      actionSets[pl].push_back(a);
+    }
+  }
+  std::vector<std::vector<int> > neighbors(p_actions);
+  for (int a = 0; a < p_actions; a++) {
+    neighbors[a].push_back(a);
+    neighbors[a].push_back((a + 1) % p_actions);
+  }
+  std::vector<projtype> projTypes;
+
+  // The generator reports the size of the game on standard output,
+  // which carries the timings
+  std::ostringstream report;
+  std::streambuf *saved = std::cout.rdbuf(report.rdbuf());
+  agg *aggPtr = agg::makeRandomAGG(p_players, &actions[0], p_actions, 0,
+				   actionSets, neighbors, projTypes,
+				   p_seed, true, 100);
+  std::cout.rdbuf(saved);
+  return GameAggRep::FromAgg(aggPtr);
+}
+
+//
+// A two-player zero-sum game of perfect information: a complete binary
+// tree of depth p_depth, the players moving alternately
+//
+static void BuildTree(const GameNode &p_node, int p_depth, int p_player,
+		      BenchRandom &p_random)
+{
+  Game game = p_node->GetGame();
+  if (p_depth == 0) {
+    GameOutcome outcome = game->NewOutcome();
+    int value = p_random.Next(100) - 50;
+    outcome->SetPayoff(1, lexical_cast<std::string>(value));
+    outcome->SetPayoff(2, lexical_cast<std::string>(-value));
+    p_node->SetOutcome(outcome);
+    return;
+  }
+  p_node->AppendMove(game->GetPlayer(p_player), 2);
+  for (int i = 1; i <= 2; i++) {
+    BuildTree(p_node->GetChild(i), p_depth - 1, 3 - p_player, p_random);
+  }
+}
+
+static Game RandomTree(int p_depth, BenchRandom &p_random)
+{
+  Game game = NewTree();
+  game->NewPlayer()->SetLabel("1");
+  game->NewPlayer()->SetLabel("2");
+  BuildTree(game->GetRoot(), p_depth, 1, p_random);
+  return game;
+}
+
+//
+// The corpus: families of games of increasing size, each with the
+// solvers which apply to it and finish in reasonable time
+//
+static std::vector<BenchGame> MakeCorpus(void)
+{
+  BenchRandom random(1);
+  std::vector<BenchGame> corpus;
+  const int sizes2[] = { 4, 8, 12 };
+  for (int i = 0; i < 3; i++) {
+    std::string size = lexical_cast<std::string>(sizes2[i]);
+    corpus.push_back(BenchGame("table-2p-" + size,
+			       RandomTable(2, sizes2[i], false, random),
+			       (sizes2[i] < 12) ?
+			       "enummixed enumpure gnm ipa lcp liap logit" :
+			       "enumpure gnm ipa lcp liap logit"));
+    corpus.push_back(BenchGame("zerosum-2p-" + size,
+			       RandomTable(2, sizes2[i], true, random),
+			       "lcp lp"));
+  }
+  // simpdiv does not finish on some of the random two-player games
+  for (int n = 2; n <= 4; n++) {
+    std::string size = lexical_cast<std::string>(n);
+    corpus.push_back(BenchGame("table-3p-" + size,
+			       RandomTable(3, n, false, random),
+			       (n == 2) ?
+			       "enumpoly enumpure gnm ipa liap logit simpdiv" :
+			       "enumpure gnm ipa liap logit simpdiv"));
+  }
+  for (int n = 4; n <= 6; n += 2) {
+    corpus.push_back(BenchGame("agg-" + lexical_cast<std::string>(n) + "p",
+			       RandomAgg(n, 4, n), "enumpure gnm ipa"));
+  }
+  for (int depth = 2; depth <= 4; depth++) {
+    corpus.push_back(BenchGame("tree-" + lexical_cast<std::string>(depth),
+			       RandomTree(depth, random),
+			       "enumpure lcp logit lp"));
+  }
+  return corpus;
+}
+
+static std::string FileExtension(const Game &p_game)
+{
+  if (p_game->IsTree())  return ".efg";
+  if (p_game->IsAgg())  return ".agg";
+  return ".nfg";
+}
+
+//=========================================================================
+//                               Kernels
+//=========================================================================
+
+class BenchKernel {
+public:
+  virtual ~BenchKernel() { }
+  virtual void Run(void) = 0;
+};
+
+// Results are added here, so the work cannot be optimized away
+static volatile double s_sink;
+
+class ReadKernel : public BenchKernel {
+private:
+  std::string m_text;
+public:
+  ReadKernel(const std::string &p_text) : m_text(p_text) { }
+  void Run(void)
+  { std::istringstream s(m_text);  s_sink += ReadGame(s)->NumPlayers(); }
+};
+
+class WriteKernel : public BenchKernel {
+private:
+  Game m_game;
+public:
+  WriteKernel(const Game &p_game) : m_game(p_game) { }
+  void Run(void)
+  { std::ostringstream s;  m_game->Write(s);  s_sink += s.str().length(); }
+};
+
+class PayoffKernel : public BenchKernel {
+private:
+  MixedStrategyProfile<double> m_profile;
+public:
+  PayoffKernel(const Game &p_game)
+    : m_profile(p_game->NewMixedStrategyProfile(0.0)) { }
+  void Run(void)
+  {
+    for (int pl = 1; pl <= m_profile.GetGame()->NumPlayers(); pl++) {
+      s_sink += m_profile.GetPayoff(pl);
+    }
+  }
+};
+
+class PayoffDerivKernel : public BenchKernel {
+private:
+  MixedStrategyProfile<double> m_profile;
+public:
+  PayoffDerivKernel(const Game &p_game)
+    : m_profile(p_game->NewMixedStrategyProfile(0.0)) { }
+  void Run(void)
+  {
+    Game game = m_profile.GetGame();
+    for (int pl = 1; pl <= game->NumPlayers(); pl++) {
+      GamePlayer player = game->GetPlayer(pl);
+      for (int st = 1; st <= player->NumStrategies(); st++) {
+	s_sink += m_profile.GetPayoffDeriv(pl, player->GetStrategy(st));
+      }
+    }
+  }
+};
+
+class SolutionDataKernel : public BenchKernel {
+private:
+  MixedBehaviorProfile<double> m_profile;
+public:
+  SolutionDataKernel(const Game &p_game) : m_profile(p_game) { }
+  void Run(void)
+  {
+    m_profile.Invalidate();
+    s_sink += m_profile.GetRealizProb(m_profile.GetGame()->GetRoot());
+  }
+};
+
+//
+// Runs the kernel until p_minTime seconds have passed, and at least
+// once, returning the number of runs and the mean time of each
+//
+static void TimeKernel(BenchKernel &p_kernel, double p_minTime,
+		       long &p_runs, double &p_seconds)
+{
+  double start = WallClock(), elapsed;
+  p_runs = 0;
+  do {
+    p_kernel.Run();
+    p_runs++;
+    elapsed = WallClock() - start;
+  } while (elapsed < p_minTime);
+  p_seconds = elapsed / p_runs;
+}
+
+//=========================================================================
+//                               Output
+//=========================================================================
+
+//
+// Writes the records of a JSON array, one object per line
+//
+class JsonArray {
+private:
+  std::ostream &m_stream;
+  bool m_firstRecord, m_firstField;
+
+  static std::string Quote(const std::string &p_value)
+  {
+    std::string quoted("\"");
+    for (size_t i = 0; i < p_value.length(); i++) {
+      if (p_value[i] == '"' || p_value[i] == '\\')  quoted += '\\';
+      quoted += p_value[i];
+    }
+    return quoted + "\"";
+  }
+
+public:
+  JsonArray(std::ostream &p_stream, const std::string &p_name)
+    : m_stream(p_stream), m_firstRecord(true), m_firstField(true)
+  { m_stream << "  \"" << p_name << "\": ["; }
+
+  /// Ends the last record and the array
+  void Close(void)
+  { m_stream << ((m_firstRecord) ? "" : " }") << "\n  ]"; }
+
+  /// Starts a record, whose fields are then written with Field()
+  JsonArray &Record(void)
+  {
+    m_stream << ((m_firstRecord) ? "\n    { " : " },\n    { ");
+    m_firstRecord = false;
+    m_firstField = true;
+    return *this;
+  }
+
+  template <class T> JsonArray &Field(const std::string &p_name,
+				      const T &p_value)
+  {
+    m_stream << ((m_firstField) ? "" : ", ") << '"' << p_name << "\": "
+	     << p_value;
+    m_firstField = false;
+    return *this;
+  }
+  JsonArray &Field(const std::string &p_name, const std::string &p_value)
+  { return Field<std::string>(p_name, Quote(p_value)); }
+  JsonArray &Field(const std::string &p_name, const char *p_value)
+  { return Field<std::string>(p_name, Quote(p_value)); }
+};
+
+//=========================================================================
+//                               Solvers
+//=========================================================================
+
+struct BenchSolver {
+  const char *m_name;
+  /// The options the solver is run with, besides -q
+  const char *m_options;
+};
+
+// The logit branch is not written out, as printing it would dominate
+static const BenchSolver s_solvers[] = {
+  { "enummixed", "" },
+  { "enumpoly", "" },
+  { "enumpure", "" },
+  { "gnm", "" },
+  { "ipa", "" },
+  { "lcp", "" },
+  { "liap", "" },
+  { "logit", "-e" },
+  { "lp", "" },
+  { "simpdiv", "" },
+  { 0, 0 }
+};
+
+static bool ContainsWord(const std::string &p_list, const std::string &p_word)
+{
+  std::istringstream s(p_list);
+  std::string word;
+  while (s >> word) {
+    if (word == p_word)  return true;
+  }
+  return false;
+}
+
+static int CountLines(const std::string &p_file)
+{
+  std::ifstream f(p_file.c_str());
+  std::string line;
+  int count = 0;
+  while (std::getline(f, line)) {
+    count++;
+  }
+  return count;
+}
+
+enum SolverStatus { SOLVER_OK, SOLVER_FAILED, SOLVER_TIMEOUT };
+
+static const char *StatusName(SolverStatus p_status)
+{
+  switch (p_status) {
+  case SOLVER_OK:  return "ok";
+  case SOLVER_TIMEOUT:  return "timeout";
+  default:  return "failed";
+  }
+}
+
+// Does nothing, but interrupts waitpid() when the time limit is up
+extern "C" void OnTimeLimit(int) { }
+
+//
+// Runs p_command in the shell, killing it (and anything it started)
+// if it takes more than p_limit seconds
+//
+static SolverStatus RunCommand(const std::string &p_command, int p_limit)
+{
+  pid_t pid = fork();
+  if (pid < 0) {
+    return SOLVER_FAILED;
+  }
+  if (pid == 0) {
+    setpgid(0, 0);
+    execl("/bin/sh", "sh", "-c", p_command.c_str(), (char *) 0);
+    _exit(127);
+  }
+  setpgid(pid, pid);
+
+  struct sigaction action, saved;
+  memset(&action, 0, sizeof(action));
+  action.sa_handler = OnTimeLimit;
+  sigaction(SIGALRM, &action, &saved);
+  alarm(p_limit);
+  int status;
+  pid_t result = waitpid(pid, &status, 0);
+  alarm(0);
+  sigaction(SIGALRM, &saved, 0);
+  if (result < 0) {
+    kill(-pid, SIGKILL);
+    waitpid(pid, &status, 0);
+    return SOLVER_TIMEOUT;
+  }
+  return (WIFEXITED(status) && WEXITSTATUS(status) == 0) ?
+    SOLVER_OK : SOLVER_FAILED;
+}
+
+//
+// Runs the solver until p_minTime seconds have passed, and at least
+// once.  Each run is a new process, so this includes reading the game.
+// Stops early if a run fails or takes more than p_limit seconds.
+//
+static SolverStatus TimeSolver(const std::string &p_command,
+			       double p_minTime, int p_limit,
+			       long &p_runs, double &p_seconds)
+{
+  double start = WallClock(), elapsed;
+  p_runs = 0;
+  do {
+    SolverStatus status = RunCommand(p_command, p_limit);
+    if (status != SOLVER_OK) {
+      return status;
+    }
+    p_runs++;
+    elapsed = WallClock() - start;
+  } while (elapsed < p_minTime);
+  p_seconds = elapsed / p_runs;
+  return SOLVER_OK;
+}
+
+//=========================================================================
+//                                 Main
+//=========================================================================
+
+int main(int argc, char *argv[])
+{
+  opterr = 0;
+  bool quiet = false, timeKernels = true, timeSolvers = true;
+  double minTime = 0.5;
+  int timeLimit = 60;
+  std::string binDir, corpusDir;
+
+  // The directory this program is in, where the solvers are installed
+  const char *slash = strrchr(argv[0], '/');
+  if (slash) {
+    binDir = std::string(argv[0], slash - argv[0]);
+  }
+
+  int long_opt_index = 0;
+  struct option long_options[] = {
+    { "help", 0, NULL, 'h'   },
+    { "version", 0, NULL, 'v'  },
+    { 0,    0,    0,    0   }
+  };
+  int c;
+  while ((c = getopt_long(argc, argv, "b:c:g:l:t:vhq", long_options, &long_opt_index)) != -1) {
+    switch (c) {
+    case 'v':
+      PrintBanner(std::cerr); exit(1);
+    case 'b':
+      binDir = optarg;
+      break;
+    case 'c':
+      corpusDir = optarg;
+      break;
+    case 'g':
+      timeKernels = (std::string(optarg) == "kernels");
+      timeSolvers = (std::string(optarg) == "solvers");
+      if (!timeKernels && !timeSolvers) {
+	std::cerr << argv[0] << ": Unknown group `" << optarg << "'.\n";
+	return 1;
+      }
+      break;
+    case 'l':
+      timeLimit = atoi(optarg);
+      break;
+    case 't':
+      minTime = atof(optarg);
+      break;
+    case 'h':
+      PrintHelp(argv[0]);
+      break;
+    case 'q':
+      quiet = true;
+      break;
+    case '?':
+      if (isprint(optopt)) {
+	std::cerr << argv[0] << ": Unknown option `-" << ((char) optopt) << "'.\n";
+      }
+      else {
+	std::cerr << argv[0] << ": Unknown option character `\\x" << optopt << "`.\n";
+      }
+      return 1;
+    default:
+      abort();
+    }
+  }
+
+  if (!quiet) {
+    PrintBanner(std::cerr);
+  }
+
+  bool keepCorpus = !corpusDir.empty();
+  if (keepCorpus) {
+    if (mkdir(corpusDir.c_str(), 0777) != 0 && errno != EEXIST) {
+      std::ostringstream error_message;
+      error_message << argv[0] << ": " << corpusDir;
+      perror(error_message.str().c_str());
+      return 1;
+    }
+  }
+  else {
+    char dirTemplate[] = "/tmp/gambit-bench-XXXXXX";
+    if (!mkdtemp(dirTemplate)) {
+      perror(argv[0]);
+      return 1;
+    }
+    corpusDir = dirTemplate;
+  }
+  // Solvers are timed doing the work themselves, not sending it to
+  // gambit-server
+  setenv("GAMBIT_SERVER", "", 1);
+
+  try {
+    std::vector<BenchGame> corpus = MakeCorpus();
+    for (size_t i = 0; i < corpus.size(); i++) {
+      corpus[i].m_file = (corpusDir + "/" + corpus[i].m_name +
+			  FileExtension(corpus[i].m_game));
+      std::ofstream f(corpus[i].m_file.c_str());
+      corpus[i].m_game->Write(f);
+      if (!f) {
+	throw Exception("Unable to write " + corpus[i].m_file);
+      }
+    }
+
+    std::cout.precision(6);
+    std::cout << "{\n  \"version\": \"" VERSION "\",\n";
+    std::cout << "  \"min_time\": " << minTime << ",\n";
+
+    JsonArray kernels(std::cout, "kernels");
+    for (size_t i = 0; timeKernels && i < corpus.size(); i++) {
+      const BenchGame &entry = corpus[i];
+      std::ostringstream text;
+      entry.m_game->Write(text);
+
+      std::vector<std::pair<std::string, BenchKernel *> > timed;
+      timed.push_back(std::make_pair(std::string("read"),
+				     (BenchKernel *) new ReadKernel(text.str())));
+      timed.push_back(std::make_pair(std::string("write"),
+				     (BenchKernel *) new WriteKernel(entry.m_game)));
+      if (entry.m_game->IsTree()) {
+	timed.push_back(std::make_pair(std::string("behav_solution_data"),
+				       (BenchKernel *) new SolutionDataKernel(entry.m_game)));
+      }
+      else {
+	timed.push_back(std::make_pair(std::string("mixed_payoff"),
+				       (BenchKernel *) new PayoffKernel(entry.m_game)));
+	timed.push_back(std::make_pair(std::string("mixed_payoff_deriv"),
+				       (BenchKernel *) new PayoffDerivKernel(entry.m_game)));
+      }
+
+      for (size_t k = 0; k < timed.size(); k++) {
+	long runs;
+	double seconds;
+	TimeKernel(*timed[k].second, minTime, runs, seconds);
+	delete timed[k].second;
+	if (!quiet) {
+	  std::cerr << timed[k].first << " " << entry.m_name << ": "
+		    << seconds << "s\n";
+	}
+	kernels.Record().Field("kernel", timed[k].first)
+	  .Field("game", entry.m_name)
+	  .Field("iterations", runs).Field("seconds", seconds);
+      }
+    }
+    kernels.Close();
+    std::cout << ",\n";
+
+    JsonArray solvers(std::cout, "solvers");
+    std::string output = corpusDir + "/output.txt";
+    for (size_t i = 0; timeSolvers && i < corpus.size(); i++) {
+      const BenchGame &entry = corpus[i];
+      for (const BenchSolver *solver = s_solvers; solver->m_name; solver++) {
+	if (!ContainsWord(entry.m_solvers, solver->m_name))  continue;
+
+	std::string command = "gambit-" + std::string(solver->m_name);
+	if (!binDir.empty()) {
+	  command = "\"" + binDir + "/" + command + "\"";
+	}
+	command += " -q " + std::string(solver->m_options) + " \"" +
+	  entry.m_file + "\" > \"" + output + "\" 2>&1";
+
+	long runs = 0;
+	double seconds = 0.0;
+	SolverStatus status = TimeSolver(command, minTime, timeLimit,
+					 runs, seconds);
+	if (!quiet) {
+	  std::cerr << solver->m_name << " " << entry.m_name << ": ";
+	  if (status == SOLVER_OK)  std::cerr << seconds << "s\n";
+	  else  std::cerr << StatusName(status) << "\n";
+	}
+	solvers.Record().Field("solver", solver->m_name)
+	  .Field("game", entry.m_name)
+	  .Field("options", solver->m_options)
+	  .Field("status", StatusName(status))
+	  .Field("runs", runs).Field("seconds", seconds)
+	  .Field("output_lines", CountLines(output));
+      }
+    }
+    solvers.Close();
+    std::cout << "\n}\n";
+    unlink(output.c_str());
+
+    if (!keepCorpus) {
+      for (size_t i = 0; i < corpus.size(); i++) {
+	unlink(corpus[i].m_file.c_str());
+      }
+      rmdir(corpusDir.c_str());
+    }
+    return 0;
+  }
+  catch (std::runtime_error &e) {
+    std::cerr << "Error: " << e.what() << std::endl;
+    return 1;
+  }
+}
@@ -29,6 +29,7 @@
 #include <iomanip>
 
 #include "libgambit/libgambit.h"
+#include "libgambit/stats.h"
 #include "clique.h"
 #include "vertenum.imp"
 
@@ -264,6 +265,8 @@ void PrintHelp(char *progname)
   std::cerr << "  -h, --help       print this help message\n";
   std::cerr << "  -q               quiet mode (suppresses banner)\n";
   std::cerr << "  -v, --version    print version information\n";
+  std::cerr << "  --stats[=FORMAT] on exit, print solver statistics to standard error\n";
+  std::cerr << "                   as json (the default) or csv\n";
   exit(1);
 }
 
@@ -276,6 +279,7 @@ int main(int argc, char *argv[])
   struct option long_options[] = {
     { "help", 0, NULL, 'h'   },
     { "version", 0, NULL, 'v'  },
+    { "stats", optional_argument, NULL, STATS_OPTION },
     { 0,    0,    0,    0   }
   };
   while ((c = getopt_long(argc, argv, "d:DvhqcS", long_options, &long_opt_index)) != -1) {
@@ -303,6 +307,12 @@ int main(int argc, char *argv[])
     case 'q':
       quiet = true;
       break;
+    case STATS_OPTION:
+      if (!EnableStats((optarg) ? optarg : "json")) {
+	std::cerr << argv[0] << ": Unknown statistics format `" << optarg << "'.\n";
+	return 1;
+      }
+      break;
     case '?':
       if (isprint(optopt)) {
 	std::cerr << argv[0] << ": Unknown option `-" << ((char) optopt) << "'.\n";
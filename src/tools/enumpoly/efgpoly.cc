@@ -36,6 +36,7 @@ using namespace Gambit;
 
 extern int g_numDecimals;
 extern bool g_verbose;
+extern int g_numThreads;
 
 //
 // A class to organize the data needed to build the polynomials
@@ -269,6 +270,7 @@ SolveSupport(const BehaviorSupportProfile &p_support, bool &p_isSingular)
   gRectangle<double> Cube(bottoms, tops); 
 
   QuikSolv<double> quickie(equations);
+  quickie.SetNumberOfThreads(g_numThreads);
 #ifdef UNUSED
   if(params.trace>0) {
     (*params.tracefile) << "\nThe equilibrium equations are \n" 
@@ -27,10 +27,13 @@
 #include <unistd.h>
 #include <getopt.h>
 #include "libgambit/libgambit.h"
+#include "libgambit/thread.h"
+#include "libgambit/stats.h"
 #include "nfghs.h"
 
 int g_numDecimals = 6;
 bool g_verbose = false;
+int g_numThreads = 1;
 
 void PrintBanner(std::ostream &p_stream)
 {
@@ -54,8 +57,12 @@ void PrintHelp(char *progname)
   std::cerr << "  -H               use heuristic search method to optimize time\n";
   std::cerr << "                   to find first equilibrium (strategic games only)\n";
   std::cerr << "  -q               quiet mode (suppresses banner)\n";
+  std::cerr << "  -t THREADS       search for roots using THREADS threads (default 1;\n";
+  std::cerr << "                   0 uses one per processor)\n";
   std::cerr << "  -V, --verbose    verbose mode (shows supports investigated)\n";
   std::cerr << "  -v, --version    print version information\n";
+  std::cerr << "  --stats[=FORMAT] on exit, print solver statistics to standard error\n";
+  std::cerr << "                   as json (the default) or csv\n";
   std::cerr << "                   (default is only to show equilibria)\n";
   exit(1);
 }
@@ -74,11 +81,12 @@ int main(int argc, char *argv[])
   struct option long_options[] = {
     { "help", 0, NULL, 'h'   },
     { "version", 0, NULL, 'v'  },
+    { "stats", optional_argument, NULL, STATS_OPTION },
     { "verbose", 0, NULL, 'V'  },
     { 0,    0,    0,    0   }
   };
   int c;
-  while ((c = getopt_long(argc, argv, "d:hHSqvV", long_options, &long_opt_index)) != -1) {
+  while ((c = getopt_long(argc, argv, "d:hHSqt:vV", long_options, &long_opt_index)) != -1) {
     switch (c) {
     case 'v':
       PrintBanner(std::cerr); exit(1);
@@ -97,9 +105,21 @@ int main(int argc, char *argv[])
     case 'q':
       quiet = true;
       break;
+    case 't':
+      g_numThreads = atoi(optarg);
+      if (g_numThreads <= 0) {
+	g_numThreads = Gambit::NumberOfProcessors();
+      }
+      break;
     case 'V':
       g_verbose = true;
       break;
+    case STATS_OPTION:
+      if (!EnableStats((optarg) ? optarg : "json")) {
+	std::cerr << argv[0] << ": Unknown statistics format `" << optarg << "'.\n";
+	return 1;
+      }
+      break;
     case '?':
       if (isprint(optopt)) {
 	std::cerr << argv[0] << ": Unknown option `-" << ((char) optopt) << "'.\n";
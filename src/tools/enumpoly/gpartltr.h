@@ -28,6 +28,7 @@
 #include "rectangl.h"
 #include "gpoly.h"
 #include "gpolylst.h"
+#include "gpolyflt.h"
 
 // ****************************
 //      class TreeOfPartials
@@ -36,11 +37,24 @@
 template <class T> class TreeOfPartials {
 private:
   gTree<gPoly<T> > PartialTree;
+  // The polynomials of PartialTree compiled in preorder; the
+  // descendants of node k are k+1 .. SubtreeEnd[k]-1, and the children
+  // of a node are the partials with respect to variables 1, 2, ...
+  gFlatPolyList<T> FlatTree;
+  std::vector<int> SubtreeEnd;
+  bool RootIsMultiaffine;
+  Gambit::Array<bool> RootUsesVar;
 
   /// Recursive Constructions and Computations ///
 
    void TreeOfPartialsRECURSIVE(gTree<gPoly<T> >&,
 				gTreeNode<gPoly<T> >*)         const;
+   void FlattenRECURSIVE(const gTreeNode<gPoly<T> >*);
+
+   T MaximalNonconstantContributionRECURSIVE(int,
+		      	        const std::vector<T>&,
+			        const Gambit::Vector<T>&,
+		       	              Gambit::Vector<int>&)           const;
 
    T MaximalNonconstantContributionRECURSIVE(
 				const gTreeNode<gPoly<T> >*,
@@ -65,7 +79,7 @@ public:
    inline bool operator !=(const TreeOfPartials<T>& rhs) const 
      { return !(*this == rhs); }
    inline int Dmnsn()                                    const 
-     { return RootNode()->GetData().Dmnsn(); }
+     { return FlatTree.Dmnsn(); }
    T EvaluateRootPoly(const Gambit::Vector<T>& point)    const; 
 
 
@@ -98,6 +112,7 @@ public:
 template <class T> class ListOfPartialTrees {
 private:
   Gambit::List<TreeOfPartials<T> >     PartialTreeList;
+  gFlatPolyList<T>                     RootPolys;
 
   // Disabling this operator -- we don't want it called
   ListOfPartialTrees<T> &operator=(const ListOfPartialTrees<T> &);
@@ -124,6 +139,8 @@ public:
   Gambit::Matrix<T> DerivativeMatrix(const Gambit::Vector<T>&, const int&)      const; 
   Gambit::SquareMatrix<T> SquareDerivativeMatrix(const Gambit::Vector<T>&)      const; 
   Gambit::Vector<T> ValuesOfRootPolys(const Gambit::Vector<T>&, const int&)     const;
+  void ValuesAndDerivatives(const Gambit::Vector<T>&, const int&,
+			    Gambit::Vector<T>&, Gambit::Matrix<T>&)    const;
    T         MaximalNonconstantDifference(const int&,
 					  const int&,
 					  const Gambit::Vector<T>&, 
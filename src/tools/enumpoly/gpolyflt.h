@@ -0,0 +1,98 @@
+//
+// This file is part of Gambit
+// Copyright (c) 1994-2014, The Gambit Project (http://www.gambit-project.org)
+//
+// FILE: src/tools/enumpoly/gpolyflt.h
+// Declaration of flattened polynomial lists for fast evaluation
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+//
+
+#ifndef GPOLYFLT_H
+#define GPOLYFLT_H
+
+#include <vector>
+#include "libgambit/libgambit.h"
+#include "gpoly.h"
+
+template <class T> class gPolyList;
+
+/*
+   A gFlatPolyList is a list of polynomials compiled once into
+contiguous arrays, for use where the same polynomials are evaluated
+over and over at different points (rectangle subdivision and Newton
+steps in QuikSolv and IneqSolv).  Terms are stored CSR-style: the
+terms of polynomial i are a contiguous block of coefficients, and
+the factors x_j^e of each term are a contiguous block of indices into
+a table of powers of the coordinates.  The power table is filled once
+per point and shared by all polynomials in the list.
+
+   The term order of each gPoly, and the order of the variables
+within each monomial, are preserved, so that for multiaffine
+polynomials the values computed agree exactly with gPoly::Evaluate()
+and with evaluating gPoly::PartialDerivative().  The gPoly
+representation remains the reference for exact arithmetic.
+*/
+
+template <class T> class gFlatPolyList {
+private:
+  int m_dmnsn;
+  // Terms of polynomial i are m_polyStart[i-1] .. m_polyStart[i]-1
+  std::vector<int> m_polyStart;
+  std::vector<T> m_coef;
+  // Factors of term t are m_termStart[t] .. m_termStart[t+1]-1
+  std::vector<int> m_termStart, m_var, m_exp;
+  // Index into the power table of x_var^exp, and of x_var^(exp-1)
+  // (or -1 if exp == 1)
+  std::vector<int> m_power, m_lowerPower;
+  // Powers of coordinate j occupy m_powerStart[j-1] .. m_powerStart[j]-1
+  std::vector<int> m_powerStart;
+
+  void Compile(const gPoly<T> &);
+  void BuildPowerIndex(void);
+  T EvaluateTerms(int p_poly, const T *p_powers) const;
+
+public:
+  gFlatPolyList(int p_dmnsn);
+  gFlatPolyList(const Gambit::List<gPoly<T> > &);
+  gFlatPolyList(const gPolyList<T> &);
+  ~gFlatPolyList() { }
+
+  /// Compile another polynomial onto the end of the list
+  void Append(const gPoly<T> &);
+
+  int Length(void) const { return m_polyStart.size() - 1; }
+  int Dmnsn(void) const { return m_dmnsn; }
+  int NumTerms(int i) const { return m_polyStart[i] - m_polyStart[i-1]; }
+
+  /// Fill p_powers with the power table for the point
+  void ComputePowers(const Gambit::Vector<T> &, std::vector<T> &p_powers) const;
+  /// Value of the i'th polynomial, given a power table
+  T Evaluate(int i, const std::vector<T> &p_powers) const
+    { return EvaluateTerms(i, (p_powers.empty()) ? 0 : &p_powers[0]); }
+
+  /// Value of the i'th polynomial at a point
+  T Evaluate(int i, const Gambit::Vector<T> &) const;
+  /// Values of the first p_length polynomials at a point
+  void Evaluate(const Gambit::Vector<T> &, int p_length,
+		Gambit::Vector<T> &p_values) const;
+  /// Values and first partial derivatives of the first p_length
+  /// polynomials, sharing one power table
+  void EvaluateWithJacobian(const Gambit::Vector<T> &, int p_length,
+			    Gambit::Vector<T> &p_values,
+			    Gambit::Matrix<T> &p_jacobian) const;
+};
+
+#endif  // GPOLYFLT_H
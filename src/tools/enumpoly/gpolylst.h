@@ -27,6 +27,8 @@
 #include <libgambit/sqmatrix.h>
 #include "gpoly.h"
 
+template <class T> class gFlatPolyList;
+
 //!
 //! Simple class for compact reference to pairs of indices
 //!
@@ -58,6 +60,12 @@ template <class T> class gPolyList
    const gSpace*      Space;
    const term_order*  Order;
    Gambit::List< gPoly<T> *> List;
+   // The list compiled for evaluation, built on first use by the
+   // derivative matrices at a point, and discarded when List changes
+   mutable gFlatPolyList<T> *Flat;
+
+   const gFlatPolyList<T> &FlatList() const;
+   void        InvalidateFlatList();
    
    // SubProcedures of ToSortedReducedGrobner   
    void        Sort(const term_order &);
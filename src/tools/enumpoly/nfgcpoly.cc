@@ -24,6 +24,8 @@
 
 #include "nfgcpoly.h"
 
+extern int g_numThreads;
+
 //-------------------------------------------------------------------------
 //              HeuristicPolEnumModule: Member functions
 //-------------------------------------------------------------------------
@@ -207,6 +209,7 @@ HeuristicPolEnumModule::NashOnSupportSolnVectors(const gPolyList<double> &equati
 					const gRectangle<double> &Cube)
 {  
   QuikSolv<double> quickie(equations);
+  quickie.SetNumberOfThreads(g_numThreads);
   //  p_status.SetProgress(0);
 
   try {
@@ -32,6 +32,7 @@
 
 extern int g_numDecimals;
 extern bool g_verbose; 
+extern int g_numThreads;
 
 class PolEnumModule  {
 private:
@@ -263,6 +264,7 @@ PolEnumModule::NashOnSupportSolnVectors(const gPolyList<double> &equations,
 					const gRectangle<double> &Cube)
 {  
   QuikSolv<double> quickie(equations);
+  quickie.SetNumberOfThreads(g_numThreads);
   //  p_status.SetProgress(0);
 
   try {
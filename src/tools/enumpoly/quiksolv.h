@@ -23,7 +23,9 @@
 #ifndef QUIKSOLV_H
 #define QUIKSOLV_H
 
+#include <vector>
 #include "libgambit/libgambit.h"
+#include "libgambit/thread.h"
 #include "odometer.h"
 #include "gsolver.h"
 #include "rectangl.h"
@@ -74,6 +76,7 @@ template <class T> class QuikSolv {
         Gambit::List<Gambit::Vector<double> >     Roots;
   const bool                         isMultiaffine;
   const Gambit::RectArray<bool>             Equation_i_uses_var_j;
+        int                          NumThreads;
 
   // Supporting routines for the constructors
 
@@ -129,6 +132,24 @@ template <class T> class QuikSolv {
 					const int&,
 					      int*)                  const;
 
+  // Parallel subdivision: boxes are kept on a shared stack and taken
+  // by worker threads, each holding its own copy of the solver
+  class SubdivisionBox;
+  class SubdivisionRoot;
+  class SubdivisionState;
+  static void SubdivisionWorker(void *, int);
+  void               SubdivideBox(SubdivisionState &,
+				  const gRectangle<double> &, int,
+				  const std::vector<int> &,
+				  Gambit::Array<int> &,
+				  std::vector<SubdivisionRoot> &)   const;
+  void               FindRootsInParallel(
+				      Gambit::List<Gambit::Vector<double> >*,
+				const gRectangle<double>&, 
+				const int&,
+				      int &iterations,
+				const int&)                  const;
+
   const bool         ARootExistsRecursion(const gRectangle<double>&, 
 					        Gambit::Vector<double>&,
 					  const gRectangle<double>&, 
@@ -167,6 +188,12 @@ template <class T> class QuikSolv {
    inline const bool                     IsMultiaffine()             const
      { return isMultiaffine; }
 
+   // Number of threads used to subdivide the search rectangle
+   inline int                            NumberOfThreads()           const
+     { return NumThreads; }
+   inline void                           SetNumberOfThreads(int p_threads)
+     { NumThreads = (p_threads >= 1) ? p_threads : 1; }
+
   // Refines the accuracy of roots obtained from other algorithms
   Gambit::Vector<double> NewtonPolishOnce(const Gambit::Vector<double> &)        const;
   Gambit::Vector<double> SlowNewtonPolishOnce(const Gambit::Vector<double> &)    const;
@@ -27,6 +27,8 @@
 #include <fstream>
 #include <cerrno>
 #include "enumpure.h"
+#include "libgambit/stats.h"
+#include "tools/server/protocol.h"
 
 
 void PrintBanner(std::ostream &p_stream)
@@ -49,7 +51,11 @@ void PrintHelp(char *progname)
   std::cerr << "  -P               find only subgame-perfect equilibria\n";
   std::cerr << "  -h, --help       print this help message\n";
   std::cerr << "  -q               quiet mode (suppresses banner)\n";
+  std::cerr << "  -t THREADS       search using THREADS threads (default 1;\n";
+  std::cerr << "                   0 uses one per processor)\n";
   std::cerr << "  -v, --version    print version information\n";
+  std::cerr << "  --stats[=FORMAT] on exit, print solver statistics to standard error\n";
+  std::cerr << "                   as json (the default) or csv\n";
   exit(1);
 }
 
@@ -59,15 +65,17 @@ int main(int argc, char *argv[])
   opterr = 0;
   bool quiet = false, reportStrategic = false, solveAgent = false, bySubgames = false;
   bool printDetail = false;
+  int numThreads = 1;
   
   int long_opt_index = 0;
   struct option long_options[] = {
     { "help", 0, NULL, 'h'   },
     { "version", 0, NULL, 'v'  },
+    { "stats", optional_argument, NULL, STATS_OPTION },
     { 0,    0,    0,    0   }
   };
   int c;
-  while ((c = getopt_long(argc, argv, "DvhqASP", long_options, &long_opt_index)) != -1) {
+  while ((c = getopt_long(argc, argv, "DvhqASPt:", long_options, &long_opt_index)) != -1) {
     switch (c) {
     case 'v':
       PrintBanner(std::cerr); exit(1);
@@ -89,6 +97,18 @@ int main(int argc, char *argv[])
     case 'q':
       quiet = true;
       break;
+    case 't':
+      numThreads = atoi(optarg);
+      if (numThreads <= 0) {
+	numThreads = NumberOfProcessors();
+      }
+      break;
+    case STATS_OPTION:
+      if (!EnableStats((optarg) ? optarg : "json")) {
+	std::cerr << argv[0] << ": Unknown statistics format `" << optarg << "'.\n";
+	return 1;
+      }
+      break;
     case '?':
       if (isprint(optopt)) {
 	std::cerr << argv[0] << ": Unknown option `-" << ((char) optopt) << "'.\n";
@@ -120,7 +140,18 @@ int main(int argc, char *argv[])
   }
 
   try {
-    Game game = ReadGame(*input_stream);
+    Game game;
+    if (GetServerPath() != "") {
+      std::string text = ReadGameFile(*input_stream);
+      if (SolveOnServer("enumpure", argc, argv, optind, text, std::cout)) {
+	return 0;
+      }
+      std::istringstream game_stream(text);
+      game = ReadGame(game_stream);
+    }
+    else {
+      game = ReadGame(*input_stream);
+    }
     shared_ptr<StrategyProfileRenderer<Rational> > renderer;
     if (reportStrategic || !game->IsTree()) {
       if (printDetail) {
@@ -139,6 +170,12 @@ int main(int argc, char *argv[])
       }
     }
 
+    if (numThreads > 1) {
+      // The game is only read from here on, so it can be frozen for
+      // the threads to share, instead of the solver copying it
+      game->Freeze();
+    }
+
     if (game->IsTree())  {
       if (bySubgames) {
 	shared_ptr<NashBehavSolver<Rational> > stage;
@@ -147,7 +184,7 @@ int main(int argc, char *argv[])
 	}
 	else {
 	  shared_ptr<NashStrategySolver<Rational> > substage = 
-	    new NashEnumPureStrategySolver();
+	    new NashEnumPureStrategySolver(0, numThreads);
 	  stage = new NashBehavViaStrategySolver<Rational>(substage);
 	}
 	SubgameNashBehavSolver<Rational> algorithm(stage, renderer);
@@ -159,13 +196,13 @@ int main(int argc, char *argv[])
 	  algorithm.Solve(game);
 	}
 	else {
-	  NashEnumPureStrategySolver algorithm(renderer);
+	  NashEnumPureStrategySolver algorithm(renderer, numThreads);
 	  algorithm.Solve(game);
 	}
       }
     }
     else {
-      NashEnumPureStrategySolver algorithm(renderer);
+      NashEnumPureStrategySolver algorithm(renderer, numThreads);
       algorithm.Solve(game);
     }
     return 0;
@@ -23,35 +23,368 @@
 #ifndef ENUMPURE_H
 #define ENUMPURE_H
 
+#include <cmath>
+#include <vector>
 #include "libgambit/libgambit.h"
+#include "libgambit/gametable.h"
+#include "libgambit/mapped.h"
 #include "libgambit/nash.h"
+#include "libgambit/thread.h"
 
 using namespace Gambit;
 
 class NashEnumPureStrategySolver : public NashStrategySolver<Rational> {
 public:
-   NashEnumPureStrategySolver(Gambit::shared_ptr<StrategyProfileRenderer<Rational> > p_onEquilibrium = 0) 
-    : NashStrategySolver<Rational>(p_onEquilibrium) { }
+  /// Construct the solver.  If p_numThreads is more than one, the
+  /// search is shared among that many threads.  This needs a frozen
+  /// game (see GameRep::Freeze()), so unless the game passed to Solve()
+  /// is frozen already, the search is done on a frozen copy of it.
+  NashEnumPureStrategySolver(Gambit::shared_ptr<StrategyProfileRenderer<Rational> > p_onEquilibrium = 0,
+			     int p_numThreads = 1)
+    : NashStrategySolver<Rational>(p_onEquilibrium),
+      m_numThreads((p_numThreads > 1) ? p_numThreads : 1) { }
   virtual ~NashEnumPureStrategySolver()  { }
 
   List<MixedStrategyProfile<Rational> > Solve(const Game &p_game) const;
+
+private:
+  int m_numThreads;
 };
 
+//
+// The search for pure equilibria is done in three passes over the
+// contingencies of the game, which are numbered from zero with
+// player 1's strategy varying fastest; this is the order in which
+// StrategyProfileIterator visits them.
+//
+// 1. For table games, the payoffs of each outcome are copied, as
+//    doubles, into one array per player, and the payoff at a
+//    contingency is looked up through the table's outcome numbers;
+//    this needs no memory per contingency.
+// 2. For each player, and each "line" of contingencies along which
+//    only that player's strategy varies, the contingencies at which
+//    the player is (to within a tolerance) best responding are found.
+//    Contingencies which are off the best response set of any player
+//    are dropped.  For games other than tables, the payoffs along each
+//    line are computed as it is scanned, and only those of the line
+//    are held.
+// 3. The contingencies remaining are confirmed to be equilibria
+//    using exact arithmetic, and reported.
+//
+// The contingencies are read in runs of consecutive ones wherever
+// possible, and the flags recording which have been dropped are held
+// in a MappedBuffer, so that games whose tables are paged from disk
+// can be searched a page at a time.
+//
+// Each pass is divided among the threads.  The last pass works through
+// blocks of contingencies; the equilibria found in each block are
+// reported as soon as all earlier blocks are done, so they are
+// reported as they are found, and in the same order regardless of the
+// number of threads.
+//
+class NashEnumPureSearch {
+private:
+  /// Number of contingencies in a block of the confirmation pass
+  static const long s_blockSize = 65536L;
+  /// Most lines scanned side by side in the second pass
+  static const long s_chunkSize = 4096L;
+
+  /// The game searched, and the game on which equilibria are reported;
+  /// the first is either the second or a frozen copy of it
+  Game m_game, m_original;
+  int m_numThreads;
+  /// Strategies of each player (indexed from zero), and the spacing of
+  /// contingencies along each player's lines
+  std::vector<std::vector<GameStrategy> > m_strategies;
+  std::vector<ContingencyIndex> m_stride;
+  ContingencyIndex m_numContingencies;
+
+  /// For table games, the payoffs of the outcomes, indexed by
+  /// player * m_numPayoffs + outcome number, and the outcome numbers
+  /// of the contingencies
+  std::vector<double> m_payoffs;
+  ContingencyIndex m_numPayoffs;
+  const OutcomeIdArray *m_outcomes;
+  /// Nonzero for contingencies which have been dropped
+  MappedBuffer *m_dropped;
+  /// The player whose lines are being scanned in the second pass
+  int m_player;
+
+  /// State of the confirmation pass, guarded by m_mutex
+  Mutex m_mutex;
+  ContingencyIndex m_nextBlock, m_nextReport;
+  std::vector<bool> m_blockDone;
+  std::vector<std::vector<ContingencyIndex> > m_blockFound;
+  const StrategyProfileRenderer<Rational> *m_onEquilibrium;
+  List<MixedStrategyProfile<Rational> > m_solutions;
+  std::string m_error;
+
+  void SetProfile(PureStrategyProfile &, ContingencyIndex p_index) const;
+  /// Returns the payoff at the contingency of a table game from the
+  /// player's part of m_payoffs
+  double GetPayoff(const double *p_payoffs, ContingencyIndex p_index) const
+  { return p_payoffs[(*m_outcomes)[p_index + 1]]; }
+  /// Returns the profile at the contingency on m_original
+  MixedStrategyProfile<Rational> GetEquilibrium(ContingencyIndex p_index) const;
+  void ScanLines(int p_thread);
+  void ScanComputedLines(int p_thread);
+  void ConfirmCandidates(void);
+
+  static void ScanLinesWorker(void *p_search, int p_thread)
+    { NashEnumPureSearch *search = static_cast<NashEnumPureSearch *>(p_search);
+      if (search->m_outcomes)  search->ScanLines(p_thread);
+      else  search->ScanComputedLines(p_thread); }
+  static void ConfirmWorker(void *p_search, int)
+    { static_cast<NashEnumPureSearch *>(p_search)->ConfirmCandidates(); }
+
+public:
+  NashEnumPureSearch(const Game &p_game, const Game &p_original,
+		     int p_numThreads,
+		     const StrategyProfileRenderer<Rational> &p_onEquilibrium);
+  ~NashEnumPureSearch()  { delete m_dropped; }
+
+  List<MixedStrategyProfile<Rational> > Solve(void);
+};
+
+inline
+NashEnumPureSearch::NashEnumPureSearch(const Game &p_game,
+				       const Game &p_original, int p_numThreads,
+				       const StrategyProfileRenderer<Rational> &p_onEquilibrium)
+  : m_game(p_game), m_original(p_original), m_numThreads(p_numThreads),
+    m_strategies(p_game->NumPlayers()), m_stride(p_game->NumPlayers()),
+    m_numContingencies(1), m_numPayoffs(0), m_outcomes(0), m_dropped(0),
+    m_player(0), m_nextBlock(0), m_nextReport(0),
+    m_onEquilibrium(&p_onEquilibrium)
+{
+  // There is a byte flag for each contingency, so the number of them
+  // must fit in a size_t as well
+  const ContingencyIndex limit = 
+    (sizeof(size_t) < sizeof(ContingencyIndex)) ?
+    (ContingencyIndex) ((size_t) -1) : MaxContingencyIndex;
+  for (int pl = 0; pl < m_game->NumPlayers(); pl++) {
+    GamePlayer player = m_game->GetPlayer(pl + 1);
+    for (int st = 1; st <= player->NumStrategies(); st++) {
+      m_strategies[pl].push_back(player->GetStrategy(st));
+    }
+    m_stride[pl] = m_numContingencies;
+    m_numContingencies = MultiplyContingencies(m_numContingencies,
+					       player->NumStrategies(), limit);
+  }
+}
+
+inline void NashEnumPureSearch::SetProfile(PureStrategyProfile &p_profile,
+					   ContingencyIndex p_index) const
+{
+  for (size_t pl = 0; pl < m_strategies.size(); pl++) {
+    p_profile->SetStrategy(m_strategies[pl][p_index % m_strategies[pl].size()]);
+    p_index /= m_strategies[pl].size();
+  }
+}
+
+inline MixedStrategyProfile<Rational>
+NashEnumPureSearch::GetEquilibrium(ContingencyIndex p_index) const
+{
+  PureStrategyProfile profile = m_original->NewPureStrategyProfile();
+  for (int pl = 1; pl <= m_original->NumPlayers(); pl++) {
+    GamePlayer player = m_original->GetPlayer(pl);
+    profile->SetStrategy(player->GetStrategy(p_index % player->NumStrategies() + 1));
+    p_index /= player->NumStrategies();
+  }
+  return profile->ToMixedStrategyProfile();
+}
+
+inline void NashEnumPureSearch::ScanLines(int p_thread)
+{
+  try {
+    ContingencyIndex stride = m_stride[m_player];
+    ContingencyIndex length = m_strategies[m_player].size();
+    // The player's lines come in slabs of stride * length contingencies,
+    // each holding stride lines side by side.  Each slab is scanned in
+    // chunks of up to s_chunkSize lines, strategy by strategy, so that
+    // the contingencies are read in runs rather than a stride apart.
+    long chunk = (stride < s_chunkSize) ? stride : s_chunkSize;
+    ContingencyIndex chunksPerSlab = (stride + chunk - 1) / chunk;
+    ContingencyIndex numUnits = 
+      m_numContingencies / (stride * length) * chunksPerSlab;
+    ContingencyIndex begin = numUnits * p_thread / m_numThreads;
+    ContingencyIndex end = numUnits * (p_thread + 1) / m_numThreads;
+    const double *payoff = &m_payoffs[m_player * m_numPayoffs];
+    unsigned char *dropped = reinterpret_cast<unsigned char *>(m_dropped->GetData());
+    std::vector<double> threshold(chunk);
+
+    for (ContingencyIndex unit = begin; unit < end; unit++) {
+      ContingencyIndex offset = (unit % chunksPerSlab) * chunk;
+      ContingencyIndex first = (unit / chunksPerSlab) * stride * length + offset;
+      long width = (stride - offset < chunk) ? stride - offset : chunk;
+
+      for (long i = 0; i < width; i++) {
+	threshold[i] = GetPayoff(payoff, first + i);
+      }
+      for (long st = 1; st < length; st++) {
+	ContingencyIndex index = first + st * stride;
+	for (long i = 0; i < width; i++, index++) {
+	  double value = GetPayoff(payoff, index);
+	  if (value > threshold[i])  threshold[i] = value;
+	}
+      }
+      // Payoffs are rounded when converted to double; the tolerance keeps
+      // the rounding from dropping a contingency which is in fact a best
+      // response.  Any extra ones are weeded out in the exact check.
+      for (long i = 0; i < width; i++) {
+	threshold[i] -= 1.0e-9 * (1.0 + std::fabs(threshold[i]));
+      }
+      for (long st = 0; st < length; st++) {
+	ContingencyIndex index = first + st * stride;
+	for (long i = 0; i < width; i++, index++) {
+	  if (GetPayoff(payoff, index) < threshold[i]) {
+	    dropped[index] = 1;
+	  }
+	}
+      }
+      ReportProgress();
+    }
+  }
+  catch (std::exception &e) {
+    MutexLock lock(m_mutex);
+    m_error = e.what();
+  }
+}
+
+inline void NashEnumPureSearch::ScanComputedLines(int p_thread)
+{
+  try {
+    ContingencyIndex stride = m_stride[m_player];
+    long length = m_strategies[m_player].size();
+    // Lines are numbered slab by slab, as in ScanLines()
+    ContingencyIndex numLines = m_numContingencies / length;
+    ContingencyIndex begin = numLines * p_thread / m_numThreads;
+    ContingencyIndex end = numLines * (p_thread + 1) / m_numThreads;
+    unsigned char *dropped = reinterpret_cast<unsigned char *>(m_dropped->GetData());
+    PureStrategyProfile profile = m_game->NewPureStrategyProfile();
+    std::vector<double> payoff(length);
+
+    for (ContingencyIndex line = begin; line < end; line++) {
+      ContingencyIndex first = (line / stride) * stride * length + line % stride;
+      SetProfile(profile, first);
+      double threshold = 0.0;
+      for (long st = 0; st < length; st++) {
+	profile->SetStrategy(m_strategies[m_player][st]);
+	payoff[st] = (double) profile->GetPayoff(m_player + 1);
+	if (st == 0 || payoff[st] > threshold)  threshold = payoff[st];
+      }
+      threshold -= 1.0e-9 * (1.0 + std::fabs(threshold));
+      for (long st = 0; st < length; st++) {
+	if (payoff[st] < threshold)  dropped[first + st * stride] = 1;
+      }
+      ReportProgress();
+    }
+  }
+  catch (std::exception &e) {
+    MutexLock lock(m_mutex);
+    m_error = e.what();
+  }
+}
+
+inline void NashEnumPureSearch::ConfirmCandidates(void)
+{
+  try {
+    ContingencyIndex numBlocks = m_blockDone.size();
+    PureStrategyProfile profile = m_game->NewPureStrategyProfile();
+    const unsigned char *dropped = 
+      reinterpret_cast<const unsigned char *>(m_dropped->GetData());
+    while (true) {
+      ContingencyIndex block;
+      {
+	MutexLock lock(m_mutex);
+	if (m_nextBlock >= numBlocks || !m_error.empty())  return;
+	block = m_nextBlock++;
+      }
+
+      std::vector<ContingencyIndex> found;
+      ContingencyIndex begin = block * s_blockSize;
+      ContingencyIndex end = begin + s_blockSize;
+      if (end > m_numContingencies)  end = m_numContingencies;
+      for (ContingencyIndex index = begin; index < end; index++) {
+	if (!dropped[index]) {
+	  SetProfile(profile, index);
+	  if (profile->IsNash()) {
+	    found.push_back(index);
+	  }
+	}
+      }
+      ReportProgress();
+
+      MutexLock lock(m_mutex);
+      m_blockFound[block].swap(found);
+      m_blockDone[block] = true;
+      while (m_nextReport < numBlocks && m_blockDone[m_nextReport]) {
+	const std::vector<ContingencyIndex> &report = m_blockFound[m_nextReport];
+	for (size_t i = 0; i < report.size(); i++) {
+	  MixedStrategyProfile<Rational> eqm = GetEquilibrium(report[i]);
+	  m_onEquilibrium->Render(eqm);
+	  m_solutions.Append(eqm);
+	}
+	std::vector<ContingencyIndex>().swap(m_blockFound[m_nextReport++]);
+      }
+    }
+  }
+  catch (std::exception &e) {
+    MutexLock lock(m_mutex);
+    m_error = e.what();
+  }
+}
+
+inline List<MixedStrategyProfile<Rational> > NashEnumPureSearch::Solve(void)
+{
+  int numPlayers = m_strategies.size();
+  const GameTableRep *table = 
+    dynamic_cast<const GameTableRep *>(static_cast<GameRep *>(m_game));
+  if (table) {
+    m_outcomes = &table->GetOutcomeNumbers();
+    m_numPayoffs = m_game->NumOutcomes() + 1;
+    m_payoffs.assign(numPlayers * m_numPayoffs, 0.0);
+    for (int pl = 0; pl < numPlayers; pl++) {
+      for (int outc = 1; outc < m_numPayoffs; outc++) {
+	m_payoffs[pl * m_numPayoffs + outc] = 
+	  m_game->GetOutcome(outc)->GetPayoff<double>(pl + 1);
+      }
+    }
+    m_outcomes->Advise(1, m_numContingencies, MappedBuffer::accessSequential);
+  }
+
+  m_dropped = new MappedBuffer(m_numContingencies);
+  for (m_player = 0; m_player < numPlayers; m_player++) {
+    RunThreads(m_numThreads, ScanLinesWorker, this);
+    if (!m_error.empty())  throw Exception(m_error);
+  }
+  std::vector<double>().swap(m_payoffs);
+  if (m_outcomes) {
+    m_outcomes->Advise(1, m_numContingencies, MappedBuffer::accessNormal);
+  }
+  m_dropped->Advise(0, m_numContingencies, MappedBuffer::accessSequential);
+
+  ContingencyIndex numBlocks = 
+    (m_numContingencies + s_blockSize - 1) / s_blockSize;
+  m_blockDone.assign(numBlocks, false);
+  m_blockFound.resize(numBlocks);
+  RunThreads(m_numThreads, ConfirmWorker, this);
+  if (!m_error.empty())  throw Exception(m_error);
+  return m_solutions;
+}
+
 inline List<MixedStrategyProfile<Rational> >
 NashEnumPureStrategySolver::Solve(const Game &p_game) const
 {
   if (!p_game->IsPerfectRecall()) {
     throw UndefinedException("Computing equilibria of games with imperfect recall is not supported.");
   }
-  List<MixedStrategyProfile<Rational> > solutions;
-  for (StrategyProfileIterator citer(p_game); !citer.AtEnd(); citer++) {
-    if ((*citer)->IsNash()) {
-      MixedStrategyProfile<Rational> profile = (*citer)->ToMixedStrategyProfile();
-      m_onEquilibrium->Render(profile);
-      solutions.Append(profile);
-    }
+  Game game = p_game;
+  if (m_numThreads > 1 && !p_game->IsFrozen()) {
+    game = p_game->Copy();
+    game->Freeze();
   }
-  return solutions;
+  NashEnumPureSearch search(game, p_game, m_numThreads, *m_onEquilibrium);
+  return search.Solve();
 }
 
 
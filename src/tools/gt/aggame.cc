@@ -21,6 +21,7 @@
 // Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
 //
 
+#include "libgambit/stats.h"
 #include "aggame.h"
 
 void aggame:: computePartialP_PureNode(int player1,int act1, vector<int>& tasks){
@@ -31,21 +32,23 @@ void aggame:: computePartialP_PureNode(int player1,int act1, vector<int>& tasks)
     vector<AggNumber> strat (numNei);
     agg::config    a(numNei,0);
     //compute the full distrib
-    aggPtr->computeP (player1,act1);
+    aggPtr->computeP (aggPtr->ownWorkspace, player1,act1);
 
-    //store the full distrib in Pr[player1]
-    aggPtr->Pr[player1].swap(aggPtr->Pr[numPlayers-1]);
+    //store the full distrib in Pr[player1].  This copies rather than
+    //swaps, since copying reverses the entry order, and the division
+    //below accumulates rounding errors differently in the other order
+    aggPtr->ownWorkspace.Pr[player1] = aggPtr->ownWorkspace.Pr[numPlayers-1];
     for(i=0;i<(int)tasks.size();i++){
       //assert(tasks[i]!=player1);
-      aggdistrib& P = aggPtr->Pr[tasks[i]];
+      aggdistrib& P = aggPtr->ownWorkspace.Pr[tasks[i]];
       //P.clear();  // to get ready for division, we need clear()
-      P=aggPtr->Pr[player1];
+      P=aggPtr->ownWorkspace.Pr[player1];
 
       bool NullOnly =true;
       for(j=0;j<numNei;++j){
 	a[j]++;
-	aggdistrib::iterator pp = aggPtr->projectedStrat[Node][tasks[i]].find(a);
-	if (pp== aggPtr->projectedStrat[Node][tasks[i]].end()) {
+	aggdistrib::iterator pp = aggPtr->ownWorkspace.projectedStrat[Node][tasks[i]].find(a);
+	if (pp== aggPtr->ownWorkspace.projectedStrat[Node][tasks[i]].end()) {
 	    strat[j]=0;
 	}
 	else {
@@ -87,7 +90,7 @@ void aggame::computePartialP_bisect(int player1,int act1,
     <<", act1="<<act1<<" *start="<<*start<<" *(endp-1)="<<*(endp-1)
     <<", (endp-start)="<< endp-start <<endl;
 #endif
-  if(endp-start==1){aggPtr->Pr[*start].reset();return;}
+  if(endp-start==1){aggPtr->ownWorkspace.Pr[*start].reset();return;}
   int Node = aggPtr->actionSets[player1][act1];
   int numNei=aggPtr->neighbors[Node].size();
 
@@ -102,27 +105,27 @@ void aggame::computePartialP_bisect(int player1,int act1,
 
 
   temp.reset();
-  temp = aggPtr->projectedStrat[Node][*start];
-  if (mid-start>1) temp.multiply(aggPtr->Pr[*start],numNei,aggPtr->projFunctions[Node]);
+  temp = aggPtr->ownWorkspace.projectedStrat[Node][*start];
+  if (mid-start>1) temp.multiply(aggPtr->ownWorkspace.Pr[*start],numNei,aggPtr->projFunctions[Node]);
 
   if (mid-start==1) {
-    //assert(aggPtr->Pr[*start].empty());
-    aggPtr->Pr[*start]= aggPtr->projectedStrat[Node][*mid];
-    if(endp-mid>1) aggPtr->Pr[*start].multiply(aggPtr->Pr[*mid],numNei,aggPtr->projFunctions[Node]);
+    //assert(aggPtr->ownWorkspace.Pr[*start].empty());
+    aggPtr->ownWorkspace.Pr[*start]= aggPtr->ownWorkspace.projectedStrat[Node][*mid];
+    if(endp-mid>1) aggPtr->ownWorkspace.Pr[*start].multiply(aggPtr->ownWorkspace.Pr[*mid],numNei,aggPtr->projFunctions[Node]);
   }
   else for (ptr=start; ptr!=mid; ++ptr){
     player2= *ptr;
-    aggPtr->Pr[player2].multiply(aggPtr->projectedStrat[Node][*mid],numNei,aggPtr->projFunctions[Node] );
-    if(endp-mid>1) aggPtr->Pr[player2].multiply(aggPtr->Pr[*mid],numNei,aggPtr->projFunctions[Node]);
+    aggPtr->ownWorkspace.Pr[player2].multiply(aggPtr->ownWorkspace.projectedStrat[Node][*mid],numNei,aggPtr->projFunctions[Node] );
+    if(endp-mid>1) aggPtr->ownWorkspace.Pr[player2].multiply(aggPtr->ownWorkspace.Pr[*mid],numNei,aggPtr->projFunctions[Node]);
   }
 
   if(endp-mid==1){
-    //assert(aggPtr->Pr[*mid].empty());
-    aggPtr->Pr[*mid]=temp;
+    //assert(aggPtr->ownWorkspace.Pr[*mid].empty());
+    aggPtr->ownWorkspace.Pr[*mid]=temp;
   }
   else for (ptr=mid;ptr!=endp;++ptr){
     player2=*ptr;
-    aggPtr->Pr[player2].multiply(temp,numNei, aggPtr->projFunctions[Node]);
+    aggPtr->ownWorkspace.Pr[player2].multiply(temp,numNei, aggPtr->projFunctions[Node]);
 
   }
 
@@ -134,6 +137,8 @@ void aggame::computePartialP_bisect(int player1,int act1,
 void aggame::payoffMatrix(cmatrix &dest, cvector &s, AggNumber fuzz){
   //compute jacobian
   //s: mixed strat
+  GAMBIT_STATS_TIMER(statsSectionJacobian);
+  GAMBIT_STATS_COUNT(statsJacobians);
 
 #ifdef AGGDEBUG
   cout<<"calling payoffMatrix with stratety s="<<endl
@@ -150,7 +155,7 @@ void aggame::payoffMatrix(cmatrix &dest, cvector &s, AggNumber fuzz){
 
   //do projection
   for(int Node=0; Node< aggPtr->numActionNodes; Node++)
-	aggPtr->doProjection(Node,s.values());
+	aggPtr->doProjection(aggPtr->ownWorkspace, Node,s.values());
 
   //deal with the diagonal
   for (rown=0; rown<aggPtr->numPlayers; ++rown){
@@ -229,33 +234,33 @@ void aggame::payoffMatrix(cmatrix &dest, cvector &s, AggNumber fuzz){
 	    if(aggPtr->isPure[currNode]||tasks.size()==0){
 	      computePartialP_PureNode(rown, act1,tasks);
 	    }else{//do bisection
-	      computePartialP_bisect(rown,act1,tasks.begin(),tasks.end(),aggPtr->Pr[rown]);
+	      computePartialP_bisect(rown,act1,tasks.begin(),tasks.end(),aggPtr->ownWorkspace.Pr[rown]);
 #ifdef AGGDEBUG
               cout<<"after calling computePartialP_bisect:"<<endl;
               for (int tt=0;tt<tasks.size();tt++){
                 cout<<"for player "<<tasks[tt]<<endl;
-                cout<<aggPtr->Pr[tasks[tt]]<<endl;
+                cout<<aggPtr->ownWorkspace.Pr[tasks[tt]]<<endl;
               }
 #endif
 	      //now apply rown's action (act1), and the strategies of
 	      //players in nontasks
-          aggPtr->Pr[rown].reset();
-          aggPtr->Pr[rown].insert(
+          aggPtr->ownWorkspace.Pr[rown].reset();
+          aggPtr->ownWorkspace.Pr[rown].insert(
 		    make_pair(aggPtr->projection[currNode][rown][act1],1.0));
 	      for(p=nontasks.begin();p!=nontasks.end();++p)
-	    	  aggPtr->Pr[rown].multiply(aggPtr->projectedStrat[currNode][*p],numNei, aggPtr->projFunctions[currNode]);
+	    	  aggPtr->ownWorkspace.Pr[rown].multiply(aggPtr->ownWorkspace.projectedStrat[currNode][*p],numNei, aggPtr->projFunctions[currNode]);
 #ifdef AGGDEBUG
               cout<<"the polynomial product of strats of player "
                   <<rown<< " and players in the vector nontasks is:"
                   <<endl;
-              cout<<aggPtr->Pr[rown]<<endl;
+              cout<<aggPtr->ownWorkspace.Pr[rown]<<endl;
 #endif
 	      if (tasks.size()==1){
-	    	  aggPtr->Pr[tasks[0]]=aggPtr->Pr[rown];
+	    	  aggPtr->ownWorkspace.Pr[tasks[0]]=aggPtr->ownWorkspace.Pr[rown];
 	      }
 	      else {
                 for(p=tasks.begin();p!=tasks.end();++p){
-		  if(aggPtr->Pr[*p].size()==0){
+		  if(aggPtr->ownWorkspace.Pr[*p].size()==0){
 		    cerr<<"AGG::payoffMatrix() ERROR for rown="
 		        <<rown<<" act1="<<act1<<" *p=" <<*p
 		        <<": the distribution should not be empty!"<<endl;
@@ -264,8 +269,8 @@ void aggame::payoffMatrix(cmatrix &dest, cvector &s, AggNumber fuzz){
 #endif
 
 		  }
-		  aggPtr->Pr[*p].multiply(
-				  aggPtr->Pr[rown],numNei,aggPtr->projFunctions[currNode]);
+		  aggPtr->ownWorkspace.Pr[*p].multiply(
+				  aggPtr->ownWorkspace.Pr[rown],numNei,aggPtr->projFunctions[currNode]);
 	        }//end for(p=tasks.begin...
 	      }
 
@@ -274,10 +279,10 @@ void aggame::payoffMatrix(cmatrix &dest, cvector &s, AggNumber fuzz){
 	      //we store this distrib in Pr[rown][act1][rown]
 	      if (spares.size()>0){
 		//assert(tasks.size()>0);
-	    	  aggPtr->Pr[rown].reset();
-	    	  aggPtr->Pr[rown].multiply(
-	    			  aggPtr->Pr[tasks[0]],
-	    			  aggPtr->projectedStrat[currNode][tasks[0]],numNei,aggPtr->projFunctions[currNode]);
+	    	  aggPtr->ownWorkspace.Pr[rown].reset();
+	    	  aggPtr->ownWorkspace.Pr[rown].multiply(
+	    			  aggPtr->ownWorkspace.Pr[tasks[0]],
+	    			  aggPtr->ownWorkspace.projectedStrat[currNode][tasks[0]],numNei,aggPtr->projFunctions[currNode]);
 	      }
 	    } //end else
 #ifdef AGGDEBUG
@@ -285,7 +290,7 @@ void aggame::payoffMatrix(cmatrix &dest, cvector &s, AggNumber fuzz){
                 <<endl;
             for (int tt = 0;tt<numPlayers;tt++){
               cout<<"for player "<<tt<<endl;
-              cout<<aggPtr->Pr[tt];
+              cout<<aggPtr->ownWorkspace.Pr[tt];
               cout<<endl;
             }
 #endif
@@ -303,8 +308,8 @@ void aggame::payoffMatrix(cmatrix &dest, cvector &s, AggNumber fuzz){
 	    for(p=tasks.begin();p!=tasks.end();++p){
 	      for(act2=0;act2<aggPtr->actions[*p];act2++){//act2: col action
 
-		if (aggPtr->projectedStrat[currNode][*p].size()==1  &&
-				aggPtr->projectedStrat[currNode][*p].begin()->first==aggPtr->projection[currNode][*p][act2])
+		if (aggPtr->ownWorkspace.projectedStrat[currNode][*p].size()==1  &&
+				aggPtr->ownWorkspace.projectedStrat[currNode][*p].begin()->first==aggPtr->projection[currNode][*p][act2])
 		{
 		  computeUndisturbedPayoff(undisturbedPayoff,hasUndisturbed,rown,act1,*p);
 		  savePayoff(dest,rown,act1,*p,act2,undisturbedPayoff,aggPtr->cache);
@@ -323,11 +328,11 @@ void aggame::computeUndisturbedPayoff(AggNumber& undisturbedPayoff,bool& has,int
   int    Node =aggPtr->actionSets[player1][act1];
   int    numNei= aggPtr->neighbors[Node].size();
   if (player2==player1){
-    undisturbedPayoff=aggPtr->Pr[player2].inner_prod(aggPtr->payoffs[Node]);
+    undisturbedPayoff=aggPtr->ownWorkspace.Pr[player2].inner_prod(aggPtr->payoffs[Node]);
   }else{
-    //assert(aggPtr->projectedStrat[Node][player2].size()==1);
-    undisturbedPayoff=aggPtr->Pr[player2].inner_prod(
-    		aggPtr->projectedStrat[Node][player2].begin()->first,numNei,aggPtr->projFunctions[Node],aggPtr->payoffs[Node]);
+    //assert(aggPtr->ownWorkspace.projectedStrat[Node][player2].size()==1);
+    undisturbedPayoff=aggPtr->ownWorkspace.Pr[player2].inner_prod(
+    		aggPtr->ownWorkspace.projectedStrat[Node][player2].begin()->first,numNei,aggPtr->projFunctions[Node],aggPtr->payoffs[Node]);
   }
   has=true;
 }
@@ -372,7 +377,7 @@ void aggame::computePayoff(cmatrix& dest,int player1,int act1,int player2,int ac
   if (! r.second) {
     dest[act1+firstAction(player1)][act2+firstAction(player2)]=r.first->second;
   }else{
-    r.first->second=aggPtr->Pr[player2].inner_prod(
+    r.first->second=aggPtr->ownWorkspace.Pr[player2].inner_prod(
     		aggPtr->projection[Node][player2][act2],numNei,aggPtr->projFunctions[Node],aggPtr->payoffs[Node]);
     savePayoff(dest,player1,act1,player2,act2,r.first->second,cache,r.second);
   }
@@ -397,10 +402,10 @@ void aggame::SymPayoffMatrix(cmatrix &dest, cvector &s, AggNumber fuzz){
     numNei= aggPtr->neighbors[currNode].size();
     //vector<int> key (numNei+1);
     //key[numNei]=currNode;
-    aggPtr->doProjection(currNode,0,&(s[firstAction(0)]));
-    aggdistrib &Pdest = aggPtr->Pr[numPlayers-1];
-    aggPtr->projectedStrat[currNode][0].power(numPlayers-2, Pdest, aggPtr->Pr[numPlayers-2],numNei,aggPtr->projFunctions[currNode]);
-    aggdistrib &temp=aggPtr->Pr[numPlayers-2];
+    aggPtr->doProjection(aggPtr->ownWorkspace, currNode,0,&(s[firstAction(0)]));
+    aggdistrib &Pdest = aggPtr->ownWorkspace.Pr[numPlayers-1];
+    aggPtr->ownWorkspace.projectedStrat[currNode][0].power(numPlayers-2, Pdest, aggPtr->ownWorkspace.Pr[numPlayers-2],numNei,aggPtr->projFunctions[currNode]);
+    aggdistrib &temp=aggPtr->ownWorkspace.Pr[numPlayers-2];
     temp.reset();
     temp.insert(make_pair(aggPtr->projection[currNode][0][rowa],1));
     Pdest.multiply(temp,numNei,aggPtr->projFunctions[currNode]);
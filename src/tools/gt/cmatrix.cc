@@ -17,6 +17,7 @@
  * Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
  */
 
+#include "libgambit/stats.h"
 #include "cmatrix.h"
 #include "math.h"
 #include "float.h"
@@ -60,6 +61,8 @@ cmatrix cmatrix::inv(bool &worked) const {
 
 // adopted from NRiC, pg 43
 int cmatrix::LUdecomp(cmatrix &LU, int *ix) const {
+	GAMBIT_STATS_TIMER(statsSectionRefactor);
+	GAMBIT_STATS_COUNT(statsRefactorizations);
 	if (m!=n||LU.m!=LU.n||LU.n!=n) {
 		cerr << "invalid cmatrix in LUdecomp" << endl;
 		exit(1);
@@ -396,6 +399,8 @@ void cmatrix::svd(cmatrix &u, cmatrix &v, double *w) {
 }
 
 double cmatrix::adjoint() {
+  GAMBIT_STATS_TIMER(statsSectionRefactor);
+  GAMBIT_STATS_COUNT(statsRefactorizations);
   int i, j, i0, j0, maxi, lastj = -1;
   double max, pivot;
   std::vector<int> r(m);
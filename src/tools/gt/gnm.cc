@@ -18,6 +18,7 @@
  */
 
 #include <libgambit/libgambit.h>
+#include <libgambit/stats.h>
 
 #include "cmatrix.h"
 #include "gnm.h"
@@ -25,15 +26,18 @@
 
 extern bool g_verbose;
 extern int g_numDecimals;
+extern int g_profileCopies;
 
 void PrintProfile(std::ostream &p_stream, 
 		  const std::string &p_label,
 		  const cvector &p_profile) 
 {
   p_stream << p_label;
-  for (int i = 0; i < p_profile.getm(); i++) {
-    p_stream.setf(std::ios::fixed);
-    p_stream << ',' << std::setprecision(g_numDecimals) << p_profile[i];
+  for (int copy = 0; copy < g_profileCopies; copy++) {
+    for (int i = 0; i < p_profile.getm(); i++) {
+      p_stream.setf(std::ios::fixed);
+      p_stream << ',' << std::setprecision(g_numDecimals) << p_profile[i];
+    }
   }
   p_stream << std::endl;
 }
@@ -78,7 +82,8 @@ int GNM(gnmgame &A, cvector &g, cvector **&Eq, int steps, double fuzz, int LNMFr
     stepsLeft; // number of linear steps remaining until we hit the boundary
 
   int N = A.getNumPlayers(), 
-    M = A.getNumActions(); // the two most important cvector sizes, stored locally for brevity
+    M = A.getNumActions(), // the two most important cvector sizes, stored locally for brevity
+    degree = A.getPayoffDegree(); // the degree of the payoffs as polynomials
   double bestPayoff, 
     det, // determinant of the jacobian
     newV, // utility variable
@@ -148,7 +153,7 @@ int GNM(gnmgame &A, cvector &g, cvector **&Eq, int steps, double fuzz, int LNMFr
 
   A.payoffMatrix(DG, sigma, fuzz);
   DG.multiply(sigma, v);
-  v /= (double)(N-1);
+  v /= (double)degree;
 
   // Scale g until the equilibrium sigma calculated above
   // is in fact the one unique equilibrium, and set lambda
@@ -191,7 +196,7 @@ int GNM(gnmgame &A, cvector &g, cvector **&Eq, int steps, double fuzz, int LNMFr
       g[i] *= (V-yn1[n])/G[n];
     }
 */
-  if(N <= 2) { // ensure we don't do small steps and LNM
+  if(degree <= 1) { // ensure we don't do small steps and LNM
     LNMFreq = 0;
     steps = 1;
   }
@@ -211,6 +216,7 @@ int GNM(gnmgame &A, cvector &g, cvector **&Eq, int steps, double fuzz, int LNMFr
 
     // take the specified number of steps within these support boundaries.  
     for(stepsLeft = steps; stepsLeft > 0; stepsLeft--) { 
+      GAMBIT_STATS_COUNT(statsPathSteps);
       //find J = Adj psi
       J = I;
       J += DG;
@@ -235,11 +241,11 @@ int GNM(gnmgame &A, cvector &g, cvector **&Eq, int steps, double fuzz, int LNMFr
       
       //Calculate payoff cvector
       DG.multiply(sigma, v);      
-      v /=  (double)(N-1);
+      v /=  (double)degree;
       ym1 = g;
       ym1 *= lambda;
       v += ym1;
-      // v = DG*sigma / (double)(N-1) + g * lambda;
+      // v = DG*sigma / (double)degree + g * lambda;
       
       //Find next action that will enter or leave the support
       //This bit pretends that z and v change linearly and calculates
@@ -283,7 +289,7 @@ int GNM(gnmgame &A, cvector &g, cvector **&Eq, int steps, double fuzz, int LNMFr
       if(Index*(lambda+dlambda*delta) <= 0.0) {
 	// if there's no next support boundary, treat the equilibrium
 	// as the next support boundary and step up to it incrementally
-	if(minBound == BIGFLOAT && N > 2 && stepsLeft > 1) { 
+	if(minBound == BIGFLOAT && degree > 1 && stepsLeft > 1) { 
 	  del = -lambda / dlambda;
 	  delta = del / stepsLeft;
 	} else {
@@ -296,7 +302,7 @@ int GNM(gnmgame &A, cvector &g, cvector **&Eq, int steps, double fuzz, int LNMFr
 	  A.retract(sigma, z);
 	  A.payoffMatrix(DG, sigma, fuzz);
 	  ee = 0.0;
-	  if(N > 2) { // if N=2, the graph is linear, so we are at a
+	  if(degree > 1) { // if the payoffs are linear, so is the graph, and we are at a
 	    //precise equilibrium.  otherwise, refine it.
 	    J = DG;
 	    J += I;
@@ -349,11 +355,11 @@ int GNM(gnmgame &A, cvector &g, cvector **&Eq, int steps, double fuzz, int LNMFr
       A.retract(sigma,z);
       A.payoffMatrix(DG, sigma,fuzz);
       
-      if(N <= 2) 
+      if(degree <= 1) 
 	break; // already at the support boundary
       
       DG.multiply(sigma,err);
-      err /= (double)(N-1);
+      err /= (double)degree;
       g0 = g;
       g0 *= lambda;
       err += g0;
@@ -368,12 +374,12 @@ int GNM(gnmgame &A, cvector &g, cvector **&Eq, int steps, double fuzz, int LNMFr
       if(ee > threshold) { // if we've accumulated too much error, either
 	if(wobble) {       // wobble or quit.
 	  DG.multiply(sigma, ym1);
-	  ym1 /= (double)(N-1);
+	  ym1 /= (double)degree;
 	  g = z;
 	  g -= sigma;
 	  g -= ym1;
 	  g /= lambda;
-	  // g = ((z-sigma)-((DG*sigma) / (double)(N-1)))/lambda;
+	  // g = ((z-sigma)-((DG*sigma) / (double)degree))/lambda;
 	} else {
 	  if(g_verbose) std::cerr<<"gnm(): return due to too much error. error is "<<ee<<endl;
 	  return numEq;
@@ -415,15 +421,15 @@ int GNM(gnmgame &A, cvector &g, cvector **&Eq, int steps, double fuzz, int LNMFr
     // z = (z-x)+sigma;
      
     // wobble the perturbation cvector to put us back on an equilibrium
-    if(N > 2 && wobble) {
+    if(degree > 1 && wobble) {
       A.payoffMatrix(DG, sigma, fuzz);
       DG.multiply(sigma, ym1);
-      ym1 /= (double)(N-1);
+      ym1 /= (double)degree;
       g = z;
       g -= sigma;
       g -= ym1;
       g /= lambda;
-      // g = ((z-sigma)-((DG*sigma) / (double)(N-1)))/lambda;
+      // g = ((z-sigma)-((DG*sigma) / (double)degree))/lambda;
 
     }
   }
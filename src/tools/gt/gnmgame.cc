@@ -17,6 +17,7 @@
  * Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
  */
 
+#include "libgambit/stats.h"
 #include "gnmgame.h"
 #include "cmatrix.h"
 #include "math.h"
@@ -197,9 +198,10 @@ double gnmgame::LNM(cvector &z, const cvector &g, double det, cmatrix &J, cmatri
   if(MaxLNM >= 1 && det != 0.0) {
     b = 1.0/det;
     for(k = 0; k < MaxLNM; k++) {
-      //      del = z - s - DG*s / (double)(numPlayers - 1) - g; 
+      GAMBIT_STATS_COUNT(statsCorrectorIterations);
+      //      del = z - s - DG*s / (double)getPayoffDegree() - g; 
       DG.multiply(s,del);
-      del /= (double)(numPlayers - 1);
+      del /= (double)getPayoffDegree();
       del += g;
       del += s;
       del -= z;
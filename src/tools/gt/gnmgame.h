@@ -165,6 +165,12 @@ class gnmgame {
   void LemkeHowson(cvector &dest, cmatrix &T, std::vector<int> &Im);
 
 
+  // The degree of the payoffs as polynomials in the strategy profile,
+  // by which DG*s must be divided to give the payoff vector.  This is
+  // N-1 for an N-player game, but a game which stands for a reduced
+  // form of another may differ.
+  virtual int getPayoffDegree() { return numPlayers - 1; }
+
   inline int getNumPlayers() { return numPlayers; }
   inline int getNumActions() { return numActions; }
   inline int getNumActions(int p) { return actions[p]; }
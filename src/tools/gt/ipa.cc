@@ -17,6 +17,7 @@
  * Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
  */
 
+#include "libgambit/stats.h"
 #include "cmatrix.h"
 #include "ipa.h"
 #include "gnmgame.h"
@@ -85,6 +86,7 @@ int IPA(gnmgame &A, cvector &g, cvector &zh, double alpha, double fuzz, cvector
   so = sh;
 
   while(maxiter<0||iter<=maxiter) {
+    GAMBIT_STATS_COUNT(statsPathSteps);
     A.payoffMatrix(DG,sh,0.0);
     DG /= (double)(N-1); // find the Jacobian of the approximating bimatrix game
 
@@ -18,6 +18,7 @@
  */
 
 #include <vector>
+#include "libgambit/stats.h"
 #include "cmatrix.h"
 #include "nfgame.h"
 
@@ -61,6 +62,8 @@ void nfgame::getPayoffVector(cvector &dest, int player, const cvector &s){
 }
 
 void nfgame::payoffMatrix(cmatrix &dest, cvector &s, double fuzz) {
+  GAMBIT_STATS_TIMER(statsSectionJacobian);
+  GAMBIT_STATS_COUNT(statsJacobians);
   int rown, coln, rowi, coli;
   double fuzzcount;
   double *m = new double[blockSize[numPlayers]];
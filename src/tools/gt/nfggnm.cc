@@ -26,10 +26,13 @@
 #include <iostream>
 #include <fstream>
 #include <cerrno>
+#include <climits>
 #include "libgambit/libgambit.h"
+#include "libgambit/stats.h"
 
 #include "nfgame.h"
 #include "aggame.h"
+#include "symgame.h"
 #include "gnmgame.h"
 #include "gnm.h"
 
@@ -45,6 +48,10 @@ const double THRESHOLD = 1e-2;
 int g_numDecimals = 6;
 bool g_verbose = false;
 int g_numVectors = 1;
+bool g_symmetric = false;
+// The number of times each profile is printed: when solving for
+// symmetric equilibria, the strategy of one player stands for all
+int g_profileCopies = 1;
 std::string g_startFile;
 
 bool ReadProfile(std::istream &p_stream, cvector &p_profile)
@@ -91,8 +98,11 @@ void PrintHelp(char *progname)
   std::cerr << "  -s FILE          file containing perturbation vectors\n";
   std::cerr << "  -q               quiet mode (suppresses banner)\n";
   std::cerr << "  -V, --verbose    verbose mode (shows intermediate output)\n";
-  std::cerr << "  -v, --version    print version information\n";
   std::cerr << "                   (default is to only show equilibria)\n";
+  std::cerr << "  -v, --version    print version information\n";
+  std::cerr << "  -y               compute symmetric equilibria of a symmetric game\n";
+  std::cerr << "  --stats[=FORMAT] on exit, print solver statistics to standard error\n";
+  std::cerr << "                   as json (the default) or csv\n";
   exit(1);
 }
 
@@ -100,7 +110,11 @@ void Solve(const Gambit::Game &p_game)
 {
   int i;
   gnmgame *A=NULL;
-  if (p_game->IsAgg()){
+  if (g_symmetric) {
+    A = new symgame(p_game);
+    g_profileCopies = p_game->NumPlayers();
+  }
+  else if (p_game->IsAgg()){
 	  A = new aggame(dynamic_cast<Gambit::GameAggRep &>(*p_game));
   }
   else {
@@ -109,12 +123,15 @@ void Solve(const Gambit::Game &p_game)
     double scale = 1.0 / (maxPay - minPay);
 
     int *actions = new int[p_game->NumPlayers()];
-    int veclength = p_game->NumPlayers();
+    // The payoffs are held in a cvector, which is indexed by int
+    Gambit::ContingencyIndex veclength = p_game->NumPlayers();
     for (int pl = 1; pl <= p_game->NumPlayers(); pl++) {
       actions[pl-1] = p_game->GetPlayer(pl)->NumStrategies();
-      veclength *= p_game->GetPlayer(pl)->NumStrategies();
+      veclength = Gambit::MultiplyContingencies(veclength,
+						p_game->GetPlayer(pl)->NumStrategies(),
+						INT_MAX);
     }
-    cvector payoffs(veclength);
+    cvector payoffs((int) veclength);
   
     A = new nfgame(p_game->NumPlayers(), actions, payoffs);
   
@@ -188,11 +205,12 @@ int main(int argc, char *argv[])
   struct option long_options[] = {
     { "help", 0, NULL, 'h'   },
     { "version", 0, NULL, 'v'  },
+    { "stats", optional_argument, NULL, Gambit::STATS_OPTION },
     { "verbose", 0, NULL, 'V'  },
     { 0,    0,    0,    0   }
   };
   int c;
-  while ((c = getopt_long(argc, argv, "d:n:s:qvVhS", long_options, &long_opt_index)) != -1) {
+  while ((c = getopt_long(argc, argv, "d:n:s:qvVhSy", long_options, &long_opt_index)) != -1) {
     switch (c) {
     case 'v':
       PrintBanner(std::cerr); exit(1);
@@ -213,9 +231,18 @@ int main(int argc, char *argv[])
       break;
     case 'S':
       break;
+    case 'y':
+      g_symmetric = true;
+      break;
     case 'h':
       PrintHelp(argv[0]);
       break;
+    case Gambit::STATS_OPTION:
+      if (!Gambit::EnableStats((optarg) ? optarg : "json")) {
+	std::cerr << argv[0] << ": Unknown statistics format `" << optarg << "'.\n";
+	return 1;
+      }
+      break;
     case '?':
       if (isprint(optopt)) {
 	std::cerr << argv[0] << ": Unknown option `-" << ((char) optopt) << "'.\n";
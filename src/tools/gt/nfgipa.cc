@@ -26,7 +26,9 @@
 #include <iostream>
 #include <fstream>
 #include <cerrno>
+#include <climits>
 #include "libgambit/libgambit.h"
+#include "libgambit/stats.h"
 
 #include "nfgame.h"
 #include "aggame.h"
@@ -69,6 +71,8 @@ void PrintHelp(char *progname)
   std::cerr << "  -q               quiet mode (suppresses banner)\n";
   std::cerr << "  -V, --verbose    verbose mode (shows intermediate output)\n";
   std::cerr << "  -v, --version    print version information\n";
+  std::cerr << "  --stats[=FORMAT] on exit, print solver statistics to standard error\n";
+  std::cerr << "                   as json (the default) or csv\n";
   exit(1);
 }
 
@@ -81,12 +85,15 @@ void Solve(const Gambit::Game &p_game, const Gambit::Array<double> &p_pert)
   }
   else {
     int *actions = new int[p_game->NumPlayers()];
-    int veclength = p_game->NumPlayers();
+    // The payoffs are held in a cvector, which is indexed by int
+    Gambit::ContingencyIndex veclength = p_game->NumPlayers();
     for (int pl = 1; pl <= p_game->NumPlayers(); pl++) {
       actions[pl-1] = p_game->GetPlayer(pl)->NumStrategies();
-      veclength *= p_game->GetPlayer(pl)->NumStrategies();
+      veclength = Gambit::MultiplyContingencies(veclength,
+						p_game->GetPlayer(pl)->NumStrategies(),
+						INT_MAX);
     }
-    cvector payoffs(veclength);
+    cvector payoffs((int) veclength);
   
     A = new nfgame(p_game->NumPlayers(), actions, payoffs);
   
@@ -131,6 +138,7 @@ int main(int argc, char *argv[])
   struct option long_options[] = {
     { "help", 0, NULL, 'h'   },
     { "version", 0, NULL, 'v'  },
+    { "stats", optional_argument, NULL, Gambit::STATS_OPTION },
     { "verbose", 0, NULL, 'V'  },
     { 0,    0,    0,    0   }
   };
@@ -153,6 +161,12 @@ int main(int argc, char *argv[])
     case 'h':
       PrintHelp(argv[0]);
       break;
+    case Gambit::STATS_OPTION:
+      if (!Gambit::EnableStats((optarg) ? optarg : "json")) {
+	std::cerr << argv[0] << ": Unknown statistics format `" << optarg << "'.\n";
+	return 1;
+      }
+      break;
     case '?':
       if (isprint(optopt)) {
 	std::cerr << argv[0] << ": Unknown option `-" << ((char) optopt) << "'.\n";
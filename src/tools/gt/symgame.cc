@@ -0,0 +1,97 @@
+//
+// This file is part of Gambit
+// Copyright (c) 1994-2014, The Gambit Project (http://www.gambit-project.org)
+//
+// FILE: src/tools/gt/symgame.cc
+// Implement GNM-specific routines for symmetric games
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+//
+
+#include <cmath>
+#include <vector>
+#include "libgambit/stats.h"
+#include "symgame.h"
+
+symgame::symgame(const Gambit::Game &p_game)
+  // gnmgame copies the array of the numbers of actions
+  : gnmgame(1, &std::vector<int>(1, p_game->GetPlayer(1)->NumStrategies())[0]),
+    m_table(p_game),
+    m_minPayoff((double) p_game->GetMinPayoff()),
+    m_scale(1.0 / (double) (p_game->GetMaxPayoff() - p_game->GetMinPayoff()))
+{ }
+
+double symgame::toVector(const cvector &s, Gambit::Vector<double> &sigma)
+{
+  double sum = 0.0;
+  for (int i = 0; i < numActions; i++) {
+    sigma[i+1] = s[i];
+    sum += s[i];
+  }
+  return sum;
+}
+
+double symgame::getPurePayoff(int player, int *s)
+{
+  cvector sigma(numActions, 0.0), payoffs(numActions);
+  sigma[s[0]] = 1.0;
+  getPayoffVector(payoffs, player, sigma);
+  return payoffs[s[0]];
+}
+
+void symgame::setPurePayoff(int player, int *s, double value)
+{
+  throw Gambit::UndefinedException();
+}
+
+double symgame::getMixedPayoff(int player, cvector &s)
+{
+  cvector payoffs(numActions);
+  getPayoffVector(payoffs, player, s);
+  return payoffs * s;
+}
+
+//
+// Payoffs are scaled as (u - min) * scale.  The constant is multiplied
+// by the total probability raised to the degree of the payoffs, which
+// is one on the simplex, so that the scaled payoffs stay homogeneous
+// and DG*s / degree still gives them.
+//
+void symgame::getPayoffVector(cvector &dest, int player, const cvector &s)
+{
+  Gambit::Vector<double> sigma(numActions), payoffs(numActions);
+  double total = pow(toVector(s, sigma), getPayoffDegree());
+  m_table.GetPayoffs(sigma, payoffs);
+  for (int i = 0; i < numActions; i++) {
+    dest[i] = (payoffs[i+1] - m_minPayoff * total) * m_scale;
+  }
+}
+
+void symgame::payoffMatrix(cmatrix &dest, cvector &s, double fuzz)
+{
+  GAMBIT_STATS_TIMER(statsSectionJacobian);
+  GAMBIT_STATS_COUNT(statsJacobians);
+  Gambit::Vector<double> sigma(numActions);
+  Gambit::Matrix<double> derivs(numActions, numActions);
+  double sum = toVector(s, sigma);
+  m_table.GetPayoffDerivs(sigma, derivs);
+  int degree = getPayoffDegree();
+  double total = (degree > 0) ? degree * pow(sum, degree - 1) : 0.0;
+  for (int i = 0; i < numActions; i++) {
+    for (int j = 0; j < numActions; j++) {
+      dest[i][j] = (derivs(i+1, j+1) - m_minPayoff * total) * m_scale;
+    }
+  }
+}
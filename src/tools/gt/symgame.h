@@ -0,0 +1,65 @@
+//
+// This file is part of Gambit
+// Copyright (c) 1994-2014, The Gambit Project (http://www.gambit-project.org)
+//
+// FILE: src/tools/gt/symgame.h
+// Interface to GNM-specific routines for symmetric games
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+//
+
+#ifndef __SYMGAME_H
+#define __SYMGAME_H
+
+#include "cmatrix.h"
+#include "libgambit/libgambit.h"
+#include "libgambit/symmetric.h"
+#include "gnmgame.h"
+
+//
+// The symmetric equilibria of a symmetric game, in which every player
+// uses the same strategy, are the equilibria of a game with a single
+// player whose payoff to each strategy is the payoff to that strategy
+// against the others all playing like the player.  The payoffs of
+// this reduced game are polynomials of the degree of the number of
+// opponents, so GNM follows it like a game with one more player than
+// that.  Payoffs are scaled to the unit interval, as for nfgame.
+//
+class symgame : public gnmgame {
+ public:
+  // Throws Gambit::UndefinedException if the game is not symmetric
+  symgame(const Gambit::Game &p_game);
+  virtual ~symgame() { }
+
+  // The reduced game has only pure strategy profiles in which every
+  // player of the original game plays the same strategy
+  double getPurePayoff(int player, int *s);
+  void setPurePayoff(int player, int *s, double value);
+
+  double getMixedPayoff(int player, cvector &s);
+  void payoffMatrix(cmatrix &dest, cvector &s, double fuzz);
+  void getPayoffVector(cvector &dest, int player, const cvector &s);
+
+  int getPayoffDegree() { return m_table.NumPlayers() - 1; }
+
+ private:
+  Gambit::SymmetricPayoffTable<double> m_table;
+  double m_minPayoff, m_scale;
+
+  // Copies s into sigma, returning the total probability
+  double toVector(const cvector &s, Gambit::Vector<double> &sigma);
+};
+
+#endif  // __SYMGAME_H
@@ -41,13 +41,13 @@ public:
   List<BFS<T> > m_list;
   List<MixedBehaviorProfile<T> > m_equilibria;
 
-  bool AddBFS(const LTableau<T> &);
+  bool AddBFS(const SparseLTableau<T> &);
 
   int EquilibriumCount(void) const { return m_equilibria.size(); }
 };
 
 template <class T> bool 
-NashLcpBehaviorSolver<T>::Solution::AddBFS(const LTableau<T> &tableau)
+NashLcpBehaviorSolver<T>::Solution::AddBFS(const SparseLTableau<T> &tableau)
 {
   BFS<T> cbfs;
   Vector<T> v(tableau.MinRow(), tableau.MaxRow());
@@ -85,7 +85,7 @@ NashLcpBehaviorSolver<T>::Solve(const BehaviorSupportProfile &p_support) const
   }
 
   BFS<T> cbfs;
-  int i, j;
+  int i;
   Solution solution;
 
   solution.isets1 = p_support.ReachableInfosets(p_support.GetGame()->GetPlayer(1));
@@ -99,18 +99,16 @@ NashLcpBehaviorSolver<T>::Solve(const BehaviorSupportProfile &p_support) const
 
   ntot = solution.ns1+solution.ns2+solution.ni1+solution.ni2;
 
-  Matrix<T> A(1,ntot,0,ntot);
+  // The sequence-form matrix has one nonzero per pair of sequences
+  // leading to a common terminal node, plus the constraint entries,
+  // so it is built and factored sparsely
+  SparseMatrix<T> A(1,ntot,0,ntot);
   Vector<T> b(1,ntot);
 
   solution.maxpay = p_support.GetGame()->GetMaxPayoff() + Rational(1);
 
   T prob = (T)1;
-  for (i = A.MinRow(); i <= A.MaxRow(); i++) {
-    b[i] = (T) 0;
-    for (j = A.MinCol(); j <= A.MaxCol(); j++) {
-      A(i,j) = (T) 0; 
-    }
-  }
+  b = (T) 0;
 
   FillTableau(p_support, A, p_support.GetGame()->GetRoot(), prob, 1, 1, 0, 0,
 	      solution);
@@ -124,7 +122,7 @@ NashLcpBehaviorSolver<T>::Solve(const BehaviorSupportProfile &p_support) const
   b[solution.ns1+solution.ns2+1] = -(T)1;
   b[solution.ns1+solution.ns2+solution.ni1+1] = -(T)1;
 
-  LTableau<T> tab(A,b);
+  SparseLTableau<T> tab(A,b);
   solution.eps = tab.Epsilon();
   
   try {
@@ -171,8 +169,8 @@ NashLcpBehaviorSolver<T>::Solve(const BehaviorSupportProfile &p_support) const
 //
 template <class T> void
 NashLcpBehaviorSolver<T>::AllLemke(const BehaviorSupportProfile &p_support,
-				   int j, LTableau<T> &B, int depth,
-				   Matrix<T> &A,
+				   int j, SparseLTableau<T> &B, int depth,
+				   SparseMatrix<T> &A,
 				   Solution &p_solution) const
 {
   if (m_maxDepth != 0 && depth > m_maxDepth) {
@@ -188,7 +186,7 @@ NashLcpBehaviorSolver<T>::AllLemke(const BehaviorSupportProfile &p_support,
   for (int i = B.MinRow(); i <= B.MaxRow() && !newsol; i++) {
     if (i == j) continue;
 
-    LTableau<T> BCopy(B);
+    SparseLTableau<T> BCopy(B);
     A(i,0) = -small_num;
     BCopy.Refactor();
 
@@ -232,7 +230,7 @@ NashLcpBehaviorSolver<T>::AllLemke(const BehaviorSupportProfile &p_support,
 
 template <class T>
 void NashLcpBehaviorSolver<T>::FillTableau(const BehaviorSupportProfile &p_support, 
-					Matrix<T> &A,
+					SparseMatrix<T> &A,
 					const GameNode &n, T prob,
 					int s1, int s2, int i1, int i2,
 					Solution &p_solution) const
@@ -296,7 +294,7 @@ void NashLcpBehaviorSolver<T>::FillTableau(const BehaviorSupportProfile &p_suppo
 
 template <class T> void
 NashLcpBehaviorSolver<T>::GetProfile(const BehaviorSupportProfile &p_support,
-				     const LTableau<T> &tab, 
+				     const SparseLTableau<T> &tab, 
 				     MixedBehaviorProfile<T> &v, 
 				     const Vector<T> &sol,
 				     const GameNode &n, int s1, int s2,
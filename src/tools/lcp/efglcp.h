@@ -27,7 +27,8 @@
 
 using namespace Gambit;
 
-template <class T> class LTableau;
+template <class T> class SparseMatrix;
+template <class T> class SparseLTableau;
 
 template <class T> class NashLcpBehaviorSolver : public NashBehavSolver<T> {
 public:
@@ -44,11 +45,12 @@ private:
 
   class Solution;
 
-  void FillTableau(const BehaviorSupportProfile &, Matrix<T> &, const GameNode &, T,
+  void FillTableau(const BehaviorSupportProfile &, SparseMatrix<T> &,
+		   const GameNode &, T,
 		   int, int, int, int, Solution &) const;
-  void AllLemke(const BehaviorSupportProfile &, int dup, LTableau<T> &B,
-	       int depth, Matrix<T> &, Solution &) const; 
-  void GetProfile(const BehaviorSupportProfile &, const LTableau<T> &tab, 
+  void AllLemke(const BehaviorSupportProfile &, int dup, SparseLTableau<T> &B,
+	       int depth, SparseMatrix<T> &, Solution &) const; 
+  void GetProfile(const BehaviorSupportProfile &, const SparseLTableau<T> &tab, 
 		  MixedBehaviorProfile<T> &, const Vector<T> &, 
 		  const GameNode &n, int, int,
 		  Solution &) const;
@@ -24,3 +24,6 @@
 
 template class LTableau<double>;
 template class LTableau<Gambit::Rational>;
+
+template class SparseLTableau<double>;
+template class SparseLTableau<Gambit::Rational>;
@@ -24,6 +24,7 @@
 #define LEMKETAB_H
 
 #include "liblinear/tableau.h"
+#include "liblinear/sptableau.h"
 
 template <class T> class LTableau : public Tableau<T> {
 protected:
@@ -52,6 +53,31 @@ public:
   int LemkePath(int dup); // follow a path of ACBFS's from one CBFS to another
 };
 
+//
+// The sequence-form pivoting rules of LTableau, over a sparse
+// constraint matrix and sparse LU decomposition of the basis
+//
+template <class T> class SparseLTableau : public SparseTableau<T> {
+public:
+  class BadPivot : public Gambit::Exception  {
+  public:
+    virtual ~BadPivot() throw() { }
+    const char *what(void) const throw() { return "Bad Pivot in SparseLTableau"; }
+  };
+  class BadExitIndex : public Gambit::Exception  {
+  public:
+    virtual ~BadExitIndex() throw() { }
+    const char *what(void) const throw() { return "Bad Exit Index in SparseLTableau"; }
+  };
+  SparseLTableau(const SparseMatrix<T> &A, const Gambit::Vector<T> &b);
+  SparseLTableau(const SparseLTableau<T> &);
+  virtual ~SparseLTableau();
+
+  int SF_PivotIn(int i);
+  int SF_ExitIndex(int i);
+  int SF_LCPPath(int dup); // follow a path of ACBFS's from one CBFS to another
+};
+
 #endif     // LEMKETAB_H
 
 
@@ -186,7 +186,7 @@ void RatioEquation::Gradient(const LogBehavProfile<double> &p_profile,
 //------------------------------------------------------------------------------
 
 AgentQREPathTracer::AgentQREPathTracer(const MixedBehaviorProfile<double> &p_start) 
-  : m_start(p_start), m_fullGraph(true), m_decimals(6)
+  : m_start(p_start), m_fullGraph(true), m_decimals(6), m_stream(&std::cout)
 { 
   SetTargetParam(-1.0);
   for (int pl = 1; pl <= p_start.GetGame()->NumPlayers(); pl++) {
@@ -307,7 +307,7 @@ AgentQREPathTracer::OnStep(const Vector<double> &x,
 			   bool p_isTerminal = false)
 {
   if ((m_fullGraph && !p_isTerminal) || (!m_fullGraph && p_isTerminal)) {
-    PrintProfile(std::cout, x, p_isTerminal);
+    PrintProfile(*m_stream, x, p_isTerminal);
   }
 }
 
@@ -43,6 +43,10 @@ public:
   void SetDecimals(int p_decimals) { m_decimals = p_decimals; }
   int GetDecimals(void) const { return m_decimals; }
 
+  /// Sets the stream the points on the branch are written to
+  /// (by default, standard output)
+  void SetStream(std::ostream &p_stream) { m_stream = &p_stream; }
+
 protected:
   virtual void OnStep(const Vector<double> &, bool);
 
@@ -58,6 +62,7 @@ private:
   Array<Equation *> m_equations;
   bool m_fullGraph;
   int m_decimals;
+  std::ostream *m_stream;
 
   void PrintProfile(std::ostream &p_stream, const Vector<double> &x,
 		    bool p_isTerminal);
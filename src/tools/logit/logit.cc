@@ -28,6 +28,8 @@
 #include <unistd.h>
 #include <getopt.h>
 #include "libgambit/libgambit.h"
+#include "libgambit/stats.h"
+#include "tools/server/protocol.h"
 #include "efglogit.h"
 #include "nfglogit.h"
 
@@ -54,11 +56,14 @@ void PrintHelp(char *progname)
   std::cerr << "  -l LAMBDA        compute QRE at `lambda` accurately\n";
   std::cerr << "  -L FILE          compute maximum likelihood estimates;\n";
   std::cerr << "                   read strategy frequencies from FILE\n";
+  std::cerr << "  -y               trace the symmetric branch of a symmetric game\n";
   std::cerr << "  -h, --help       print this help message\n";
   std::cerr << "  -q               quiet mode (suppresses banner)\n";
   std::cerr << "  -e               print only the terminal equilibrium\n";
   std::cerr << "                   (default is to print the entire branch)\n";
   std::cerr << "  -v, --version    print version information\n";
+  std::cerr << "  --stats[=FORMAT] on exit, print solver statistics to standard error\n";
+  std::cerr << "                   as json (the default) or csv\n";
   exit(1);
 }
 
@@ -89,7 +94,7 @@ int main(int argc, char *argv[])
 {
   opterr = 0;
 
-  bool quiet = false, useStrategic = false;
+  bool quiet = false, useStrategic = false, useSymmetric = false;
   double maxLambda = 1000000.0;
   std::string mleFile = "", startFile = "";
   double maxDecel = 1.1;
@@ -102,10 +107,11 @@ int main(int argc, char *argv[])
   struct option long_options[] = {
     { "help", 0, NULL, 'h'   },
     { "version", 0, NULL, 'v'  },
+    { "stats", optional_argument, NULL, STATS_OPTION },
     { 0,    0,    0,    0   }
   };
   int c;
-  while ((c = getopt_long(argc, argv, "d:s:a:m:vqehSL:p:l:", long_options, &long_opt_index)) != -1) {
+  while ((c = getopt_long(argc, argv, "d:s:a:m:vqehSyL:p:l:", long_options, &long_opt_index)) != -1) {
     switch (c) {
     case 'v':
       PrintBanner(std::cerr); exit(1);
@@ -133,6 +139,9 @@ int main(int argc, char *argv[])
     case 'S':
       useStrategic = true;
       break;
+    case 'y':
+      useSymmetric = true;
+      break;
     case 'L':
       mleFile = optarg;
       break;
@@ -142,6 +151,12 @@ int main(int argc, char *argv[])
     case 'l':
       targetLambda = atof(optarg);
       break;
+    case STATS_OPTION:
+      if (!EnableStats((optarg) ? optarg : "json")) {
+	std::cerr << argv[0] << ": Unknown statistics format `" << optarg << "'.\n";
+	return 1;
+      }
+      break;
     case '?':
       if (isprint(optopt)) {
 	std::cerr << argv[0] << ": Unknown option `-" << ((char) optopt) << "'.\n";
@@ -174,11 +189,55 @@ int main(int argc, char *argv[])
 
   try {
     Gambit::Array<double> frequencies;
-    Gambit::Game game = Gambit::ReadGame(*input_stream);
+    Gambit::Game game;
+    // The server does not read the files named by -p and -L
+    if (GetServerPath() != "" && mleFile == "" && startFile == "") {
+      std::string text = ReadGameFile(*input_stream);
+      if (SolveOnServer("logit", argc, argv, optind, text, std::cout)) {
+	return 0;
+      }
+      std::istringstream game_stream(text);
+      game = Gambit::ReadGame(game_stream);
+    }
+    else {
+      game = Gambit::ReadGame(*input_stream);
+    }
     if (!game->IsPerfectRecall()) {
       throw UndefinedException("Computing equilibria of games with imperfect recall is not supported.");
     }
 
+    if (useSymmetric) {
+      if (mleFile != "") {
+	throw UndefinedException("Maximum likelihood estimation is not supported on the symmetric branch.");
+      }
+      SymmetricStrategicQREPathTracer tracer(game);
+      tracer.SetMaxDecel(maxDecel);
+      tracer.SetStepsize(hStart);
+      tracer.SetFullGraph(fullGraph);
+      tracer.SetTargetParam(targetLambda);
+      tracer.SetDecimals(decimals);
+      int numStrategies = game->GetPlayer(1)->NumStrategies();
+      Gambit::Vector<double> start(numStrategies);
+      if (startFile == "") {
+	start = 1.0 / (double) numStrategies;
+	tracer.TraceSymmetricPath(start, 0.0, maxLambda, 1.0);
+      }
+      else {
+	// The file gives a profile of the whole game; the strategy of
+	// the first player is taken to be that of all of them
+	Gambit::Array<double> profile(game->MixedProfileLength() + 1);
+	std::ifstream startData(startFile.c_str());
+	ReadProfile(startData, profile);
+	for (int st = 1; st <= numStrategies; st++) {
+	  start[st] = profile[st+1];
+	}
+	tracer.TraceSymmetricPath(start, profile[1], maxLambda, 1.0);
+	std::cout << std::endl;
+	tracer.TraceSymmetricPath(start, profile[1], maxLambda, -1.0);
+      }
+      return 0;
+    }
+
     if (mleFile != "" && (!game->IsTree() || useStrategic)) {
       frequencies = Gambit::Array<double>(game->MixedProfileLength());
       std::ifstream mleData(mleFile.c_str());
@@ -49,7 +49,7 @@ StrategicQREPathTracer::TraceStrategicPath(const MixedStrategyProfile<double> &p
     while (x[x.Length()] < p_maxLambda) {
       TracePath(x, p_maxLambda, p_omega);
       if (x[x.Length()] < p_maxLambda) {
-	std::cout << std::endl;
+	*m_stream << std::endl;
       }
     }
   }
@@ -81,10 +81,14 @@ StrategicQREPathTracer::Criterion(const Vector<double> &p_point,
   }
 }
 
+//----------------------------------------------------------------------------
+//            StrategicQREEquations: The equations of the path
+//----------------------------------------------------------------------------
+
 void 
-StrategicQREPathTracer::GetLHS(const Vector<double> &p_point, Vector<double> &p_lhs)
+StrategicQREEquations::GetLHS(const Vector<double> &p_point, Vector<double> &p_lhs)
 {
-  const Game &game = m_start.GetGame();
+  const Game &game = m_game;
   MixedStrategyProfile<double> profile(game->NewMixedStrategyProfile(0.0)), logprofile(game->NewMixedStrategyProfile(0.0));
   for (int i = 1; i <= profile.MixedProfileLength(); i++) {
     profile[i] = exp(p_point[i]);
@@ -116,10 +120,10 @@ StrategicQREPathTracer::GetLHS(const Vector<double> &p_point, Vector<double> &p_
 }
 
 void
-StrategicQREPathTracer::GetJacobian(const Vector<double> &p_point,
-				    Matrix<double> &p_matrix)
+StrategicQREEquations::GetJacobian(const Vector<double> &p_point,
+				   Matrix<double> &p_matrix)
 {
-  const Game &game = m_start.GetGame();
+  const Game &game = m_game;
   MixedStrategyProfile<double> profile(game->NewMixedStrategyProfile(0.0)), logprofile(game->NewMixedStrategyProfile(0.0));
   for (int i = 1; i <= profile.MixedProfileLength(); i++) {
     profile[i] = exp(p_point[i]);
@@ -241,9 +245,133 @@ void
 StrategicQREPathTracer::OnStep(const Vector<double> &x, bool p_isTerminal = false)
 {
   if ((m_fullGraph && !p_isTerminal) || (!m_fullGraph && p_isTerminal)) {
-    PrintProfile(std::cout, x, p_isTerminal);
+    PrintProfile(*m_stream, x, p_isTerminal);
+  }
+}
+
+
+
+
+//----------------------------------------------------------------------------
+//        SymmetricStrategicQREEquations: The equations of the path
+//----------------------------------------------------------------------------
+
+void 
+SymmetricStrategicQREEquations::GetLHS(const Vector<double> &p_point,
+				       Vector<double> &p_lhs)
+{
+  int m = m_table.NumStrategies();
+  Vector<double> sigma(m), payoffs(m);
+  for (int st = 1; st <= m; st++) {
+    sigma[st] = exp(p_point[st]);
+  }
+  m_table.GetPayoffs(sigma, payoffs);
+  double lambda = p_point[p_point.Length()];
+
+  // This is a sum-to-one equation
+  p_lhs[1] = -1.0;
+  for (int st = 1; st <= m; st++) {
+    p_lhs[1] += sigma[st];
+  }
+  // These are ratio equations
+  for (int st = 2; st <= m; st++) {
+    p_lhs[st] = (p_point[st] - p_point[1] -
+		 lambda * (payoffs[st] - payoffs[1]));
   }
 }
 
+void
+SymmetricStrategicQREEquations::GetJacobian(const Vector<double> &p_point,
+					    Matrix<double> &p_matrix)
+{
+  int m = m_table.NumStrategies();
+  Vector<double> sigma(m), payoffs(m);
+  Matrix<double> derivs(m, m);
+  for (int st = 1; st <= m; st++) {
+    sigma[st] = exp(p_point[st]);
+  }
+  m_table.GetPayoffs(sigma, payoffs);
+  m_table.GetPayoffDerivs(sigma, derivs);
+  double lambda = p_point[p_point.Length()];
 
+  p_matrix = 0.0;
+  // The sum-to-one equation; its derivative wrt lambda is zero
+  for (int st2 = 1; st2 <= m; st2++) {
+    p_matrix(st2, 1) = sigma[st2];
+  }
+  // The ratio equations.  Unlike in StrategicQREEquations, the
+  // payoffs depend on the probabilities of the player's own
+  // strategies, which are also those of the opponents.
+  for (int st = 2; st <= m; st++) {
+    for (int st2 = 1; st2 <= m; st2++) {
+      p_matrix(st2, st) = -lambda * sigma[st2] * (derivs(st, st2) -
+						  derivs(1, st2));
+    }
+    p_matrix(st, st) += 1.0;
+    p_matrix(1, st) -= 1.0;
+    // The last row is the derivative wrt lambda
+    p_matrix(p_matrix.NumRows(), st) = payoffs[1] - payoffs[st];
+  }
+}
+
+//----------------------------------------------------------------------------
+//                 SymmetricStrategicQREPathTracer
+//----------------------------------------------------------------------------
 
+void 
+SymmetricStrategicQREPathTracer::TraceSymmetricPath(const Vector<double> &p_start,
+						    double p_startLambda,
+						    double p_maxLambda, 
+						    double p_omega)
+{
+  Vector<double> x(p_start.Length() + 1);
+  for (int st = 1; st <= p_start.Length(); st++) {
+    x[st] = log(p_start[st]);
+  }
+  x[x.Length()] = p_startLambda;
+  TracePath(x, p_maxLambda, p_omega);
+}
+
+double
+SymmetricStrategicQREPathTracer::Criterion(const Vector<double> &p_point,
+					   const Vector<double> &p_tangent)
+{
+  if (GetTargetParam() > 0.0) {
+    return p_point[p_point.Length()] - GetTargetParam();
+  }
+  else {
+    return PathTracer::Criterion(p_point, p_tangent);
+  }
+}
+
+void 
+SymmetricStrategicQREPathTracer::PrintProfile(std::ostream &p_stream,
+					      const Vector<double> &x,
+					      bool p_isTerminal)
+{
+  p_stream.setf(std::ios::fixed);
+  // By convention, we output lambda first
+  if (!p_isTerminal) {
+    p_stream << std::setprecision(m_decimals) << x[x.Length()];
+  }
+  else {
+    p_stream << "NE";
+  }
+  p_stream.unsetf(std::ios::fixed);
+
+  for (int pl = 1; pl <= m_equations.GetTable().NumPlayers(); pl++) {
+    for (int i = 1; i < x.Length(); i++) {
+      p_stream << "," << std::setprecision(m_decimals) << exp(x[i]);
+    }
+  }
+  p_stream << std::endl;
+}
+
+void 
+SymmetricStrategicQREPathTracer::OnStep(const Vector<double> &x,
+					bool p_isTerminal)
+{
+  if ((m_fullGraph && !p_isTerminal) || (!m_fullGraph && p_isTerminal)) {
+    PrintProfile(*m_stream, x, p_isTerminal);
+  }
+}
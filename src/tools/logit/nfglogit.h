@@ -24,12 +24,31 @@
 #ifndef NFGLOGIT_H
 #define NFGLOGIT_H
 
+#include "libgambit/symmetric.h"
 #include "path.h"
 
+//
+// The equations defining the logit QRE correspondence of a strategic
+// game, in terms of the logarithms of the strategy probabilities
+// followed by lambda.
+//
+class StrategicQREEquations : public PathEquations {
+public:
+  StrategicQREEquations(const Game &p_game) : m_game(p_game) { }
+  virtual ~StrategicQREEquations() { }
+
+  virtual void GetLHS(const Vector<double> &p_point, Vector<double> &p_lhs);
+  virtual void GetJacobian(const Vector<double> &p_point, Matrix<double> &p_matrix);
+
+private:
+  Game m_game;
+};
+
 class StrategicQREPathTracer : public PathTracer {
 public:
   StrategicQREPathTracer(const MixedStrategyProfile<double> &p_start) 
-    : m_start(p_start), m_fullGraph(true), m_decimals(6)
+    : m_start(p_start), m_equations(p_start.GetGame()),
+      m_fullGraph(true), m_decimals(6), m_stream(&std::cout)
     { SetTargetParam(-1.0); }
   virtual ~StrategicQREPathTracer() { }
 
@@ -43,6 +62,10 @@ public:
   void SetDecimals(int p_decimals) { m_decimals = p_decimals; }
   int GetDecimals(void) const { return m_decimals; }
 
+  /// Sets the stream the points on the branch are written to
+  /// (by default, standard output)
+  void SetStream(std::ostream &p_stream) { m_stream = &p_stream; }
+
   void SetMLEFrequencies(const Array<double> &p_frequencies)
   { m_frequencies = p_frequencies; }
   const Array<double> &GetMLEFrequencies(void) const { return m_frequencies; }
@@ -56,9 +79,11 @@ protected:
   virtual double Criterion(const Vector<double> &, const Vector<double> &);
 
   // Compute the LHS of the system of equations at the specified point.
-  virtual void GetLHS(const Vector<double> &p_point, Vector<double> &p_lhs);
+  virtual void GetLHS(const Vector<double> &p_point, Vector<double> &p_lhs)
+  { m_equations.GetLHS(p_point, p_lhs); }
   // Compute the Jacobian matrix at the specified point.
-  virtual void GetJacobian(const Vector<double> &p_point, Matrix<double> &p_matrix);
+  virtual void GetJacobian(const Vector<double> &p_point, Matrix<double> &p_matrix)
+  { m_equations.GetJacobian(p_point, p_matrix); }
 
 private:
   void PrintProfile(std::ostream &, const Vector<double> &, bool);
@@ -67,11 +92,78 @@ private:
   double LogLike(const Array<double> &p_point);
 
   MixedStrategyProfile<double> m_start;
+  StrategicQREEquations m_equations;
   bool m_fullGraph;
   Array<double> m_frequencies;
   int m_decimals;
+  std::ostream *m_stream;
   
 };
 
+//
+// The equations defining the symmetric branch of the logit QRE
+// correspondence of a symmetric game, on which all players use the
+// same strategy.  A point consists of the logarithms of the strategy
+// probabilities of one player followed by lambda, so the size of the
+// system does not depend on the number of players.
+//
+class SymmetricStrategicQREEquations : public PathEquations {
+public:
+  SymmetricStrategicQREEquations(const Game &p_game) : m_table(p_game) { }
+  virtual ~SymmetricStrategicQREEquations() { }
+
+  virtual void GetLHS(const Vector<double> &p_point, Vector<double> &p_lhs);
+  virtual void GetJacobian(const Vector<double> &p_point, Matrix<double> &p_matrix);
+
+  const SymmetricPayoffTable<double> &GetTable(void) const { return m_table; }
+
+private:
+  SymmetricPayoffTable<double> m_table;
+};
+
+class SymmetricStrategicQREPathTracer : public PathTracer {
+public:
+  /// Throws UndefinedException if the game is not symmetric
+  SymmetricStrategicQREPathTracer(const Game &p_game)
+    : m_equations(p_game), m_fullGraph(true), m_decimals(6),
+      m_stream(&std::cout)
+    { SetTargetParam(-1.0); }
+  virtual ~SymmetricStrategicQREPathTracer() { }
+
+  /// Traces the branch from the point at which all players use the
+  /// mixed strategy p_start at lambda p_startLambda
+  void TraceSymmetricPath(const Vector<double> &p_start,
+			  double p_startLambda, double p_maxLambda,
+			  double p_omega);
+
+  void SetFullGraph(bool p_fullGraph) { m_fullGraph = p_fullGraph; }
+  bool GetFullGraph(void) const { return m_fullGraph; }
+
+  void SetDecimals(int p_decimals) { m_decimals = p_decimals; }
+  int GetDecimals(void) const { return m_decimals; }
+
+  /// Sets the stream the points on the branch are written to
+  /// (by default, standard output)
+  void SetStream(std::ostream &p_stream) { m_stream = &p_stream; }
+
+protected:
+  virtual void OnStep(const Vector<double> &, bool);
+
+  virtual double Criterion(const Vector<double> &, const Vector<double> &);
+
+  virtual void GetLHS(const Vector<double> &p_point, Vector<double> &p_lhs)
+  { m_equations.GetLHS(p_point, p_lhs); }
+  virtual void GetJacobian(const Vector<double> &p_point, Matrix<double> &p_matrix)
+  { m_equations.GetJacobian(p_point, p_matrix); }
+
+private:
+  // Writes the point as a profile of the whole game
+  void PrintProfile(std::ostream &, const Vector<double> &, bool);
+
+  SymmetricStrategicQREEquations m_equations;
+  bool m_fullGraph;
+  int m_decimals;
+  std::ostream *m_stream;
+};
 
 #endif // NFGLOGIT_H
@@ -26,6 +26,7 @@
 
 #include <libgambit/libgambit.h>
 #include <libgambit/sqmatrix.h>
+#include <libgambit/stats.h>
 using namespace Gambit;
 
 #include "path.h"
@@ -73,6 +74,8 @@ static void Givens(Matrix<double> &b, Matrix<double> &q,
 
 static void QRDecomp(Matrix<double> &b, Matrix<double> &q)
 {
+  GAMBIT_STATS_TIMER(statsSectionQR);
+  GAMBIT_STATS_COUNT(statsQRDecompositions);
   q.MakeIdent();
   for (int m = 1; m <= b.NumColumns(); m++) {
     for (int k = m + 1; k <= b.NumRows(); k++) {
@@ -109,6 +112,14 @@ static void NewtonStep(Matrix<double> &q, Matrix<double> &b,
 //             PathTracer: Implementation of path-following engine
 //----------------------------------------------------------------------------
 
+void PathTracer::TimedJacobian(const Vector<double> &p_point,
+			       Matrix<double> &p_matrix)
+{
+  GAMBIT_STATS_TIMER(statsSectionJacobian);
+  GAMBIT_STATS_COUNT(statsJacobians);
+  GetJacobian(p_point, p_matrix);
+}
+
 void 
 PathTracer::TracePath(Vector<double> &x,
 		      double p_maxLambda, double &p_omega)
@@ -120,7 +131,6 @@ PathTracer::TracePath(Vector<double> &x,
                                    // in calculating contraction rate
   double h = m_hStart;             // initial stepsize
   const double c_hmin = 1.0e-8;    // minimal stepsize
-  const int c_maxIter = 100;       // maximum iterations in corrector
   
   bool newton = false;             // using Newton steplength (for zero-finding)
 
@@ -132,7 +142,7 @@ PathTracer::TracePath(Vector<double> &x,
   SquareMatrix<double> q(x.Length());
 
   OnStep(x, false);
-  GetJacobian(x, b);
+  TimedJacobian(x, b);
   QRDecomp(b, q);
   q.GetRow(q.NumRows(), t);
   
@@ -153,7 +163,7 @@ PathTracer::TracePath(Vector<double> &x,
     }
 
     double decel = 1.0 / m_maxDecel;  // initialize deceleration factor
-    GetJacobian(u, b);
+    TimedJacobian(u, b);
     QRDecomp(b, q);
 
     int iter = 1;
@@ -163,6 +173,7 @@ PathTracer::TracePath(Vector<double> &x,
 
       GetLHS(u, y);
       NewtonStep(q, b, u, y, dist); 
+      GAMBIT_STATS_COUNT(statsCorrectorIterations);
 
       if (dist >= c_maxDist) {
 	accept = false;
@@ -185,7 +196,7 @@ PathTracer::TracePath(Vector<double> &x,
       }
       disto = dist;
       iter++;
-      if (iter > c_maxIter) {
+      if (iter > m_maxIter) {
 	OnStep(x, true);
 	if (newton) {
 	  // Restore the place to restart if desired
@@ -234,6 +245,7 @@ PathTracer::TracePath(Vector<double> &x,
 
     // PC step was successful; update and iterate
     x = u;
+    GAMBIT_STATS_COUNT(statsPathSteps);
     OnStep(x, false);
 
     if (t * newT < 0.0) {
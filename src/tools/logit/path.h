@@ -25,6 +25,23 @@
 
 using namespace Gambit;
 
+//
+// The system of equations whose solutions form a path, for use by
+// tracers which take the equations as a separate object.  A point
+// consists of the variables followed by the parameter, so the LHS has
+// one entry fewer than the point, and the Jacobian has one row for
+// each entry of the point and one column for each equation.
+//
+class PathEquations {
+public:
+  virtual ~PathEquations() { }
+
+  // Compute the LHS of the system of equations at the specified point.
+  virtual void GetLHS(const Vector<double> &p_point, Vector<double> &p_lhs) = 0;
+  // Compute the Jacobian matrix at the specified point.
+  virtual void GetJacobian(const Vector<double> &p_point, Matrix<double> &p_matrix) = 0;
+};
+
 //
 // This class implements a generic path-following algorithm for smooth curves.
 // It is based on the ideas and codes presented in Allgower and Georg's
@@ -41,8 +58,12 @@ public:
   void SetTargetParam(double p_targetParam) { m_targetParam = p_targetParam; }
   double GetTargetParam(void) const { return m_targetParam; }
 
+  void SetMaxIter(int p_maxIter) { m_maxIter = p_maxIter; }
+  int GetMaxIter(void) const { return m_maxIter; }
+
 protected:
-  PathTracer(void) : m_maxDecel(1.1), m_hStart(0.03), m_targetParam(0.0) 
+  PathTracer(void) : m_maxDecel(1.1), m_hStart(0.03), m_targetParam(0.0),
+		     m_maxIter(100)
     { } 
   virtual ~PathTracer() { }
 
@@ -62,6 +83,10 @@ protected:
 
 private:
   double m_maxDecel, m_hStart, m_targetParam;
+  int m_maxIter;
+
+  // Calls GetJacobian(), recording it in the solver statistics
+  void TimedJacobian(const Vector<double> &p_point, Matrix<double> &p_matrix);
 };
 
 #endif  // PATH_H
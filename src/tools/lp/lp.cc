@@ -28,6 +28,8 @@
 #include <unistd.h>
 #include <getopt.h>
 #include "libgambit/libgambit.h"
+#include "libgambit/stats.h"
+#include "tools/server/protocol.h"
 #include "efglp.h"
 #include "nfglp.h"
 
@@ -56,6 +58,8 @@ void PrintHelp(char *progname)
   std::cerr << "  -h, --help       print this help message\n";
   std::cerr << "  -q               quiet mode (suppresses banner)\n";
   std::cerr << "  -v, --version    print version information\n";
+  std::cerr << "  --stats[=FORMAT] on exit, print solver statistics to standard error\n";
+  std::cerr << "                   as json (the default) or csv\n";
   exit(1);
 }
 
@@ -70,6 +74,7 @@ int main(int argc, char *argv[])
   struct option long_options[] = {
     { "help", 0, NULL, 'h'   },
     { "version", 0, NULL, 'v'  },
+    { "stats", optional_argument, NULL, STATS_OPTION },
     { 0,    0,    0,    0   }
   };
   while ((c = getopt_long(argc, argv, "d:DvqhSP", long_options, &long_opt_index)) != -1) {
@@ -95,6 +100,12 @@ int main(int argc, char *argv[])
     case 'P':
       bySubgames = true;
       break;
+    case STATS_OPTION:
+      if (!EnableStats((optarg) ? optarg : "json")) {
+	std::cerr << argv[0] << ": Unknown statistics format `" << optarg << "'.\n";
+	return 1;
+      }
+      break;
     case '?':
       if (isprint(optopt)) {
 	std::cerr << argv[0] << ": Unknown option `-" << ((char) optopt) << "'.\n";
@@ -126,7 +137,18 @@ int main(int argc, char *argv[])
   }
 
   try {
-    Gambit::Game game = Gambit::ReadGame(*input_stream);
+    Gambit::Game game;
+    if (GetServerPath() != "") {
+      std::string text = ReadGameFile(*input_stream);
+      if (SolveOnServer("lp", argc, argv, optind, text, std::cout)) {
+	return 0;
+      }
+      std::istringstream game_stream(text);
+      game = Gambit::ReadGame(game_stream);
+    }
+    else {
+      game = Gambit::ReadGame(*input_stream);
+    }
     if (!game->IsTree() || useStrategic) {
       if (useFloat) {
 	shared_ptr<StrategyProfileRenderer<double> > renderer;
@@ -0,0 +1,278 @@
+//
+// This file is part of Gambit
+// Copyright (c) 1994-2014, The Gambit Project (http://www.gambit-project.org)
+//
+// FILE: src/tools/server/protocol.cc
+// Talking to gambit-server over a Unix domain socket
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+//
+
+#include <config.h>
+#include <cstdlib>
+#include <cstring>
+#include <cerrno>
+#include <sstream>
+#include <iterator>
+
+#if defined(HAVE_SYS_SOCKET_H) && defined(HAVE_SYS_UN_H)
+#define GAMBIT_HAVE_SOCKETS 1
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#endif  // HAVE_SYS_SOCKET_H && HAVE_SYS_UN_H
+
+#include "libgambit/stats.h"
+#include "protocol.h"
+
+namespace Gambit {
+
+//=========================================================================
+//                        class ServerConnection
+//=========================================================================
+
+#ifdef GAMBIT_HAVE_SOCKETS
+
+bool IsPeerSameUser(int p_socket)
+{
+#if defined(HAVE_GETPEEREID)
+  uid_t uid;
+  gid_t gid;
+  if (getpeereid(p_socket, &uid, &gid) < 0) {
+    return false;
+  }
+  return uid == getuid();
+#elif defined(SO_PEERCRED)
+  struct ucred credentials;
+  socklen_t length = sizeof(credentials);
+  if (getsockopt(p_socket, SOL_SOCKET, SO_PEERCRED,
+		 &credentials, &length) < 0) {
+    return false;
+  }
+  return credentials.uid == getuid();
+#else
+  return false;
+#endif  // HAVE_GETPEEREID
+}
+
+ServerConnection::~ServerConnection()
+{
+  close(m_socket);
+}
+
+ServerConnection *ServerConnection::Connect(const std::string &p_path)
+{
+  struct sockaddr_un address;
+  if (p_path.empty() || p_path.length() >= sizeof(address.sun_path)) {
+    return 0;
+  }
+  memset(&address, 0, sizeof(address));
+  address.sun_family = AF_UNIX;
+  strcpy(address.sun_path, p_path.c_str());
+
+  int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+  if (fd < 0) {
+    return 0;
+  }
+  if (connect(fd, (struct sockaddr *) &address, sizeof(address)) < 0) {
+    close(fd);
+    return 0;
+  }
+  // Anyone can create a socket at a path another user will look at;
+  // nothing is sent unless the server runs as this user
+  if (!IsPeerSameUser(fd)) {
+    close(fd);
+    return 0;
+  }
+  return new ServerConnection(fd);
+}
+
+bool ServerConnection::Fill(void)
+{
+  if (m_start > 0) {
+    m_buffer.erase(0, m_start);
+    m_start = 0;
+  }
+  char data[4096];
+  ssize_t count;
+  do {
+    count = recv(m_socket, data, sizeof(data), 0);
+  } while (count < 0 && errno == EINTR);
+  if (count <= 0) {
+    return false;
+  }
+  m_buffer.append(data, count);
+  return true;
+}
+
+bool ServerConnection::Write(const std::string &p_data)
+{
+  size_t written = 0;
+  while (written < p_data.length()) {
+#ifdef MSG_NOSIGNAL
+    ssize_t count = send(m_socket, p_data.data() + written,
+			 p_data.length() - written, MSG_NOSIGNAL);
+#else
+    ssize_t count = send(m_socket, p_data.data() + written,
+			 p_data.length() - written, 0);
+#endif  // MSG_NOSIGNAL
+    if (count < 0) {
+      if (errno == EINTR)  continue;
+      return false;
+    }
+    written += count;
+  }
+  return true;
+}
+
+#else
+
+bool IsPeerSameUser(int) { return false; }
+
+ServerConnection::~ServerConnection() { }
+
+ServerConnection *ServerConnection::Connect(const std::string &)
+{ return 0; }
+
+bool ServerConnection::Fill(void) { return false; }
+
+bool ServerConnection::Write(const std::string &) { return false; }
+
+#endif  // GAMBIT_HAVE_SOCKETS
+
+bool ServerConnection::ReadLine(std::string &p_line)
+{
+  size_t end;
+  while ((end = m_buffer.find('\n', m_start)) == std::string::npos) {
+    if (!Fill()) {
+      return false;
+    }
+  }
+  p_line.assign(m_buffer, m_start, end - m_start);
+  m_start = end + 1;
+  return true;
+}
+
+bool ServerConnection::Read(size_t p_length, std::string &p_data)
+{
+  while (m_buffer.length() - m_start < p_length) {
+    if (!Fill()) {
+      return false;
+    }
+  }
+  p_data.assign(m_buffer, m_start, p_length);
+  m_start += p_length;
+  return true;
+}
+
+//=========================================================================
+//                       class ServerOutputBuffer
+//=========================================================================
+
+ServerOutputBuffer::ServerOutputBuffer(ServerConnection &p_connection)
+  : m_connection(p_connection), m_atLineStart(true)
+{
+  setp(m_buffer, m_buffer + sizeof(m_buffer));
+}
+
+int ServerOutputBuffer::overflow(int p_char)
+{
+  if (sync() != 0) {
+    return traits_type::eof();
+  }
+  if (p_char != traits_type::eof()) {
+    *pptr() = (char) p_char;
+    pbump(1);
+  }
+  return traits_type::not_eof(p_char);
+}
+
+int ServerOutputBuffer::sync(void)
+{
+  std::string data(pbase(), pptr() - pbase());
+  setp(m_buffer, m_buffer + sizeof(m_buffer));
+  if (data.empty()) {
+    return 0;
+  }
+  m_atLineStart = (data[data.length() - 1] == '\n');
+  return m_connection.Write(data) ? 0 : -1;
+}
+
+//=========================================================================
+//                           Client functions
+//=========================================================================
+
+std::string GetServerPath(void)
+{
+#ifdef GAMBIT_HAVE_SOCKETS
+  const char *path = getenv("GAMBIT_SERVER");
+  return (path) ? path : "";
+#else
+  return "";
+#endif  // GAMBIT_HAVE_SOCKETS
+}
+
+std::string ReadGameFile(std::istream &p_stream)
+{
+  return std::string(std::istreambuf_iterator<char>(p_stream),
+		     std::istreambuf_iterator<char>());
+}
+
+bool SolveOnServer(const std::string &p_method,
+		   int argc, char *argv[], int p_optind,
+		   const std::string &p_game, std::ostream &p_output)
+{
+  if (g_statsEnabled) {
+    // The statistics asked for are those of solving in this process
+    return false;
+  }
+
+  ServerConnection *connection = ServerConnection::Connect(GetServerPath());
+  if (!connection) {
+    return false;
+  }
+
+  std::ostringstream request;
+  request << SERVER_PROTOCOL << ' ' << p_method;
+  for (int i = 1; i < p_optind && i < argc; i++) {
+    request << ' ' << argv[i];
+  }
+  request << '\n' << p_game.length() << '\n' << p_game;
+
+  std::string line;
+  if (!connection->Write(request.str()) ||
+      !connection->ReadLine(line) || line != "#OK") {
+    // Nothing has been computed, so the caller can do it instead
+    delete connection;
+    return false;
+  }
+
+  while (connection->ReadLine(line)) {
+    if (line == "#END") {
+      delete connection;
+      return true;
+    }
+    else if (line.compare(0, 7, "#ERROR ") == 0) {
+      delete connection;
+      throw ServerException(line.substr(7));
+    }
+    p_output << line << std::endl;
+  }
+  delete connection;
+  throw ServerException("Lost connection to gambit-server");
+}
+
+}  // end namespace Gambit
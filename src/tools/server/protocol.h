@@ -0,0 +1,136 @@
+//
+// This file is part of Gambit
+// Copyright (c) 1994-2014, The Gambit Project (http://www.gambit-project.org)
+//
+// FILE: src/tools/server/protocol.h
+// Talking to gambit-server over a Unix domain socket
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+//
+
+#ifndef GAMBIT_SERVER_PROTOCOL_H
+#define GAMBIT_SERVER_PROTOCOL_H
+
+//
+// A request is a line
+//   gambit-server 1 METHOD [OPTION ...]
+// giving the method (the name of the tool, without "gambit-") and the
+// options as they would be given to the tool, then a line with the
+// length of the game file in bytes, followed by the game file itself.
+//
+// The server answers with a line "#OK" if it takes the request, or
+// "#UNSUPPORTED reason" if not, in which case the client computes
+// the equilibria itself.  After "#OK" comes the output of the tool,
+// line by line as it is computed, and finally "#END", or "#ERROR
+// message" if the computation failed.  No line of output of the tools
+// starts with '#'.
+//
+
+#include <string>
+#include <iostream>
+#include "libgambit/libgambit.h"
+
+namespace Gambit {
+
+/// The start of the first line of each request
+const char SERVER_PROTOCOL[] = "gambit-server 1";
+
+/// Thrown when the server reports an error, or the connection to it fails
+class ServerException : public Exception {
+public:
+  ServerException(const std::string &s) : Exception(s) { }
+  virtual ~ServerException() throw() { }
+};
+
+/// Whether the process at the other end of the Unix domain socket runs
+/// as the same user as this one.  False if the system cannot tell.
+bool IsPeerSameUser(int p_socket);
+
+/// The socket of a connection to or from the server
+class ServerConnection {
+private:
+  int m_socket;
+  std::string m_buffer;
+  size_t m_start;
+
+  ServerConnection(const ServerConnection &);
+  ServerConnection &operator=(const ServerConnection &);
+
+  /// Reads more from the socket into the buffer; false at end of file
+  bool Fill(void);
+
+public:
+  /// Takes ownership of an open socket
+  explicit ServerConnection(int p_socket)
+    : m_socket(p_socket), m_start(0) { }
+  ~ServerConnection();
+
+  /// Connects to the server listening at p_path, returning null if
+  /// there is none, or it runs as another user
+  static ServerConnection *Connect(const std::string &p_path);
+
+  int GetSocket(void) const { return m_socket; }
+
+  /// Reads a line, without the newline; false at end of file
+  bool ReadLine(std::string &p_line);
+  /// Reads exactly p_length bytes; false if the input ends first
+  bool Read(size_t p_length, std::string &p_data);
+  /// Writes all of p_data; false if the connection has closed
+  bool Write(const std::string &p_data);
+};
+
+/// An output buffer which writes to a connection, for writing the
+/// output of a computation with the usual stream operators.  Output
+/// is sent when the buffer is full or the stream is flushed.  Fails
+/// (setting badbit on the stream) if the connection has closed.
+class ServerOutputBuffer : public std::streambuf {
+private:
+  ServerConnection &m_connection;
+  char m_buffer[4096];
+  bool m_atLineStart;
+
+protected:
+  int overflow(int p_char);
+  int sync(void);
+
+public:
+  ServerOutputBuffer(ServerConnection &p_connection);
+
+  /// Whether the output sent so far ends with a complete line
+  bool AtLineStart(void) const { return m_atLineStart; }
+};
+
+/// Returns the path of the socket the server listens on, which is the
+/// value of GAMBIT_SERVER.  Returns an empty string if GAMBIT_SERVER is
+/// not set or empty, in which case the tools do not look for a server.
+std::string GetServerPath(void);
+
+/// Reads the whole of p_stream, which holds a game file
+std::string ReadGameFile(std::istream &p_stream);
+
+/// Asks the server to run p_method on the game file p_game, with the
+/// options in argv[1] to argv[p_optind-1].  If the server takes the
+/// request, copies its output to p_output and returns true.  Returns
+/// false if there is no server, it does not handle the request, or
+/// solver statistics are being recorded, in which case the caller
+/// computes the equilibria itself.  Throws
+/// ServerException if the computation fails once it has started.
+bool SolveOnServer(const std::string &p_method,
+		   int argc, char *argv[], int p_optind,
+		   const std::string &p_game, std::ostream &p_output);
+
+}  // end namespace Gambit
+
+#endif  // GAMBIT_SERVER_PROTOCOL_H
@@ -0,0 +1,692 @@
+//
+// This file is part of Gambit
+// Copyright (c) 1994-2014, The Gambit Project (http://www.gambit-project.org)
+//
+// FILE: src/tools/server/server.cc
+// A local service running the solvers, with a cache of parsed games
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+//
+
+#include <config.h>
+#include <iostream>
+#include <sstream>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cerrno>
+#include <csignal>
+#include <list>
+#include <map>
+#include <deque>
+#include <vector>
+#include <unistd.h>
+#include <getopt.h>
+
+#if defined(HAVE_SYS_SOCKET_H) && defined(HAVE_SYS_UN_H)
+#define GAMBIT_HAVE_SOCKETS 1
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#endif  // HAVE_SYS_SOCKET_H && HAVE_SYS_UN_H
+
+#include "libgambit/libgambit.h"
+#include "libgambit/thread.h"
+#include "tools/enumpure/enumpure.h"
+#include "tools/lcp/nfglcp.h"
+#include "tools/lcp/efglcp.h"
+#include "tools/lp/nfglp.h"
+#include "tools/lp/efglp.h"
+#include "tools/logit/nfglogit.h"
+#include "tools/logit/efglogit.h"
+#include "protocol.h"
+
+using namespace Gambit;
+
+void PrintBanner(std::ostream &p_stream)
+{
+  p_stream << "Serve requests from the Gambit command-line tools\n";
+  p_stream << "Gambit version " VERSION ", Copyright (C) 1994-2014, The Gambit Project\n";
+  p_stream << "This is free software, distributed under the GNU GPL\n\n";
+}
+
+void PrintHelp(char *progname)
+{
+  PrintBanner(std::cerr);
+  std::cerr << "Usage: " << progname << " [OPTIONS]\n";
+  std::cerr << "Listens for requests from gambit-enumpure, gambit-lcp, gambit-lp\n";
+  std::cerr << "and gambit-logit, keeping the games they send parsed in memory.\n\n";
+
+  std::cerr << "Options:\n";
+  std::cerr << "  -s PATH          listen on the socket PATH (default is the value\n";
+  std::cerr << "                   of GAMBIT_SERVER)\n";
+  std::cerr << "  -t THREADS       serve requests using THREADS threads\n";
+  std::cerr << "                   (default is one per processor)\n";
+  std::cerr << "  -c GAMES         keep up to GAMES parsed games (default 256)\n";
+  std::cerr << "  -h, --help       print this help message\n";
+  std::cerr << "  -q               quiet mode (suppresses banner)\n";
+  std::cerr << "  -v, --version    print version information\n";
+  exit(1);
+}
+
+//=========================================================================
+//                           class GameCache
+//=========================================================================
+
+//
+// The games most recently sent to the server, indexed by a hash of
+// the text of the game file.  Games are frozen when they are parsed,
+// so requests on the same game can be served at the same time.
+//
+class GameCache {
+private:
+  struct Entry {
+    unsigned int m_hash;
+    std::string m_text;
+    Game m_game;
+
+    Entry(unsigned int p_hash, const std::string &p_text, const Game &p_game)
+      : m_hash(p_hash), m_text(p_text), m_game(p_game) { }
+  };
+  typedef std::list<Entry> EntryList;
+
+  int m_capacity;
+  Mutex m_mutex;
+  /// The entries, most recently used first
+  EntryList m_entries;
+  std::map<unsigned int, EntryList::iterator> m_index;
+
+  static unsigned int Hash(const std::string &p_text);
+
+public:
+  GameCache(int p_capacity) : m_capacity(p_capacity) { }
+
+  /// Returns the game in the file p_text, parsing it if it is not in
+  /// the cache
+  Game Get(const std::string &p_text);
+};
+
+// The 32-bit FNV-1a hash
+unsigned int GameCache::Hash(const std::string &p_text)
+{
+  unsigned int hash = 2166136261u;
+  for (size_t i = 0; i < p_text.length(); i++) {
+    hash ^= (unsigned char) p_text[i];
+    hash *= 16777619u;
+  }
+  return hash;
+}
+
+Game GameCache::Get(const std::string &p_text)
+{
+  unsigned int hash = Hash(p_text);
+  {
+    MutexLock lock(m_mutex);
+    std::map<unsigned int, EntryList::iterator>::iterator pos =
+      m_index.find(hash);
+    if (pos != m_index.end() && pos->second->m_text == p_text) {
+      m_entries.splice(m_entries.begin(), m_entries, pos->second);
+      return pos->second->m_game;
+    }
+  }
+
+  // Parsing can take a while, so other requests are not held up
+  std::istringstream stream(p_text);
+  Game game = ReadGame(stream);
+  game->Freeze();
+
+  MutexLock lock(m_mutex);
+  std::map<unsigned int, EntryList::iterator>::iterator pos =
+    m_index.find(hash);
+  if (pos != m_index.end()) {
+    // Either another request has just parsed the same game, or this
+    // is a different game with the same hash; the newer one stays
+    m_entries.erase(pos->second);
+    m_index.erase(pos);
+  }
+  m_entries.push_front(Entry(hash, p_text, game));
+  m_index[hash] = m_entries.begin();
+  while ((int) m_entries.size() > m_capacity) {
+    m_index.erase(m_entries.back().m_hash);
+    m_entries.pop_back();
+  }
+  return game;
+}
+
+//=========================================================================
+//                          class ServerOptions
+//=========================================================================
+
+//
+// The options sent with a request, parsed in the way getopt() would
+// parse them for the tool.  Unlike getopt(), this can be used on
+// several threads at once.
+//
+class ServerOptions {
+private:
+  std::map<char, std::string> m_values;
+
+public:
+  /// Parses p_args according to p_optstring.  Returns false, with a
+  /// description in p_error, if there is an option not in p_optstring,
+  /// an option without its argument, or an argument which is not an
+  /// option.
+  bool Parse(const std::vector<std::string> &p_args, const char *p_optstring,
+	     std::string &p_error);
+
+  bool Has(char p_option) const
+  { return m_values.find(p_option) != m_values.end(); }
+  int GetInt(char p_option, int p_default) const
+  { return Has(p_option) ? atoi(m_values.find(p_option)->second.c_str()) : p_default; }
+  double GetDouble(char p_option, double p_default) const
+  { return Has(p_option) ? atof(m_values.find(p_option)->second.c_str()) : p_default; }
+};
+
+bool ServerOptions::Parse(const std::vector<std::string> &p_args,
+			  const char *p_optstring, std::string &p_error)
+{
+  for (size_t i = 0; i < p_args.size(); i++) {
+    const std::string &arg = p_args[i];
+    if (arg.length() < 2 || arg[0] != '-' || arg[1] == '-') {
+      p_error = "argument `" + arg + "' not handled by the server";
+      return false;
+    }
+    for (size_t j = 1; j < arg.length(); j++) {
+      const char *spec = strchr(p_optstring, arg[j]);
+      if (!spec || arg[j] == ':') {
+	p_error = std::string("option `-") + arg[j] + "' not handled by the server";
+	return false;
+      }
+      if (spec[1] != ':') {
+	m_values[arg[j]] = "";
+      }
+      else if (j + 1 < arg.length()) {
+	m_values[arg[j]] = arg.substr(j + 1);
+	break;
+      }
+      else if (i + 1 < p_args.size()) {
+	m_values[arg[j]] = p_args[++i];
+      }
+      else {
+	p_error = std::string("option `-") + arg[j] + "' requires an argument";
+	return false;
+      }
+    }
+  }
+  return true;
+}
+
+//=========================================================================
+//                               Methods
+//=========================================================================
+
+template <class T> shared_ptr<StrategyProfileRenderer<T> >
+MakeRenderer(std::ostream &p_stream, bool p_behav, bool p_detail,
+	     int p_decimals)
+{
+  if (p_behav) {
+    if (p_detail) {
+      return new BehavStrategyDetailRenderer<T>(p_stream, p_decimals);
+    }
+    return new BehavStrategyCSVRenderer<T>(p_stream, p_decimals);
+  }
+  if (p_detail) {
+    return new MixedStrategyDetailRenderer<T>(p_stream, p_decimals);
+  }
+  return new MixedStrategyCSVRenderer<T>(p_stream, p_decimals);
+}
+
+//
+// Each method does what its tool does after reading the game.  Solving
+// by subgames changes the game as it goes, so uses a copy of the
+// (frozen) cached game.
+//
+
+void SolveEnumPure(const Game &p_game, const ServerOptions &p_options,
+		   std::ostream &p_stream)
+{
+  int numThreads = p_options.GetInt('t', 1);
+  if (numThreads <= 0) {
+    numThreads = NumberOfProcessors();
+  }
+  bool solveAgent = p_options.Has('A');
+  shared_ptr<StrategyProfileRenderer<Rational> > renderer =
+    MakeRenderer<Rational>(p_stream,
+			   p_game->IsTree() && !p_options.Has('S'),
+			   p_options.Has('D'), 6);
+
+  if (p_game->IsTree() && p_options.Has('P')) {
+    shared_ptr<NashBehavSolver<Rational> > stage;
+    if (solveAgent) {
+      stage = new NashEnumPureAgentSolver();
+    }
+    else {
+      shared_ptr<NashStrategySolver<Rational> > substage =
+	new NashEnumPureStrategySolver(0, numThreads);
+      stage = new NashBehavViaStrategySolver<Rational>(substage);
+    }
+    SubgameNashBehavSolver<Rational> algorithm(stage, renderer);
+    algorithm.Solve(p_game->Copy());
+  }
+  else if (p_game->IsTree() && solveAgent) {
+    NashEnumPureAgentSolver algorithm(renderer);
+    algorithm.Solve(p_game);
+  }
+  else {
+    NashEnumPureStrategySolver algorithm(renderer, numThreads);
+    algorithm.Solve(p_game);
+  }
+}
+
+template <class T>
+void SolveLcp(const Game &p_game, const ServerOptions &p_options,
+	      std::ostream &p_stream)
+{
+  int stopAfter = p_options.GetInt('e', 0);
+  int maxDepth = p_options.GetInt('r', 0);
+  bool behav = p_game->IsTree() && !p_options.Has('S');
+  shared_ptr<StrategyProfileRenderer<T> > renderer =
+    MakeRenderer<T>(p_stream, behav, p_options.Has('D'),
+		    p_options.GetInt('d', 6));
+
+  if (!behav) {
+    NashLcpStrategySolver<T> algorithm(stopAfter, maxDepth, renderer);
+    algorithm.Solve(p_game);
+  }
+  else if (!p_options.Has('P')) {
+    NashLcpBehaviorSolver<T> algorithm(stopAfter, maxDepth, renderer);
+    algorithm.Solve(p_game);
+  }
+  else {
+    shared_ptr<NashBehavSolver<T> > stage =
+      new NashLcpBehaviorSolver<T>(stopAfter, maxDepth);
+    SubgameNashBehavSolver<T> algorithm(stage, renderer);
+    algorithm.Solve(p_game->Copy());
+  }
+}
+
+void SolveLcp(const Game &p_game, const ServerOptions &p_options,
+	      std::ostream &p_stream)
+{
+  if (p_options.Has('d')) {
+    SolveLcp<double>(p_game, p_options, p_stream);
+  }
+  else {
+    SolveLcp<Rational>(p_game, p_options, p_stream);
+  }
+}
+
+template <class T>
+void SolveLp(const Game &p_game, const ServerOptions &p_options,
+	     std::ostream &p_stream)
+{
+  bool behav = p_game->IsTree() && !p_options.Has('S');
+  shared_ptr<StrategyProfileRenderer<T> > renderer =
+    MakeRenderer<T>(p_stream, behav, p_options.Has('D'),
+		    p_options.GetInt('d', 6));
+
+  if (!behav) {
+    NashLpStrategySolver<T> algorithm(renderer);
+    algorithm.Solve(p_game);
+  }
+  else if (!p_options.Has('P')) {
+    NashLpBehavSolver<T> algorithm(renderer);
+    algorithm.Solve(p_game);
+  }
+  else {
+    shared_ptr<NashBehavSolver<T> > stage = new NashLpBehavSolver<T>();
+    SubgameNashBehavSolver<T> algorithm(stage, renderer);
+    algorithm.Solve(p_game->Copy());
+  }
+}
+
+void SolveLp(const Game &p_game, const ServerOptions &p_options,
+	     std::ostream &p_stream)
+{
+  if (p_options.Has('d')) {
+    SolveLp<double>(p_game, p_options, p_stream);
+  }
+  else {
+    SolveLp<Rational>(p_game, p_options, p_stream);
+  }
+}
+
+void SolveLogit(const Game &p_game, const ServerOptions &p_options,
+		std::ostream &p_stream)
+{
+  if (!p_game->IsPerfectRecall()) {
+    throw UndefinedException("Computing equilibria of games with imperfect recall is not supported.");
+  }
+  double maxLambda = p_options.GetDouble('m', 1000000.0);
+
+  if (!p_game->IsTree() || p_options.Has('S')) {
+    MixedStrategyProfile<double> start(p_game->NewMixedStrategyProfile(0.0));
+    StrategicQREPathTracer tracer(start);
+    tracer.SetMaxDecel(p_options.GetDouble('a', 1.1));
+    tracer.SetStepsize(p_options.GetDouble('s', 0.03));
+    tracer.SetFullGraph(!p_options.Has('e'));
+    tracer.SetTargetParam(p_options.GetDouble('l', -1.0));
+    tracer.SetDecimals(p_options.GetInt('d', 6));
+    tracer.SetStream(p_stream);
+    tracer.TraceStrategicPath(start, 0.0, maxLambda, 1.0);
+  }
+  else {
+    MixedBehaviorProfile<double> start(p_game);
+    AgentQREPathTracer tracer(start);
+    tracer.SetMaxDecel(p_options.GetDouble('a', 1.1));
+    tracer.SetStepsize(p_options.GetDouble('s', 0.03));
+    tracer.SetFullGraph(!p_options.Has('e'));
+    tracer.SetTargetParam(p_options.GetDouble('l', -1.0));
+    tracer.SetDecimals(p_options.GetInt('d', 6));
+    tracer.SetStream(p_stream);
+    tracer.TraceAgentPath(start, 0.0, maxLambda, 1.0);
+  }
+}
+
+struct ServerMethod {
+  const char *m_name;
+  /// The options of the tool the server handles, in the form getopt()
+  /// takes them.  Requests with any other options are left to the tool.
+  const char *m_options;
+  void (*m_solve)(const Game &, const ServerOptions &, std::ostream &);
+};
+
+// The logit options -p and -L name files, which the server does not read
+static const ServerMethod s_methods[] = {
+  { "enumpure", "DqASPt:", SolveEnumPure },
+  { "lcp", "d:DqSPe:r:", SolveLcp },
+  { "lp", "d:DqSP", SolveLp },
+  { "logit", "d:s:a:m:qeSl:", SolveLogit },
+  { 0, 0, 0 }
+};
+
+//=========================================================================
+//                             class Server
+//=========================================================================
+
+#ifdef GAMBIT_HAVE_SOCKETS
+
+//
+// Connections are accepted on one thread, and queued for the workers
+// to serve.  With no worker threads, each connection is served in turn
+// by the accepting thread.
+//
+class Server {
+private:
+  int m_listener, m_threads;
+  GameCache m_cache;
+  Mutex m_mutex;
+  Condition m_ready;
+  std::deque<int> m_queue;
+  bool m_stopped;
+
+  void Serve(ServerConnection &p_connection);
+
+public:
+  Server(int p_listener, int p_threads, int p_cacheSize)
+    : m_listener(p_listener), m_threads(p_threads), m_cache(p_cacheSize),
+      m_stopped(false) { }
+
+  /// Accepts connections until accepting fails
+  void AcceptConnections(void);
+  /// Serves queued connections until accepting has stopped
+  void ServeConnections(void);
+};
+
+void Server::AcceptConnections(void)
+{
+  while (true) {
+    int fd = accept(m_listener, 0, 0);
+    if (fd < 0) {
+      if (errno == EINTR || errno == ECONNABORTED)  continue;
+      perror("gambit-server: accept");
+      break;
+    }
+    if (!IsPeerSameUser(fd)) {
+      // Only serve the user running the server
+      close(fd);
+      continue;
+    }
+    if (m_threads == 0) {
+      ServerConnection connection(fd);
+      Serve(connection);
+    }
+    else {
+      MutexLock lock(m_mutex);
+      m_queue.push_back(fd);
+      m_ready.Signal();
+    }
+  }
+
+  MutexLock lock(m_mutex);
+  m_stopped = true;
+  m_ready.Broadcast();
+}
+
+void Server::ServeConnections(void)
+{
+  while (true) {
+    int fd;
+    {
+      MutexLock lock(m_mutex);
+      while (m_queue.empty() && !m_stopped) {
+	m_ready.Wait(m_mutex);
+      }
+      if (m_queue.empty()) {
+	return;
+      }
+      fd = m_queue.front();
+      m_queue.pop_front();
+    }
+    ServerConnection connection(fd);
+    Serve(connection);
+  }
+}
+
+void Server::Serve(ServerConnection &p_connection)
+{
+  std::string header, length, text;
+  size_t size;
+  if (!p_connection.ReadLine(header) || !p_connection.ReadLine(length) ||
+      !(std::istringstream(length) >> size) ||
+      !p_connection.Read(size, text)) {
+    return;
+  }
+
+  std::istringstream tokens(header);
+  std::string name, version, method, arg;
+  tokens >> name >> version >> method;
+  if (name + " " + version != SERVER_PROTOCOL) {
+    p_connection.Write("#UNSUPPORTED unknown protocol\n");
+    return;
+  }
+  const ServerMethod *entry = s_methods;
+  while (entry->m_name && method != entry->m_name) {
+    entry++;
+  }
+  if (!entry->m_name) {
+    p_connection.Write("#UNSUPPORTED method `" + method + "' not handled by the server\n");
+    return;
+  }
+  std::vector<std::string> args;
+  while (tokens >> arg) {
+    args.push_back(arg);
+  }
+  ServerOptions options;
+  std::string error;
+  if (!options.Parse(args, entry->m_options, error)) {
+    p_connection.Write("#UNSUPPORTED " + error + "\n");
+    return;
+  }
+
+  if (!p_connection.Write("#OK\n")) {
+    return;
+  }
+  ServerOutputBuffer buffer(p_connection);
+  std::ostream output(&buffer);
+  output.exceptions(std::ios::badbit);
+  try {
+    entry->m_solve(m_cache.Get(text), options, output);
+    output.flush();
+    p_connection.Write("#END\n");
+  }
+  catch (std::ios::failure &) {
+    // The client has gone away
+  }
+  catch (std::exception &e) {
+    if (buffer.pubsync() != 0) {
+      return;
+    }
+    std::string message(e.what());
+    for (size_t i = 0; i < message.length(); i++) {
+      if (message[i] == '\n' || message[i] == '\r')  message[i] = ' ';
+    }
+    p_connection.Write(std::string(buffer.AtLineStart() ? "" : "\n") +
+		       "#ERROR " + message + "\n");
+  }
+}
+
+static void RunServer(void *p_server, int p_index)
+{
+  Server *server = (Server *) p_server;
+  if (p_index == 0) {
+    server->AcceptConnections();
+  }
+  else {
+    server->ServeConnections();
+  }
+}
+
+// The socket path, for removing the socket when the server is stopped
+static char s_socketPath[sizeof(((struct sockaddr_un *) 0)->sun_path)];
+
+extern "C" void OnStopSignal(int)
+{
+  unlink(s_socketPath);
+  _exit(0);
+}
+
+#endif  // GAMBIT_HAVE_SOCKETS
+
+int main(int argc, char *argv[])
+{
+  opterr = 0;
+  bool quiet = false;
+  std::string path = GetServerPath();
+  int numThreads = NumberOfProcessors(), cacheSize = 256;
+
+  int long_opt_index = 0;
+  struct option long_options[] = {
+    { "help", 0, NULL, 'h'   },
+    { "version", 0, NULL, 'v'  },
+    { 0,    0,    0,    0   }
+  };
+  int c;
+  while ((c = getopt_long(argc, argv, "s:t:c:vhq", long_options, &long_opt_index)) != -1) {
+    switch (c) {
+    case 'v':
+      PrintBanner(std::cerr); exit(1);
+    case 's':
+      path = optarg;
+      break;
+    case 't':
+      numThreads = atoi(optarg);
+      if (numThreads <= 0) {
+	numThreads = NumberOfProcessors();
+      }
+      break;
+    case 'c':
+      cacheSize = atoi(optarg);
+      break;
+    case 'h':
+      PrintHelp(argv[0]);
+      break;
+    case 'q':
+      quiet = true;
+      break;
+    case '?':
+      if (isprint(optopt)) {
+	std::cerr << argv[0] << ": Unknown option `-" << ((char) optopt) << "'.\n";
+      }
+      else {
+	std::cerr << argv[0] << ": Unknown option character `\\x" << optopt << "`.\n";
+      }
+      return 1;
+    default:
+      abort();
+    }
+  }
+
+  if (!quiet) {
+    PrintBanner(std::cerr);
+  }
+
+#ifdef GAMBIT_HAVE_SOCKETS
+  struct sockaddr_un address;
+  if (path.empty()) {
+    std::cerr << argv[0] << ": no socket path; give one with -s, "
+	      << "or set GAMBIT_SERVER\n";
+    return 1;
+  }
+  if (path.length() >= sizeof(address.sun_path)) {
+    std::cerr << argv[0] << ": invalid socket path `" << path << "'\n";
+    return 1;
+  }
+  ServerConnection *existing = ServerConnection::Connect(path);
+  if (existing) {
+    delete existing;
+    std::cerr << argv[0] << ": a server is already listening on " << path << "\n";
+    return 1;
+  }
+  // Any socket left at the path is from a server which did not exit cleanly
+  unlink(path.c_str());
+
+  memset(&address, 0, sizeof(address));
+  address.sun_family = AF_UNIX;
+  strcpy(address.sun_path, path.c_str());
+  int listener = socket(AF_UNIX, SOCK_STREAM, 0);
+  // The socket is created accessible to this user only
+  mode_t mask = umask(077);
+  bool bound = (listener >= 0 &&
+		bind(listener, (struct sockaddr *) &address, sizeof(address)) == 0);
+  umask(mask);
+  if (!bound || listen(listener, SOMAXCONN) < 0) {
+    std::ostringstream error_message;
+    error_message << argv[0] << ": " << path;
+    perror(error_message.str().c_str());
+    return 1;
+  }
+
+  strcpy(s_socketPath, path.c_str());
+  signal(SIGINT, OnStopSignal);
+  signal(SIGTERM, OnStopSignal);
+  signal(SIGPIPE, SIG_IGN);
+
+#ifdef HAVE_PTHREAD
+  Server server(listener, numThreads, cacheSize);
+  RunThreads(numThreads + 1, RunServer, &server);
+#else
+  Server server(listener, 0, cacheSize);
+  server.AcceptConnections();
+#endif  // HAVE_PTHREAD
+
+  unlink(path.c_str());
+  return 1;
+#else
+  std::cerr << argv[0] << ": this system does not have Unix domain sockets\n";
+  return 1;
+#endif  // GAMBIT_HAVE_SOCKETS
+}
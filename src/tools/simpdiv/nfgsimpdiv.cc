@@ -27,8 +27,11 @@
 #include <cerrno>
 #include <iomanip>
 #include <fstream>
+#include <map>
 #include "libgambit/libgambit.h"
+#include "libgambit/stats.h"
 #include "libgambit/nash.h"
+#include "libgambit/symmetric.h"
 
 using namespace Gambit;
 
@@ -46,11 +49,10 @@ using namespace Gambit;
 //
 // -s <filename>: A list of strategy profiles to use as starting points
 //
-// -f:  Print profiles in floating-point (even though the algorithm inherently
-//      computes using rational numbers)
-//
-// -d #:  Number of decimals to show in floating-point output
-//        (Only has an effect in conjunction with -f)
+// -d #:  Compute labels using floating-point arithmetic, and print profiles
+//        in floating-point with # decimals.  The simplices themselves are
+//        still located exactly on the rational grid, and the approximation
+//        obtained on the final grid is confirmed using exact arithmetic.
 //
 // -r #:  Generate random starting points with denominator #.
 //
@@ -58,6 +60,11 @@ using namespace Gambit;
 //
 // -g #:  Multiplier for grid restart (default is 2)
 //
+// -y:  Compute a symmetric equilibrium of a symmetric game.  The
+//      subdivision is then of the strategy simplex of a single player,
+//      with labels computed from the payoffs against all other players
+//      using the same strategy.
+//
 // 
 // Some history:
 // 
@@ -71,12 +78,14 @@ using namespace Gambit;
 class NashSimpdivStrategySolver : public NashStrategySolver<Rational> {
 public:
   NashSimpdivStrategySolver(int p_gridResize = 2, int p_leashLength = 0,
-			    bool p_verbose = false,
+			    bool p_verbose = false, bool p_floatLabels = false,
+			    bool p_symmetric = false,
 			    shared_ptr<StrategyProfileRenderer<Rational> > p_onEquilibrium = 0)
     : NashStrategySolver<Rational>(p_onEquilibrium),
       m_gridResize(p_gridResize),
       m_leashLength((p_leashLength > 0) ? p_leashLength : 32000),
-      m_verbose(p_verbose)
+      m_verbose(p_verbose), m_floatLabels(p_floatLabels),
+      m_symmetric(p_symmetric)
   { }
   virtual ~NashSimpdivStrategySolver() { }
 
@@ -87,19 +96,53 @@ public:
 
 private:
   int m_gridResize, m_leashLength;
-  bool m_verbose;
+  bool m_verbose, m_floatLabels, m_symmetric;
 
+  // When computing symmetric equilibria, the profiles the algorithm
+  // works on are those of a game with one player, the carrier of the
+  // strategy all players use, and labels are computed from the payoff
+  // tables of the symmetric game instead.
   class State {
   public:
     int t, ibar;
-    Rational d, pay, maxz, bestz;
+    Rational d, bestz;
     
-    State(void) : t(0), ibar(1), bestz(1.0e30) { }
+    State(const Game &p_game, bool p_floatLabels,
+	  const SymmetricPayoffTable<Rational> *p_table,
+	  const SymmetricPayoffTable<double> *p_floatTable)
+      : t(0), ibar(1), bestz(1.0e30), floatLabels(p_floatLabels),
+	floaty(p_game->NewMixedStrategyProfile(0.0)),
+	table(p_table), floatTable(p_floatTable) { }
     Rational getlabel(MixedStrategyProfile<Rational> &yy, Array<int> &, 
 		      PVector<Rational> &);
+
+  private:
+    // The label and maximum regret at a grid point.  The path frequently
+    // returns to vertices it has already visited, so these are cached,
+    // keyed on the coordinates of the grid point.
+    struct Label {
+      int player, strategy;
+      Rational maxz;
+    };
+    // Upper bound on the number of cached labels for one grid
+    static const unsigned int MAX_CACHED_LABELS = 1 << 16;
+
+    bool floatLabels;
+    MixedStrategyProfile<double> floaty;
+    const SymmetricPayoffTable<Rational> *table;
+    const SymmetricPayoffTable<double> *floatTable;
+    std::map<std::vector<Rational>, Label> labels;
   };
 
-  Rational Simplex(MixedStrategyProfile<Rational> &, const Rational &d) const;
+  Rational Simplex(MixedStrategyProfile<Rational> &, const Rational &d,
+		   const SymmetricPayoffTable<Rational> *,
+		   const SymmetricPayoffTable<double> *) const;
+  void Refine(MixedStrategyProfile<Rational> &,
+	      const SymmetricPayoffTable<Rational> *,
+	      const SymmetricPayoffTable<double> *) const;
+  void Render(const MixedStrategyProfile<Rational> &,
+	      const SymmetricPayoffTable<Rational> *,
+	      const std::string &p_label = "NE") const;
   void update(State &, RectArray<int> &, RectArray<int> &, PVector<Rational> &,
 	      const PVector<int> &, int j, int i) const;
   void getY(State &, MixedStrategyProfile<Rational> &x, PVector<Rational> &, 
@@ -124,10 +167,12 @@ inline GameStrategy GetStrategy(const Game &game, int pl, int st)
 
 Rational 
 NashSimpdivStrategySolver::Simplex(MixedStrategyProfile<Rational> &y,
-				   const Rational &d) const
+				   const Rational &d,
+				   const SymmetricPayoffTable<Rational> *p_table,
+				   const SymmetricPayoffTable<double> *p_floatTable) const
 {
   Game game = y.GetGame();
-  State state;
+  State state(game, m_floatLabels, p_table, p_floatTable);
   state.d = d;
   Array<int> nstrats(game->NumStrategies());
   Array<int> ylabel(2);
@@ -474,23 +519,25 @@ int NashSimpdivStrategySolver::get_c(int j, int h, int nstrats,
   return (hh > nstrats) ? 1 : hh;
 }
 
-Rational 
-NashSimpdivStrategySolver::State::getlabel(MixedStrategyProfile<Rational> &yy,
-					   Array<int> &ylabel,
-					   PVector<Rational> &besty)
+//
+// Computes the player and strategy with the largest regret against the
+// profile, returning the regret.
+//
+template <class T>
+T MaxRegret(const MixedStrategyProfile<T> &p_profile, Array<int> &p_label)
 {
-  Rational maxz = -1000000;
-  ylabel[1] = 1;
-  ylabel[2] = 1;
+  T maxz = -1000000;
+  p_label[1] = 1;
+  p_label[2] = 1;
   
-  for (int i = 1; i <= yy.GetGame()->NumPlayers(); i++) {
-    GamePlayer player = yy.GetGame()->Players()[i];
-    Rational payoff = 0;
-    Rational maxval = -1000000;
+  for (int i = 1; i <= p_profile.GetGame()->NumPlayers(); i++) {
+    GamePlayer player = p_profile.GetGame()->Players()[i];
+    T payoff = 0;
+    T maxval = -1000000;
     int jj = 0;
     for (int j = 1; j <= player->Strategies().size(); j++) {
-      pay = yy.GetPayoff(player->Strategies()[j]);
-      payoff += yy[player->Strategies()[j]] * pay;
+      T pay = p_profile.GetPayoff(player->Strategies()[j]);
+      payoff += p_profile[player->Strategies()[j]] * pay;
       if (pay > maxval) {
 	maxval = pay;
 	jj = j;
@@ -498,10 +545,82 @@ NashSimpdivStrategySolver::State::getlabel(MixedStrategyProfile<Rational> &yy,
     }
     if (maxval - payoff > maxz) {
       maxz = maxval - payoff;
-      ylabel[1] = i;
-      ylabel[2] = jj;
+      p_label[1] = i;
+      p_label[2] = jj;
+    }
+  }
+  return maxz;
+}
+
+//
+// Computes the strategy with the largest regret against all players of
+// a symmetric game using the strategy p_sigma, returning the regret.
+// The label is that of the strategy of the only player of the carrier.
+//
+template <class T>
+T MaxRegret(const SymmetricPayoffTable<T> &p_table, const Vector<T> &p_sigma,
+	    Array<int> &p_label)
+{
+  Vector<T> payoffs(p_table.NumStrategies());
+  p_table.GetPayoffs(p_sigma, payoffs);
+  T payoff = 0;
+  int jj = 1;
+  for (int j = 1; j <= payoffs.Length(); j++) {
+    payoff += p_sigma[j] * payoffs[j];
+    if (payoffs[j] > payoffs[jj]) {
+      jj = j;
+    }
+  }
+  p_label[1] = 1;
+  p_label[2] = jj;
+  return payoffs[jj] - payoff;
+}
+
+Rational 
+NashSimpdivStrategySolver::State::getlabel(MixedStrategyProfile<Rational> &yy,
+					   Array<int> &ylabel,
+					   PVector<Rational> &besty)
+{
+  std::vector<Rational> key(yy.MixedProfileLength());
+  for (int i = 1; i <= yy.MixedProfileLength(); i++) {
+    key[i-1] = yy[i];
+  }
+  std::map<std::vector<Rational>, Label>::const_iterator cached = labels.find(key);
+  if (cached != labels.end()) {
+    ylabel[1] = cached->second.player;
+    ylabel[2] = cached->second.strategy;
+    return cached->second.maxz;
+  }
+
+  Rational maxz;
+  if (floatLabels) {
+    for (int i = 1; i <= yy.MixedProfileLength(); i++) {
+      floaty[i] = (double) yy[i];
+    }
+    if (floatTable) {
+      maxz = Rational(MaxRegret(*floatTable, (const Vector<double> &) floaty,
+				ylabel));
+    }
+    else {
+      maxz = Rational(MaxRegret(floaty, ylabel));
     }
   }
+  else if (table) {
+    maxz = MaxRegret(*table, (const Vector<Rational> &) yy, ylabel);
+  }
+  else {
+    maxz = MaxRegret(yy, ylabel);
+  }
+
+  if (labels.size() >= MAX_CACHED_LABELS) {
+    labels.clear();
+  }
+  Label label;
+  label.player = ylabel[1];
+  label.strategy = ylabel[2];
+  label.maxz = maxz;
+  labels[key] = label;
+
   if (maxz < bestz) {
     bestz = maxz;
     for (int i = 1; i <= yy.GetGame()->NumPlayers(); i++) {
@@ -564,37 +683,111 @@ Integer find_lcd(const Vector<Rational> &vec)
   return lcd;
 }
 
-List<MixedStrategyProfile<Rational> >
-NashSimpdivStrategySolver::Solve(const MixedStrategyProfile<Rational> &p_start) const
+void
+NashSimpdivStrategySolver::Render(const MixedStrategyProfile<Rational> &p_profile,
+				  const SymmetricPayoffTable<Rational> *p_table,
+				  const std::string &p_label) const
 {
-  if (!p_start.GetGame()->IsPerfectRecall()) {
-    throw UndefinedException("Computing equilibria of games with imperfect recall is not supported.");
+  if (p_table) {
+    this->m_onEquilibrium->Render(p_table->ToProfile((const Vector<Rational> &) p_profile),
+				  p_label);
+  }
+  else {
+    this->m_onEquilibrium->Render(p_profile, p_label);
   }
-  Integer k = find_lcd((const Vector<Rational> &) p_start);
+}
+
+void
+NashSimpdivStrategySolver::Refine(MixedStrategyProfile<Rational> &y,
+				  const SymmetricPayoffTable<Rational> *p_table,
+				  const SymmetricPayoffTable<double> *p_floatTable) const
+{
+  Integer k = find_lcd((const Vector<Rational> &) y);
   Rational d = Rational(1, k);
     
-  MixedStrategyProfile<Rational> y(p_start);
   if (m_verbose) {
-    this->m_onEquilibrium->Render(y, "start");
+    Render(y, p_table, "start");
   }
 
   while (true) {
     const double TOL = 1.0e-10;
     d /= m_gridResize;
-    Rational maxz = Simplex(y, d);
+    Rational maxz = Simplex(y, d, p_table, p_floatTable);
     
     if (m_verbose) {
-      this->m_onEquilibrium->Render(y, lexical_cast<std::string>(d));
+      Render(y, p_table, lexical_cast<std::string>(d));
+    }
+    if (maxz < Rational(TOL)) {
+      if (!m_floatLabels) break;
+      // Labels were computed in floating point; confirm the approximation
+      // exactly before accepting it, and refine further if it fails.
+      Array<int> label(2);
+      if (p_table) {
+	if (MaxRegret(*p_table, (const Vector<Rational> &) y, label) < Rational(TOL)) break;
+      }
+      else if (MaxRegret(y, label) < Rational(TOL)) break;
     }
-    if (maxz < Rational(TOL)) break;
   }
     
-  this->m_onEquilibrium->Render(y);
+  Render(y, p_table);
+}
+
+List<MixedStrategyProfile<Rational> >
+NashSimpdivStrategySolver::Solve(const MixedStrategyProfile<Rational> &p_start) const
+{
+  if (!p_start.GetGame()->IsPerfectRecall()) {
+    throw UndefinedException("Computing equilibria of games with imperfect recall is not supported.");
+  }
   List<MixedStrategyProfile<Rational> > sol;
-  sol.push_back(y);
+
+  if (m_symmetric) {
+    SymmetricPayoffTable<Rational> table(p_start.GetGame());
+    shared_ptr<SymmetricPayoffTable<double> > floatTable;
+    if (m_floatLabels) {
+      floatTable = new SymmetricPayoffTable<double>(p_start.GetGame());
+    }
+    // The strategy of the first player in the starting profile is
+    // taken to be that of all players
+    Array<int> dim(1);
+    dim[1] = table.NumStrategies();
+    Game carrier = NewTable(dim, true);
+    MixedStrategyProfile<Rational> y(carrier->NewMixedStrategyProfile(Rational(0)));
+    for (int i = 1; i <= y.MixedProfileLength(); i++) {
+      y[i] = p_start[i];
+    }
+    Refine(y, &table, floatTable.get());
+    sol.push_back(table.ToProfile((const Vector<Rational> &) y));
+  }
+  else {
+    MixedStrategyProfile<Rational> y(p_start);
+    Refine(y, 0, 0);
+    sol.push_back(y);
+  }
   return sol;
 }
 
+//
+// Renders the exact grid points found by the algorithm in floating point.
+//
+class MixedStrategyFloatRenderer : public MixedStrategyRenderer<Rational> {
+public:
+  MixedStrategyFloatRenderer(std::ostream &p_stream, int p_numDecimals = 6)
+    : m_renderer(p_stream, p_numDecimals) { }
+  virtual ~MixedStrategyFloatRenderer() { }
+  virtual void Render(const MixedStrategyProfile<Rational> &p_profile,
+		      const std::string &p_label = "NE") const
+  {
+    MixedStrategyProfile<double> profile(p_profile.GetGame()->NewMixedStrategyProfile(0.0));
+    for (int i = 1; i <= profile.MixedProfileLength(); i++) {
+      profile[i] = (double) p_profile[i];
+    }
+    m_renderer.Render(profile, p_label);
+  }
+
+private:
+  MixedStrategyCSVRenderer<double> m_renderer;
+};
+
 void PrintBanner(std::ostream &p_stream)
 {
   p_stream << "Compute Nash equilibria using simplicial subdivision\n";
@@ -611,6 +804,8 @@ void PrintHelp(char *progname)
   std::cerr << "With no options, computes one approximate Nash equilibrium.\n\n";
 
   std::cerr << "Options:\n";
+  std::cerr << "  -d DECIMALS      compute labels using floating-point arithmetic;\n";
+  std::cerr << "                   display results with DECIMALS digits\n";
   std::cerr << "  -g MULT          granularity of grid refinement at each step (default is 2)\n";
   std::cerr << "  -h, --help       print this help message\n";
   std::cerr << "  -r DENOM         generate random starting points with denominator DENOM\n";
@@ -618,8 +813,11 @@ void PrintHelp(char *progname)
   std::cerr << "  -s FILE          file containing starting points\n";
   std::cerr << "  -q               quiet mode (suppresses banner)\n";
   std::cerr << "  -V, --verbose    verbose mode (shows intermediate output)\n";
-  std::cerr << "  -v, --version    print version information\n";
   std::cerr << "                   (default is to only show equilibria)\n";
+  std::cerr << "  -v, --version    print version information\n";
+  std::cerr << "  -y               compute a symmetric equilibrium of a symmetric game\n";
+  std::cerr << "  --stats[=FORMAT] on exit, print solver statistics to standard error\n";
+  std::cerr << "                   as json (the default) or csv\n";
   exit(1);
 }
 
@@ -629,20 +827,26 @@ int main(int argc, char *argv[])
   std::string startFile;
   bool useRandom = false;
   int randDenom = 1, gridResize = 2, stopAfter = 1;
-  bool verbose = false, quiet = false;
+  bool verbose = false, quiet = false, useFloat = false, useSymmetric = false;
+  int numDecimals = 6;
 
   int long_opt_index = 0;
   struct option long_options[] = {
     { "help", 0, NULL, 'h'   },
     { "version", 0, NULL, 'v'  },
+    { "stats", optional_argument, NULL, STATS_OPTION },
     { "verbose", 0, NULL, 'V'  },
     { 0,    0,    0,    0   }
   };
   int c;
-  while ((c = getopt_long(argc, argv, "g:hVvn:r:s:d:qS", long_options, &long_opt_index)) != -1) {
+  while ((c = getopt_long(argc, argv, "g:hVvn:r:s:d:qSy", long_options, &long_opt_index)) != -1) {
     switch (c) {
     case 'v':
       PrintBanner(std::cerr); exit(1);
+    case 'd':
+      useFloat = true;
+      numDecimals = atoi(optarg);
+      break;
     case 'g':
       gridResize = atoi(optarg);
       break;
@@ -667,6 +871,15 @@ int main(int argc, char *argv[])
       break;
     case 'S':
       break;
+    case 'y':
+      useSymmetric = true;
+      break;
+    case STATS_OPTION:
+      if (!EnableStats((optarg) ? optarg : "json")) {
+	std::cerr << argv[0] << ": Unknown statistics format `" << optarg << "'.\n";
+	return 1;
+      }
+      break;
     case '?':
       if (isprint(optopt)) {
 	std::cerr << argv[0] << ": Unknown option `-" << ((char) optopt) << "'.\n";
@@ -716,9 +929,14 @@ int main(int argc, char *argv[])
     }
     for (int i = 1; i <= starts.size(); i++) {
       shared_ptr<StrategyProfileRenderer<Rational> > renderer;
-      renderer = new MixedStrategyCSVRenderer<Rational>(std::cout);
-      NashSimpdivStrategySolver algorithm(gridResize, 0, verbose,
-					  renderer);
+      if (useFloat) {
+	renderer = new MixedStrategyFloatRenderer(std::cout, numDecimals);
+      }
+      else {
+	renderer = new MixedStrategyCSVRenderer<Rational>(std::cout);
+      }
+      NashSimpdivStrategySolver algorithm(gridResize, 0, verbose, useFloat,
+					  useSymmetric, renderer);
       algorithm.Solve(starts[i]);
     }
     return 0;